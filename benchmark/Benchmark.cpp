@@ -0,0 +1,334 @@
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <string>
+#include <vector>
+
+#include "ByteSerializers/CLValueByteSerializer.h"
+#include "ByteSerializers/DeployByteSerializer.h"
+#include "ByteSerializers/GlobalStateKeyByteSerializer.h"
+#include "CasperClient.h"
+#include "Types/ED25519Key.h"
+#include "Types/Secp256k1Key.h"
+#include "Utils/CEP57Checksum.h"
+
+/// Microbenchmarks of the serialization, hashing, signing and JSON decoding
+/// hot paths of the SDK. The results are written as JSON, to compare the
+/// SDK versions:
+///
+///   CasperSDK_bench [--filter <text>] [--min-time-ms <ms>]
+///                   [--repetitions <count>] [--out <file>]
+///
+/// Each benchmark runs batches of calls lasting at least the minimum time,
+/// and reports the median, minimum and maximum time per call of the batches.
+
+using namespace Casper;
+
+namespace {
+
+/// Keeps the compiler from removing the computation of a value.
+template <typename T>
+void DoNotOptimize(const T& value) {
+#if defined(__GNUC__)
+  asm volatile("" : : "r,m"(value) : "memory");
+#else
+  static volatile const void* sink;
+  sink = &value;
+#endif
+}
+
+struct Options {
+  std::string filter;
+  std::chrono::milliseconds min_time{100};
+  int repetitions = 5;
+  std::string out;
+};
+
+struct Result {
+  std::string name;
+  uint64_t iterations = 0;
+  double median_ns = 0;
+  double min_ns = 0;
+  double max_ns = 0;
+};
+
+class Runner {
+ public:
+  explicit Runner(const Options& options) : mOptions(options) {}
+
+  /// Runs the benchmark if its name matches the filter. The function does one
+  /// call of the benchmarked code.
+  void Run(const std::string& name, const std::function<void()>& function) {
+    if (name.find(mOptions.filter) == std::string::npos) return;
+
+    // calibrates the batch size to the minimum time
+    uint64_t iterations = 1;
+    while (true) {
+      auto elapsed = TimeBatch(function, iterations);
+      if (elapsed >= mOptions.min_time || iterations >= (uint64_t(1) << 40)) {
+        break;
+      }
+      double scale = elapsed.count() == 0
+                         ? 100.0
+                         : 1.2 * mOptions.min_time / elapsed;
+      iterations = std::max<uint64_t>(
+          iterations + 1, static_cast<uint64_t>(iterations *
+                                                std::min(scale, 100.0)));
+    }
+
+    std::vector<double> times;
+    for (int i = 0; i < mOptions.repetitions; i++) {
+      auto elapsed = TimeBatch(function, iterations);
+      times.push_back(double(elapsed.count()) / iterations);
+    }
+    std::sort(times.begin(), times.end());
+
+    Result result;
+    result.name = name;
+    result.iterations = iterations;
+    result.median_ns = times[times.size() / 2];
+    result.min_ns = times.front();
+    result.max_ns = times.back();
+    mResults.push_back(result);
+
+    std::cerr << name << ": " << result.median_ns << " ns/op" << std::endl;
+  }
+
+  nlohmann::json ToJson() const {
+    nlohmann::json benchmarks = nlohmann::json::array();
+    for (auto& result : mResults) {
+      benchmarks.push_back({{"name", result.name},
+                            {"iterations", result.iterations},
+                            {"repetitions", mOptions.repetitions},
+                            {"median_ns", result.median_ns},
+                            {"min_ns", result.min_ns},
+                            {"max_ns", result.max_ns}});
+    }
+
+    nlohmann::json context{
+        {"sdk_version", CASPER_SDK_VERSION},
+        {"date", Timestamp::Now().ToString()},
+        {"min_time_ms", mOptions.min_time.count()}};
+#if defined(__VERSION__)
+    context["compiler"] = __VERSION__;
+#endif
+#if defined(NDEBUG)
+    context["build"] = "release";
+#else
+    context["build"] = "debug";
+#endif
+    return {{"context", context}, {"benchmarks", benchmarks}};
+  }
+
+ private:
+  std::chrono::nanoseconds TimeBatch(const std::function<void()>& function,
+                                     uint64_t iterations) {
+    auto start = std::chrono::steady_clock::now();
+    for (uint64_t i = 0; i < iterations; i++) function();
+    return std::chrono::steady_clock::now() - start;
+  }
+
+  const Options& mOptions;
+  std::vector<Result> mResults;
+};
+
+std::string DataPath(const std::string& name) {
+  std::string file_path = __FILE__;
+  std::string dir_path = file_path.substr(0, file_path.rfind("/"));
+  return dir_path + "/../test/data/" + name;
+}
+
+nlohmann::json LoadJson(const std::string& name) {
+  std::ifstream ifs(DataPath(name));
+  if (!ifs) throw std::runtime_error("cannot open " + DataPath(name));
+  return nlohmann::json::parse(ifs);
+}
+
+/// A transfer deploy like the ones sent by wallets.
+Deploy MakeTransferDeploy(const PublicKey& account) {
+  DeployHeader header(account, "2022-04-23T09:38:21.700Z", "30m", 1, "", {},
+                      "casper-test");
+  ModuleBytes payment(u512FromDec("100000000"));
+  TransferDeployItem session(
+      u512FromDec("23000000000"),
+      AccountHashKey(
+          PublicKey::FromHexString("018afa98ca4be12d613617f7339a2d57695"
+                                   "0a2f9a92102ca4d6508ee31b54d2c02")),
+      1650706686882u, true);
+  return Deploy(header, payment, session);
+}
+
+void RunEncodingBenchmarks(Runner& runner) {
+  CBytes hash = hexDecode(
+      "bba5fb89a48f71e6d00077a56854df3bbafb7ad4c1332f3956f1c2f2f97257fe");
+  CBytes kilobyte(1024);
+  for (size_t i = 0; i < kilobyte.size(); i++) kilobyte[i] = i * 31;
+  std::string hash_hex = hexEncode(hash);
+  std::string kilobyte_hex = hexEncode(kilobyte);
+  std::string checksummed = CEP57Checksum::Encode(hash);
+
+  runner.Run("hexEncode/32", [&] { DoNotOptimize(hexEncode(hash)); });
+  runner.Run("hexEncode/1024", [&] { DoNotOptimize(hexEncode(kilobyte)); });
+  runner.Run("hexDecode/32", [&] { DoNotOptimize(hexDecode(hash_hex)); });
+  runner.Run("hexDecode/1024",
+             [&] { DoNotOptimize(hexDecode(kilobyte_hex)); });
+  runner.Run("CEP57Checksum::Encode/32",
+             [&] { DoNotOptimize(CEP57Checksum::Encode(hash)); });
+  runner.Run("CEP57Checksum::Decode/32",
+             [&] { DoNotOptimize(CEP57Checksum::Decode(checksummed)); });
+
+  uint512_t amount = u512FromDec("23000000000");
+  uint512_t balance = u512FromDec("1234567890123456789012345678901234567890");
+  std::string balance_dec = u512ToDec(balance);
+  std::string balance_hex = u512ToHex(balance);
+  runner.Run("u512ToDec/amount", [&] { DoNotOptimize(u512ToDec(amount)); });
+  runner.Run("u512ToDec/40", [&] { DoNotOptimize(u512ToDec(balance)); });
+  runner.Run("u512FromDec/40",
+             [&] { DoNotOptimize(u512FromDec(balance_dec)); });
+  runner.Run("u512ToHex/40", [&] { DoNotOptimize(u512ToHex(balance)); });
+  runner.Run("u512FromHex/40",
+             [&] { DoNotOptimize(u512FromHex(balance_hex)); });
+
+  std::string uref_text = "uref-" + checksummed + "-007";
+  GlobalStateKey uref = GlobalStateKey::FromString(uref_text);
+  CBytes uref_bytes = uref.GetBytes();
+  runner.Run("GlobalStateKey::FromString/uref",
+             [&] { DoNotOptimize(GlobalStateKey::FromString(uref_text)); });
+  runner.Run("GlobalStateKey::FromBytes/uref",
+             [&] { DoNotOptimize(GlobalStateKey::FromBytes(uref_bytes)); });
+  runner.Run("GlobalStateKeyByteSerializer/uref", [&] {
+    DoNotOptimize(GlobalStateKeyByteSerializer().ToBytes(uref));
+  });
+}
+
+void RunCLValueBenchmarks(Runner& runner) {
+  uint512_t amount = u512FromDec("23000000000");
+  PublicKey public_key = PublicKey::FromHexString(
+      "0202a6e2d25621758e2c92900f842ff367bbb5e4b6a849cacb43c3eaebf371b24b85");
+  std::vector<CLValue> strings;
+  for (int i = 0; i < 16; i++) {
+    strings.push_back(CLValue::String("item " + std::to_string(i)));
+  }
+  std::map<CLValue, CLValue> map;
+  for (int i = 0; i < 16; i++) {
+    map.emplace(CLValue::String("key " + std::to_string(i)),
+                CLValue::U64(uint64_t(i)));
+  }
+
+  runner.Run("CLValue::U512", [&] { DoNotOptimize(CLValue::U512(amount)); });
+  runner.Run("CLValue::String",
+             [&] { DoNotOptimize(CLValue::String("casper-test")); });
+  runner.Run("CLValue::PublicKey",
+             [&] { DoNotOptimize(CLValue::PublicKey(public_key)); });
+  runner.Run("CLValue::Option(U64)", [&] {
+    DoNotOptimize(CLValue::Option(CLValue::U64(uint64_t(1650706686882))));
+  });
+  runner.Run("CLValue::List/16",
+             [&] { DoNotOptimize(CLValue::List(strings)); });
+  runner.Run("CLValue::Map/16", [&] { DoNotOptimize(CLValue::Map(map)); });
+
+  CLValue u512 = CLValue::U512(amount);
+  CLValue list = CLValue::List(strings);
+  CLValue dictionary = CLValue::Map(map);
+  runner.Run("CLValueByteSerializer::ToBytes(U512)",
+             [&] { DoNotOptimize(CLValueByteSerializer().ToBytes(u512)); });
+  runner.Run("CLValueByteSerializer::ToBytes(List/16)",
+             [&] { DoNotOptimize(CLValueByteSerializer().ToBytes(list)); });
+  runner.Run("CLValueByteSerializer::ToBytes(Map/16)", [&] {
+    DoNotOptimize(CLValueByteSerializer().ToBytes(dictionary));
+  });
+}
+
+void RunDeployBenchmarks(Runner& runner) {
+  Secp256k1Key secp256k1_key(
+      DataPath("KeyPair/secp256k1_secret_key.pem"));
+  Ed25519Key ed25519_key(DataPath("KeyPair/eddsa_secret_key.pem"));
+  PublicKey account =
+      PublicKey::FromHexString("02" + secp256k1_key.getPublicKeyStr());
+
+  Deploy deploy = MakeTransferDeploy(account);
+  deploy.Sign(secp256k1_key);
+  CryptoPP::SecByteBlock deploy_hash(hexDecode(deploy.hash).data(),
+                                     hexDecode(deploy.hash).size());
+
+  runner.Run("Deploy::Deploy(Transfer)",
+             [&] { DoNotOptimize(MakeTransferDeploy(account)); });
+  runner.Run("Deploy::Sign(Secp256k1Key)", [&] {
+    Deploy signed_deploy = deploy;
+    signed_deploy.approvals.clear();
+    signed_deploy.Sign(secp256k1_key);
+    DoNotOptimize(signed_deploy);
+  });
+  runner.Run("Ed25519Key::sign",
+             [&] { DoNotOptimize(ed25519_key.sign(deploy_hash)); });
+  runner.Run("DeployByteSerializer::ToBytes(Deploy)",
+             [&] { DoNotOptimize(DeployByteSerializer().ToBytes(deploy)); });
+}
+
+void RunJsonBenchmarks(Runner& runner) {
+  nlohmann::json block = LoadJson("Rpc/chain_get_block.json");
+  nlohmann::json deploy_info = LoadJson("Rpc/info_get_deploy.json");
+  std::string block_text = block.dump();
+  std::string deploy_info_text = deploy_info.dump();
+
+  runner.Run("from_json(GetBlockResult)",
+             [&] { DoNotOptimize(block.get<GetBlockResult>()); });
+  runner.Run("from_json(GetDeployInfoResult)",
+             [&] { DoNotOptimize(deploy_info.get<GetDeployInfoResult>()); });
+  runner.Run("parse+from_json(GetBlockResult)", [&] {
+    DoNotOptimize(nlohmann::json::parse(block_text).get<GetBlockResult>());
+  });
+  runner.Run("parse+from_json(GetDeployInfoResult)", [&] {
+    DoNotOptimize(
+        nlohmann::json::parse(deploy_info_text).get<GetDeployInfoResult>());
+  });
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (i + 1 >= argc) return false;
+    if (arg == "--filter") {
+      options.filter = argv[++i];
+    } else if (arg == "--min-time-ms") {
+      options.min_time = std::chrono::milliseconds(std::stoi(argv[++i]));
+    } else if (arg == "--repetitions") {
+      options.repetitions = std::max(1, std::stoi(argv[++i]));
+    } else if (arg == "--out") {
+      options.out = argv[++i];
+    } else {
+      return false;
+    }
+  }
+  return true;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    std::cerr << "usage: " << argv[0]
+              << " [--filter <text>] [--min-time-ms <ms>]"
+                 " [--repetitions <count>] [--out <file>]"
+              << std::endl;
+    return 2;
+  }
+
+  Runner runner(options);
+  RunEncodingBenchmarks(runner);
+  RunCLValueBenchmarks(runner);
+  RunDeployBenchmarks(runner);
+  RunJsonBenchmarks(runner);
+
+  std::string results = runner.ToJson().dump(2);
+  if (options.out.empty()) {
+    std::cout << results << std::endl;
+  } else {
+    std::ofstream(options.out) << results << std::endl;
+  }
+  return 0;
+}
@@ -181,20 +181,8 @@ void accountPutDeploy() {
       Casper::Signature::FromHexString(
           deploy_params.approvals[0].signature.ToHexString()));
   // dp.AddApproval(approval);
-  /*
-    using namespace std::chrono;
-
-    const auto now_ms = time_point_cast<milliseconds>(system_clock::now());
-    const auto now_s = time_point_cast<seconds>(now_ms);
-    const auto millis = now_ms - now_s;
-    const auto c_now = system_clock::to_time_t(now_s);
-
-    std::stringstream ss;
-    ss << std::put_time(gmtime(&c_now), "%FT%T") << '.' << std::setfill('0')
-       << std::setw(3) << millis.count() << 'Z';
-
-  */
-  dp.header.timestamp = "2022-04-23T09:38:21.700Z";
+  // Casper::Timestamp::Now() gives the current time
+  dp.header.timestamp = Casper::Timestamp::Parse("2022-04-23T09:38:21.700Z");
   Casper::Deploy t2(dp.header, dp.payment, dp.session);
   t2.AddApproval(approval);
 
@@ -0,0 +1,488 @@
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "CasperClient.h"
+#include "MockNode.h"
+#include "Types/Secp256k1Key.h"
+#include "Utils/BoundedQueue.h"
+#include "Utils/Metrics.h"
+
+/// Submits signed deploys to one or more nodes and reports the latencies:
+///
+///   casper-loadgen [--node <url>]... [--mock] [--mock-latency-us <us>]
+///                  [--tps <rate>] [--arrival paced|poisson]
+///                  [--duration-s <seconds>] [--count <deploys>]
+///                  [--threads <count>] [--connections <count>]
+///                  [--kind transfer|contract] [--contract-hash <hex>]
+///                  [--entry-point <name>] [--target <public key>]
+///                  [--key <secp256k1 pem>] [--chain <name>]
+///                  [--confirm] [--confirm-timeout-s <seconds>]
+///                  [--confirm-interval-ms <ms>] [--seed <seed>]
+///                  [--out <json file>]
+///
+/// With a rate, the deploys are scheduled open-loop, at fixed intervals or
+/// with Poisson arrivals, whatever the latency of the node. The latencies are
+/// measured from the scheduled time, so a saturated submitter shows in the
+/// percentiles instead of lowering the rate. Without a rate each thread
+/// submits its next deploy as soon as the previous one returns.
+///
+/// --mock starts a MockNode in the process and submits to it.
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Options {
+  std::vector<std::string> nodes;
+  bool mock = false;
+  std::chrono::microseconds mock_latency{0};
+
+  /// Deploys per second, 0 for closed-loop threads.
+  double tps = 0;
+  bool poisson = false;
+  std::chrono::duration<double> duration{10};
+  uint64_t count = 0;
+
+  size_t threads = 8;
+  size_t connections = 8;
+
+  bool contract = false;
+  std::string contract_hash =
+      "ccb576d6ce6dec84a551e48f0d0b7af89ddba44c7390b690036257a04a3ae9ea";
+  std::string entry_point = "transfer";
+  std::string target =
+      "018afa98ca4be12d613617f7339a2d576950a2f9a92102ca4d6508ee31b54d2c02";
+  std::string key;
+  std::string chain = "casper-test";
+
+  bool confirm = false;
+  std::chrono::duration<double> confirm_timeout{120};
+  std::chrono::milliseconds confirm_interval{1000};
+
+  uint64_t seed = 1;
+  std::string out;
+};
+
+/// A deploy to submit, with the time it was due.
+struct Job {
+  uint64_t sequence;
+  Clock::time_point scheduled;
+};
+
+/// A submitted deploy waiting for its execution.
+struct PendingDeploy {
+  std::string hash;
+  Clock::time_point submitted;
+  Clock::time_point next_poll;
+};
+
+struct Report {
+  Casper::LatencyHistogram end_to_end;
+  Casper::LatencyHistogram put_deploy;
+  Casper::LatencyHistogram build_and_sign;
+  Casper::LatencyHistogram confirmation;
+
+  std::atomic<uint64_t> submitted = 0;
+  std::atomic<uint64_t> succeeded = 0;
+  std::atomic<uint64_t> confirmed = 0;
+  std::atomic<uint64_t> unconfirmed = 0;
+
+  std::mutex mutex;
+  std::map<int, uint64_t> errors;
+
+  void AddError(int code) {
+    std::lock_guard<std::mutex> lock(mutex);
+    errors[code]++;
+  }
+};
+
+std::string DefaultKeyPath() {
+  std::string file_path = __FILE__;
+  std::string dir_path = file_path.substr(0, file_path.rfind("/"));
+  return dir_path + "/../test/data/KeyPair/secp256k1_secret_key.pem";
+}
+
+bool ParseOptions(int argc, char** argv, Options& options) {
+  for (int i = 1; i < argc; i++) {
+    std::string arg = argv[i];
+    if (arg == "--mock") {
+      options.mock = true;
+      continue;
+    }
+    if (arg == "--confirm") {
+      options.confirm = true;
+      continue;
+    }
+    if (i + 1 == argc) return false;
+    std::string value = argv[++i];
+    if (arg == "--node") {
+      options.nodes.push_back(value);
+    } else if (arg == "--mock-latency-us") {
+      options.mock_latency = std::chrono::microseconds(std::stoll(value));
+    } else if (arg == "--tps") {
+      options.tps = std::stod(value);
+    } else if (arg == "--arrival") {
+      if (value != "paced" && value != "poisson") return false;
+      options.poisson = value == "poisson";
+    } else if (arg == "--duration-s") {
+      options.duration = std::chrono::duration<double>(std::stod(value));
+    } else if (arg == "--count") {
+      options.count = std::stoull(value);
+    } else if (arg == "--threads") {
+      options.threads = std::max<size_t>(1, std::stoul(value));
+    } else if (arg == "--connections") {
+      options.connections = std::max<size_t>(1, std::stoul(value));
+    } else if (arg == "--kind") {
+      if (value != "transfer" && value != "contract") return false;
+      options.contract = value == "contract";
+    } else if (arg == "--contract-hash") {
+      options.contract_hash = value;
+    } else if (arg == "--entry-point") {
+      options.entry_point = value;
+    } else if (arg == "--target") {
+      options.target = value;
+    } else if (arg == "--key") {
+      options.key = value;
+    } else if (arg == "--chain") {
+      options.chain = value;
+    } else if (arg == "--confirm-timeout-s") {
+      options.confirm_timeout =
+          std::chrono::duration<double>(std::stod(value));
+    } else if (arg == "--confirm-interval-ms") {
+      options.confirm_interval = std::chrono::milliseconds(std::stoll(value));
+    } else if (arg == "--seed") {
+      options.seed = std::stoull(value);
+    } else if (arg == "--out") {
+      options.out = value;
+    } else {
+      return false;
+    }
+  }
+  if (options.key.empty()) options.key = DefaultKeyPath();
+  return options.mock || !options.nodes.empty();
+}
+
+/// Builds the deploy of a job. The sequence number goes into the transfer id
+/// or the contract arguments, so every deploy has its own hash.
+Casper::Deploy MakeDeploy(const Options& options,
+                          const Casper::PublicKey& account,
+                          const Casper::PublicKey& target, uint64_t sequence) {
+  Casper::DeployHeader header(account, Casper::Timestamp::Now(),
+                              Casper::Duration::Parse("30m"), 1, "", {},
+                              options.chain);
+  Casper::ModuleBytes payment(Casper::u512FromDec("100000000"));
+  if (options.contract) {
+    Casper::StoredContractByHash session(
+        options.contract_hash, options.entry_point,
+        {Casper::NamedArg("amount",
+                          Casper::CLValue::U512(Casper::u512FromDec("1"))),
+         Casper::NamedArg("id", Casper::CLValue::U64(sequence))});
+    return Casper::Deploy(header, payment, session);
+  }
+
+  Casper::TransferDeployItem session(Casper::u512FromDec("2500000000"),
+                                     Casper::AccountHashKey(target), sequence,
+                                     true);
+  return Casper::Deploy(header, payment, session);
+}
+
+class LoadGenerator {
+ public:
+  LoadGenerator(const Options& options, Casper::Client& client)
+      : mOptions(options),
+        mClient(client),
+        mJobs(1 << 20),
+        mPending(1 << 20),
+        mTarget(Casper::PublicKey::FromHexString(options.target)) {}
+
+  void Run() {
+    mStart = Clock::now();
+    std::vector<std::thread> workers;
+    for (size_t i = 0; i < mOptions.threads; i++) {
+      workers.emplace_back([this] { Submit(); });
+    }
+    std::vector<std::thread> confirmers;
+    if (mOptions.confirm) {
+      for (size_t i = 0; i < std::max<size_t>(1, mOptions.threads / 4); i++) {
+        confirmers.emplace_back([this] { Confirm(); });
+      }
+    }
+
+    if (mOptions.tps > 0) Schedule();
+    for (std::thread& worker : workers) worker.join();
+    mSubmitEnd = Clock::now();
+
+    mSubmitDone = true;
+    mPending.Close();
+    for (std::thread& confirmer : confirmers) confirmer.join();
+  }
+
+  void Print(std::ostream& out) {
+    double elapsed = Seconds(mSubmitEnd - mStart);
+    out << "deploys: " << mReport.submitted << " submitted, "
+        << mReport.succeeded << " accepted in " << elapsed << " s ("
+        << (elapsed > 0 ? mReport.succeeded / elapsed : 0) << " per second)"
+        << std::endl;
+    for (const auto& [code, count] : mReport.errors) {
+      out << "  error " << code << ": " << count << std::endl;
+    }
+    PrintHistogram(out, "end-to-end", mReport.end_to_end);
+    PrintHistogram(out, "put_deploy", mReport.put_deploy);
+    PrintHistogram(out, "build+sign", mReport.build_and_sign);
+    if (mOptions.confirm) {
+      out << "confirmed: " << mReport.confirmed << ", timed out: "
+          << mReport.unconfirmed << std::endl;
+      PrintHistogram(out, "confirmation", mReport.confirmation);
+    }
+  }
+
+  nlohmann::json ToJson() {
+    double elapsed = Seconds(mSubmitEnd - mStart);
+    nlohmann::json report = {
+        {"submitted", mReport.submitted.load()},
+        {"accepted", mReport.succeeded.load()},
+        {"seconds", elapsed},
+        {"tps", mOptions.tps},
+        {"arrival", mOptions.poisson ? "poisson" : "paced"},
+        {"threads", mOptions.threads},
+        {"connections", mOptions.connections},
+        {"kind", mOptions.contract ? "contract" : "transfer"},
+        {"latency_us",
+         {{"end_to_end", HistogramJson(mReport.end_to_end)},
+          {"put_deploy", HistogramJson(mReport.put_deploy)},
+          {"build_and_sign", HistogramJson(mReport.build_and_sign)}}}};
+    nlohmann::json errors = nlohmann::json::object();
+    for (const auto& [code, count] : mReport.errors) {
+      errors[std::to_string(code)] = count;
+    }
+    report["errors"] = errors;
+    if (mOptions.confirm) {
+      report["confirmed"] = mReport.confirmed.load();
+      report["unconfirmed"] = mReport.unconfirmed.load();
+      report["latency_us"]["confirmation"] =
+          HistogramJson(mReport.confirmation);
+    }
+    return report;
+  }
+
+ private:
+  static double Seconds(Clock::duration duration) {
+    return std::chrono::duration<double>(duration).count();
+  }
+
+  static void PrintHistogram(std::ostream& out, const std::string& name,
+                             const Casper::LatencyHistogram& histogram) {
+    Casper::HistogramSnapshot snapshot = histogram.GetSnapshot();
+    char line[160];
+    std::snprintf(line, sizeof(line),
+                  "  %-12s n=%-8llu mean=%.0f p50=%llu p90=%llu p99=%llu "
+                  "p99.9=%llu max=%llu us",
+                  name.c_str(), (unsigned long long)snapshot.count,
+                  snapshot.GetMean(),
+                  (unsigned long long)snapshot.GetPercentile(0.5),
+                  (unsigned long long)snapshot.GetPercentile(0.9),
+                  (unsigned long long)snapshot.GetPercentile(0.99),
+                  (unsigned long long)snapshot.GetPercentile(0.999),
+                  (unsigned long long)snapshot.max);
+    out << line << std::endl;
+  }
+
+  static nlohmann::json HistogramJson(
+      const Casper::LatencyHistogram& histogram) {
+    Casper::HistogramSnapshot snapshot = histogram.GetSnapshot();
+    return {{"count", snapshot.count},
+            {"mean", snapshot.GetMean()},
+            {"min", snapshot.min},
+            {"p50", snapshot.GetPercentile(0.5)},
+            {"p90", snapshot.GetPercentile(0.9)},
+            {"p99", snapshot.GetPercentile(0.99)},
+            {"p999", snapshot.GetPercentile(0.999)},
+            {"max", snapshot.max}};
+  }
+
+  bool Done(uint64_t sequence, Clock::time_point time) const {
+    if (mOptions.count > 0) return sequence >= mOptions.count;
+    return time - mStart >= mOptions.duration;
+  }
+
+  /// Pushes the jobs at their scheduled times, open-loop.
+  void Schedule() {
+    std::mt19937_64 random(mOptions.seed);
+    std::exponential_distribution<double> gap(mOptions.tps);
+    std::chrono::duration<double> offset(0);
+    for (uint64_t sequence = 0;; sequence++) {
+      offset += std::chrono::duration<double>(
+          mOptions.poisson ? gap(random) : 1 / mOptions.tps);
+      Clock::time_point scheduled =
+          mStart + std::chrono::duration_cast<Clock::duration>(offset);
+      if (Done(sequence, scheduled)) break;
+      std::this_thread::sleep_until(scheduled);
+      mJobs.Push({sequence, scheduled});
+    }
+    mJobs.Close();
+  }
+
+  void Submit() {
+    // each thread signs with its own copy of the key
+    Casper::Secp256k1Key key(mOptions.key);
+    Casper::PublicKey account =
+        Casper::PublicKey::FromHexString("02" + key.getPublicKeyStr());
+
+    while (true) {
+      Job job;
+      if (mOptions.tps > 0) {
+        if (!mJobs.Pop(job)) break;
+      } else {
+        job = {mNextSequence++, Clock::now()};
+        if (Done(job.sequence, job.scheduled)) break;
+      }
+
+      Clock::time_point build_start = Clock::now();
+      Casper::Deploy deploy =
+          MakeDeploy(mOptions, account, mTarget, job.sequence);
+      deploy.Sign(key);
+      Clock::time_point sent = Clock::now();
+      mReport.build_and_sign.Record(sent - build_start);
+
+      mReport.submitted++;
+      try {
+        mClient.PutDeploy(deploy);
+      } catch (const jsonrpccxx::JsonRpcException& e) {
+        mReport.AddError(e.Code());
+        continue;
+      } catch (const std::exception&) {
+        mReport.AddError(Casper::TRANSPORT_ERROR);
+        continue;
+      }
+      Clock::time_point received = Clock::now();
+      mReport.put_deploy.Record(received - sent);
+      mReport.end_to_end.Record(received - job.scheduled);
+      mReport.succeeded++;
+
+      if (mOptions.confirm) {
+        mPending.Push({deploy.hash, received, received});
+      }
+    }
+  }
+
+  /// Polls the submitted deploys until they have an execution result.
+  void Confirm() {
+    std::vector<PendingDeploy> pending;
+    while (!mSubmitDone || mPending.Size() > 0 || !pending.empty()) {
+      Clock::time_point now = Clock::now();
+      Clock::time_point wake = now + mOptions.confirm_interval;
+      for (const PendingDeploy& deploy : pending) {
+        wake = std::min(wake, deploy.next_poll);
+      }
+
+      // takes a new deploy or waits for the next poll
+      PendingDeploy added;
+      if (mPending.TryPop(added, wake - now)) {
+        pending.push_back(std::move(added));
+      } else {
+        std::this_thread::sleep_until(wake);
+      }
+
+      now = Clock::now();
+      for (size_t i = 0; i < pending.size();) {
+        PendingDeploy& deploy = pending[i];
+        if (deploy.next_poll > now) {
+          i++;
+          continue;
+        }
+        if (Poll(deploy.hash)) {
+          mReport.confirmation.Record(Clock::now() - deploy.submitted);
+          mReport.confirmed++;
+        } else if (now - deploy.submitted < mOptions.confirm_timeout) {
+          deploy.next_poll = now + mOptions.confirm_interval;
+          i++;
+          continue;
+        } else {
+          mReport.unconfirmed++;
+        }
+        pending[i] = std::move(pending.back());
+        pending.pop_back();
+      }
+    }
+  }
+
+  bool Poll(const std::string& hash) {
+    try {
+      return !mClient.GetDeployInfo(hash).execution_results.empty();
+    } catch (const std::exception&) {
+      // not known by the node yet
+      return false;
+    }
+  }
+
+  const Options& mOptions;
+  Casper::Client& mClient;
+  Casper::BoundedQueue<Job> mJobs;
+  Casper::BoundedQueue<PendingDeploy> mPending;
+  Casper::PublicKey mTarget;
+  Report mReport;
+
+  std::atomic<uint64_t> mNextSequence = 0;
+  Clock::time_point mStart;
+  Clock::time_point mSubmitEnd;
+  std::atomic<bool> mSubmitDone = false;
+};
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Options options;
+  if (!ParseOptions(argc, argv, options)) {
+    std::cerr
+        << "usage: " << argv[0]
+        << " (--node <url>... | --mock) [--mock-latency-us <us>]"
+           " [--tps <rate>] [--arrival paced|poisson] [--duration-s <s>]"
+           " [--count <deploys>] [--threads <count>]"
+           " [--connections <count>] [--kind transfer|contract]"
+           " [--contract-hash <hex>] [--entry-point <name>]"
+           " [--target <public key>] [--key <secp256k1 pem>]"
+           " [--chain <name>] [--confirm] [--confirm-timeout-s <s>]"
+           " [--confirm-interval-ms <ms>] [--seed <seed>]"
+           " [--out <json file>]"
+        << std::endl;
+    return 2;
+  }
+
+  std::unique_ptr<Casper::MockNode> mock_node;
+  if (options.mock) {
+    Casper::MockNodeOptions mock_options;
+    mock_options.latency = options.mock_latency;
+    mock_options.seed = options.seed;
+    mock_options.threads = std::max<size_t>(32, options.connections);
+    mock_node = std::make_unique<Casper::MockNode>(mock_options);
+    mock_node->Start();
+    options.nodes.push_back(mock_node->GetAddress());
+  }
+
+  size_t connections = options.connections;
+  Casper::Client client(options.nodes, [connections](const std::string& url) {
+    return std::make_unique<Casper::EventLoopConnector>(url, connections);
+  });
+
+  LoadGenerator generator(options, client);
+  generator.Run();
+  generator.Print(std::cout);
+
+  if (!options.out.empty()) {
+    std::ofstream out(options.out);
+    out << generator.ToJson().dump(2) << std::endl;
+  }
+  return 0;
+}
@@ -2,203 +2,348 @@
 
 namespace Casper {
 
+/// Maximum number of dictionary items kept by the client.
+constexpr const size_t DICTIONARY_ITEM_CACHE_SIZE = 16384;
+
+namespace {
+/// Requests of the client methods, rendered once.
+const RequestTemplate INFO_GET_PEERS("info_get_peers");
+const RequestTemplate INFO_GET_STATUS("info_get_status");
+const RequestTemplate INFO_GET_DEPLOY("info_get_deploy",
+                                      R"({"deploy_hash":$})");
+const RequestTemplate STATE_ROOT_HASH_BY_HASH(
+    "chain_get_state_root_hash", R"({"block_identifier":{"Hash":$}})");
+const RequestTemplate STATE_ROOT_HASH_BY_HEIGHT(
+    "chain_get_state_root_hash", R"({"block_identifier":{"Height":$}})");
+const RequestTemplate BLOCK_TRANSFERS_BY_HASH(
+    "chain_get_block_transfers", R"({"block_identifier":{"Hash":$}})");
+const RequestTemplate BLOCK_TRANSFERS_BY_HEIGHT(
+    "chain_get_block_transfers", R"({"block_identifier":{"Height":$}})");
+const RequestTemplate BLOCK_BY_HASH("chain_get_block",
+                                    R"({"block_identifier":{"Hash":$}})");
+const RequestTemplate BLOCK_BY_HEIGHT("chain_get_block",
+                                      R"({"block_identifier":{"Height":$}})");
+const RequestTemplate ERA_INFO_BY_HASH("chain_get_era_info_by_switch_block",
+                                       R"({"block_identifier":{"Hash":$}})");
+const RequestTemplate ERA_INFO_BY_HEIGHT(
+    "chain_get_era_info_by_switch_block",
+    R"({"block_identifier":{"Height":$}})");
+const RequestTemplate STATE_GET_ITEM(
+    "state_get_item", R"({"key":$,"path":$,"state_root_hash":$})");
+const RequestTemplate DICTIONARY_ITEM(
+    "state_get_dictionary_item",
+    R"({"dictionary_identifier":{"Dictionary":$},"state_root_hash":$})");
+const RequestTemplate DICTIONARY_ITEM_BY_ACCOUNT(
+    "state_get_dictionary_item",
+    R"({"dictionary_identifier":{"AccountNamedKey":{"dictionary_item_key":$,"dictionary_name":$,"key":$}},"state_root_hash":$})");
+const RequestTemplate DICTIONARY_ITEM_BY_CONTRACT(
+    "state_get_dictionary_item",
+    R"({"dictionary_identifier":{"ContractNamedKey":{"dictionary_item_key":$,"dictionary_name":$,"key":$}},"state_root_hash":$})");
+const RequestTemplate DICTIONARY_ITEM_BY_UREF(
+    "state_get_dictionary_item",
+    R"({"dictionary_identifier":{"URef":{"dictionary_item_key":$,"seed_uref":$}},"state_root_hash":$})");
+const RequestTemplate STATE_GET_BALANCE(
+    "state_get_balance", R"({"purse_uref":$,"state_root_hash":$})");
+const RequestTemplate AUCTION_INFO_BY_HASH(
+    "state_get_auction_info", R"({"block_identifier":{"Hash":$}})");
+const RequestTemplate AUCTION_INFO_BY_HEIGHT(
+    "state_get_auction_info", R"({"block_identifier":{"Height":$}})");
+const RequestTemplate ACCOUNT_PUT_DEPLOY("account_put_deploy",
+                                         R"({"deploy":$})");
+}  // namespace
+
 /// Construct a new Casper Client object
 Client::Client(const std::string& address)
-    : mAddress{address},
-      mHttpConnector{mAddress},
-      mRpcClient{mHttpConnector, jsonrpccxx::version::v2} {}
+    : Client(std::vector<std::string>{address}) {}
+
+/// Construct a new Casper Client object over several nodes
+Client::Client(const std::vector<std::string>& addresses,
+               const TransportFactory& transport_factory)
+    : mAddress{addresses.empty() ? "" : addresses.front()},
+      mHttpConnector{addresses, transport_factory} {}
+
+/// Updates the tip height and health of every node.
+void Client::RefreshNodeStatus() { mHttpConnector.RefreshStatus(); }
+
+/// Returns the statistics of every node.
+std::vector<NodeStats> Client::GetNodeStats() const {
+  return mHttpConnector.GetNodeStats();
+}
+
+/// Sets the connect, read and write timeouts of the calls.
+void Client::SetTimeouts(std::chrono::milliseconds connect_timeout,
+                         std::chrono::milliseconds read_timeout,
+                         std::chrono::milliseconds write_timeout) {
+  mHttpConnector.SetTimeouts(connect_timeout, read_timeout, write_timeout);
+}
+
+/// Asks the nodes for compressed responses.
+void Client::SetCompression(bool on) { mHttpConnector.SetCompression(on); }
+
+/// Limits the rate of the calls to each node.
+void Client::SetRateLimit(double calls_per_second, double burst) {
+  mHttpConnector.SetRateLimit(calls_per_second, burst);
+}
+
+/// Sets the time for the error rate of a node to halve.
+void Client::SetErrorRateHalfLife(std::chrono::milliseconds half_life) {
+  mHttpConnector.SetErrorRateHalfLife(half_life);
+}
+
+/// Returns the metrics of the calls.
+std::map<std::string, MethodMetricsSnapshot> Client::GetMetrics() const {
+  return mMetrics.GetSnapshot();
+}
+
+/// Returns the metrics of the calls in the Prometheus text format.
+std::string Client::ExportMetrics() const {
+  return MetricsRegistry::ToPrometheusText(mMetrics.GetSnapshot());
+}
+
+/// Sets the hedging policy of the read calls.
+void Client::SetHedgingPolicy(const HedgingPolicy& policy) {
+  mHttpConnector.SetHedgingPolicy(policy);
+}
+
+/// Returns the number of duplicate calls sent by the hedging policy.
+uint64_t Client::GetHedgedCallCount() const {
+  return mHttpConnector.GetHedgedCallCount();
+}
 
 /// Get a list of the nodes.
 InfoGetPeersResult Client::GetNodePeers() {
-  return mRpcClient.CallMethod<InfoGetPeersResult>(1, "info_get_peers", {});
+  return Call<InfoGetPeersResult>(INFO_GET_PEERS);
 }
 
 /// Returns the state root hash at a given block
 GetStateRootHashResult Client::GetStateRootHash(std::string block_hash) {
-  nlohmann::json hashJSON{{"Hash", block_hash}};
-  nlohmann::json block_identifier{{"block_identifier", hashJSON}};
-
-  return mRpcClient.CallMethodNamed<GetStateRootHashResult>(
-      1, "chain_get_state_root_hash", block_identifier);
+  return Call<GetStateRootHashResult>(STATE_ROOT_HASH_BY_HASH, block_hash);
 }
 
 /// Returns the state root hash at a given height
 GetStateRootHashResult Client::GetStateRootHash(uint64_t block_height) {
-  nlohmann::json heightJSON{{"Height", block_height}};
-  nlohmann::json block_identifier{{"block_identifier", heightJSON}};
-
-  return mRpcClient.CallMethodNamed<GetStateRootHashResult>(
-      1, "chain_get_state_root_hash", block_identifier);
+  return Call<GetStateRootHashResult>(STATE_ROOT_HASH_BY_HEIGHT, block_height);
 }
 
 /// Returns the deploy info.
 GetDeployInfoResult Client::GetDeployInfo(std::string deploy_hash) {
-  nlohmann::json hashJSON{{"deploy_hash", deploy_hash}};
-
-  return mRpcClient.CallMethodNamed<GetDeployInfoResult>(1, "info_get_deploy",
-                                                         hashJSON);
+  return Call<GetDeployInfoResult>(INFO_GET_DEPLOY, deploy_hash);
 }
 
 /// Returns the status info.
 GetStatusResult Client::GetStatusInfo() {
-  return mRpcClient.CallMethodNamed<GetStatusResult>(1, "info_get_status");
+  return Call<GetStatusResult>(INFO_GET_STATUS);
 }
 
 /// Returns the transfers at the block given by the block hash.
 GetBlockTransfersResult Client::GetBlockTransfers(std::string block_hash) {
-  nlohmann::json hashJSON{{"Hash", block_hash}};
-  nlohmann::json block_identifier{{"block_identifier", hashJSON}};
-
-  return mRpcClient.CallMethodNamed<GetBlockTransfersResult>(
-      1, "chain_get_block_transfers", block_identifier);
+  return Call<GetBlockTransfersResult>(BLOCK_TRANSFERS_BY_HASH, block_hash);
 }
 
 /// Returns the transfers at the block given by the block height.
 GetBlockTransfersResult Client::GetBlockTransfers(uint64_t block_height) {
-  nlohmann::json heightJSON{{"Height", block_height}};
-  nlohmann::json block_identifier{{"block_identifier", heightJSON}};
-
-  return mRpcClient.CallMethodNamed<GetBlockTransfersResult>(
-      1, "chain_get_block_transfers", block_identifier);
+  return Call<GetBlockTransfersResult>(BLOCK_TRANSFERS_BY_HEIGHT,
+                                       block_height);
 }
 
 /// Returns the block at the block given by the block hash.
 GetBlockResult Client::GetBlock(std::string block_hash) {
-  nlohmann::json hashJSON{{"Hash", block_hash}};
-  nlohmann::json block_identifier{{"block_identifier", hashJSON}};
-
-  return mRpcClient.CallMethodNamed<GetBlockResult>(1, "chain_get_block",
-                                                    block_identifier);
+  return Call<GetBlockResult>(BLOCK_BY_HASH, block_hash);
 }
 
 /// Returns the block at the block given by the block height.
 GetBlockResult Client::GetBlock(uint64_t block_height) {
-  nlohmann::json heightJSON{{"Height", block_height}};
-  nlohmann::json block_identifier{{"block_identifier", heightJSON}};
-
-  return mRpcClient.CallMethodNamed<GetBlockResult>(1, "chain_get_block",
-                                                    block_identifier);
+  return Call<GetBlockResult>(BLOCK_BY_HEIGHT, block_height);
 }
 
 /// Returns the era information at the block given by the block hash.
 GetEraInfoResult Client::GetEraInfoBySwitchBlock(std::string block_hash) {
-  nlohmann::json hashJSON{{"Hash", block_hash}};
-  nlohmann::json block_identifier{{"block_identifier", hashJSON}};
-
-  return mRpcClient.CallMethodNamed<GetEraInfoResult>(
-      1, "chain_get_era_info_by_switch_block", block_identifier);
+  return Call<GetEraInfoResult>(ERA_INFO_BY_HASH, block_hash);
 }
 
 /// Returns the era information at the block given by the block height.
 GetEraInfoResult Client::GetEraInfoBySwitchBlock(uint64_t block_height) {
-  nlohmann::json heightJSON{{"Height", block_height}};
-  nlohmann::json block_identifier{{"block_identifier", heightJSON}};
-
-  return mRpcClient.CallMethodNamed<GetEraInfoResult>(
-      1, "chain_get_era_info_by_switch_block", block_identifier);
+  return Call<GetEraInfoResult>(ERA_INFO_BY_HEIGHT, block_height);
 }
 
 /// Returns the item at the given address with the given key.
 GetItemResult Client::GetItem(std::string state_root_hash, std::string key,
                               std::vector<std::string> path) {
-  nlohmann::json paramsJSON{
-      {"state_root_hash", state_root_hash}, {"key", key}, {"path", path}};
-
-  return mRpcClient.CallMethodNamed<GetItemResult>(1, "state_get_item",
-                                                   paramsJSON);
+  return Call<GetItemResult>(STATE_GET_ITEM, key, path, state_root_hash);
 }
 
 /// Returns the dictionary item with the given key and state root hash.
 nlohmann::json Client::GetDictionaryItem(std::string stateRootHash,
                                          std::string dictionaryItem) {
-  nlohmann::json dictionaryJSON{{"Dictionary", dictionaryItem}};
-
-  nlohmann::json paramsJSON{{"state_root_hash", stateRootHash},
-                            {"dictionary_identifier", dictionaryJSON}};
-
-  return mRpcClient.CallMethodNamed<nlohmann::json>(
-      1, "state_get_dictionary_item", paramsJSON);
+  return Call<nlohmann::json>(DICTIONARY_ITEM, dictionaryItem, stateRootHash);
 }
 
 /// Returns the dictionary item with the given account key and item key.
 GetDictionaryItemResult Client::GetDictionaryItemByAccount(
     std::string stateRootHash, std::string accountKey,
     std::string dictionaryName, std::string dictionaryItemKey) {
-  nlohmann::json accountNamedKey{{"key", accountKey},
-                                 {"dictionary_name", dictionaryName},
-                                 {"dictionary_item_key", dictionaryItemKey}};
-  nlohmann::json accountNamedKeyJSON{{"AccountNamedKey", accountNamedKey}};
-  nlohmann::json paramsJSON{{"state_root_hash", stateRootHash},
-                            {"dictionary_identifier", accountNamedKeyJSON}};
-
-  return mRpcClient.CallMethodNamed<GetDictionaryItemResult>(
-      1, "state_get_dictionary_item", paramsJSON);
+  return Call<GetDictionaryItemResult>(DICTIONARY_ITEM_BY_ACCOUNT,
+                                       dictionaryItemKey, dictionaryName,
+                                       accountKey, stateRootHash);
 }
 
 /// Returns the dictionary item with the given contract.
 GetDictionaryItemResult Client::GetDictionaryItemByContract(
     std::string stateRootHash, std::string contractKey,
     std::string dictionaryName, std::string dictionaryItemKey) {
-  nlohmann::json contractNamedKey{{"key", contractKey},
-                                  {"dictionary_name", dictionaryName},
-                                  {"dictionary_item_key", dictionaryItemKey}};
-  nlohmann::json contractNamedKeyJSON{{"ContractNamedKey", contractNamedKey}};
-  nlohmann::json paramsJSON{{"state_root_hash", stateRootHash},
-                            {"dictionary_identifier", contractNamedKeyJSON}};
-
-  return mRpcClient.CallMethodNamed<GetDictionaryItemResult>(
-      1, "state_get_dictionary_item", paramsJSON);
+  return Call<GetDictionaryItemResult>(DICTIONARY_ITEM_BY_CONTRACT,
+                                       dictionaryItemKey, dictionaryName,
+                                       contractKey, stateRootHash);
 }
 
 /// Returns the dictionary item with the given URef.
 GetDictionaryItemResult Client::GetDictionaryItemByURef(
     std::string stateRootHash, std::string seedURef,
     std::string dictionaryItemKey) {
-  nlohmann::json urefIdentifier{{"seed_uref", seedURef},
-                                {"dictionary_item_key", dictionaryItemKey}};
-  nlohmann::json urefIdentifierJSON{{"URef", urefIdentifier}};
-  nlohmann::json paramsJSON{{"state_root_hash", stateRootHash},
-                            {"dictionary_identifier", urefIdentifierJSON}};
+  return Call<GetDictionaryItemResult>(DICTIONARY_ITEM_BY_UREF,
+                                       dictionaryItemKey, seedURef,
+                                       stateRootHash);
+}
+
+/// Returns the dictionary items stored under the given dictionary keys.
+std::vector<GetDictionaryItemResult> Client::GetDictionaryItems(
+    std::string stateRootHash,
+    const std::vector<DictionaryKey>& dictionaryKeys) {
+  std::vector<GetDictionaryItemResult> results(dictionaryKeys.size());
+  std::vector<size_t> missing;
+
+  {
+    std::lock_guard<std::mutex> lock(mDictionaryItemCacheMutex);
+    for (size_t i = 0; i < dictionaryKeys.size(); i++) {
+      auto it =
+          mDictionaryItemCache.find({stateRootHash, dictionaryKeys[i].key});
+      if (it != mDictionaryItemCache.end()) {
+        results[i] = it->second;
+      } else {
+        missing.push_back(i);
+      }
+    }
+  }
+
+  if (missing.empty()) {
+    return results;
+  }
+
+  auto paramsFor = [&](size_t i) {
+    nlohmann::json dictionaryJSON{{"Dictionary", dictionaryKeys[i].key}};
+    return jsonrpccxx::named_parameter{
+        {"state_root_hash", stateRootHash},
+        {"dictionary_identifier", dictionaryJSON}};
+  };
+
+  bool fetched = false;
+  if (mBatchSupported && missing.size() > 1) {
+    jsonrpccxx::BatchRequest request;
+    for (size_t i : missing) {
+      request.AddNamedMethodCall(static_cast<int>(i),
+                                 "state_get_dictionary_item", paramsFor(i));
+    }
+
+    // Transport errors and the errors of single items are thrown. The
+    // calls are only sent one by one when the node answers the batch itself
+    // with an error saying that it does not take batches.
+    fetched = Send(
+        DICTIONARY_ITEM.GetMethod(), request.Build().dump(),
+        [&](nlohmann::json& response) {
+          if (response.is_array()) {
+            jsonrpccxx::BatchResponse batch_response(std::move(response));
+            for (size_t i : missing) {
+              results[i] = batch_response.Get<GetDictionaryItemResult>(
+                  static_cast<int>(i));
+            }
+            return true;
+          }
+
+          auto error = response.find("error");
+          if (!response.is_object() || error == response.end() ||
+              !error->is_object()) {
+            throw jsonrpccxx::JsonRpcException(
+                jsonrpccxx::parse_error,
+                "invalid JSON response from server: expected array");
+          }
+          int code = error->value("code", 0);
+          if (code != jsonrpccxx::method_not_found &&
+              code != jsonrpccxx::invalid_request) {
+            throw jsonrpccxx::JsonRpcException::fromJson(*error);
+          }
+          mBatchSupported = false;
+          return false;
+        });
+  }
+
+  if (!fetched) {
+    for (size_t i : missing) {
+      results[i] = Call<GetDictionaryItemResult>(
+          DICTIONARY_ITEM, dictionaryKeys[i].key, stateRootHash);
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mDictionaryItemCacheMutex);
+  for (size_t i : missing) {
+    std::pair<std::string, std::string> key{stateRootHash,
+                                            dictionaryKeys[i].key};
+    if (mDictionaryItemCache.insert_or_assign(key, results[i]).second) {
+      mDictionaryItemCacheOrder.push_back(std::move(key));
+    }
+  }
+  while (mDictionaryItemCache.size() > DICTIONARY_ITEM_CACHE_SIZE) {
+    mDictionaryItemCache.erase(mDictionaryItemCacheOrder.front());
+    mDictionaryItemCacheOrder.pop_front();
+  }
+
+  return results;
+}
 
-  return mRpcClient.CallMethodNamed<GetDictionaryItemResult>(
-      1, "state_get_dictionary_item", paramsJSON);
+/// Returns the dictionary items with the given seed URef and item keys.
+std::vector<GetDictionaryItemResult> Client::GetDictionaryItemsByURef(
+    std::string stateRootHash, std::string seedURef,
+    const std::vector<std::string>& dictionaryItemKeys) {
+  return GetDictionaryItems(
+      stateRootHash,
+      DictionaryKey::ListFromSeedURef(URef(seedURef), dictionaryItemKeys));
+}
+
+/// Drops the cached dictionary items.
+void Client::ClearDictionaryItemCache() {
+  std::lock_guard<std::mutex> lock(mDictionaryItemCacheMutex);
+  mDictionaryItemCache.clear();
+  mDictionaryItemCacheOrder.clear();
 }
 
 /// Returns the balance of the given account.
 GetBalanceResult Client::GetAccountBalance(std::string purseURef,
                                            std::string stateRootHash) {
-  nlohmann::json paramsJSON{{"state_root_hash", stateRootHash},
-                            {"purse_uref", purseURef}};
-
-  return mRpcClient.CallMethodNamed<GetBalanceResult>(1, "state_get_balance",
-                                                      paramsJSON);
+  return Call<GetBalanceResult>(STATE_GET_BALANCE, purseURef, stateRootHash);
 }
 
 /// Returns the auction information for the given block hash.
 GetAuctionInfoResult Client::GetAuctionInfo(std::string block_hash) {
-  nlohmann::json hashJSON{{"Hash", block_hash}};
-  nlohmann::json block_identifier{{"block_identifier", hashJSON}};
-
-  return mRpcClient.CallMethodNamed<GetAuctionInfoResult>(
-      1, "state_get_auction_info", block_identifier);
+  return Call<GetAuctionInfoResult>(AUCTION_INFO_BY_HASH, block_hash);
 }
 
 /// Returns the auction information for the given block height.
 GetAuctionInfoResult Client::GetAuctionInfo(uint64_t block_height) {
-  nlohmann::json heightJSON{{"Height", block_height}};
-  nlohmann::json block_identifier{{"block_identifier", heightJSON}};
-
-  return mRpcClient.CallMethodNamed<GetAuctionInfoResult>(
-      1, "state_get_auction_info", block_identifier);
+  return Call<GetAuctionInfoResult>(AUCTION_INFO_BY_HEIGHT, block_height);
 }
 
 /// Returns the deploy hash of the given deploy.
 PutDeployResult Client::PutDeploy(Deploy deploy) {
+  // deploys overtake the waiting reads unless the caller set a priority
+  std::optional<CallScope> scope;
+  if (CallScope::Current() == nullptr ||
+      !CallScope::Current()->priority.has_value()) {
+    scope.emplace(CallOptions::WithPriority(CallPriority::Interactive));
+  }
+
   nlohmann::json deploy_json;
   to_json(deploy_json, deploy);
-  nlohmann::json paramsJSON{{"deploy", deploy_json}};
-  return mRpcClient.CallMethodNamed<PutDeployResult>(1, "account_put_deploy",
-                                                     paramsJSON);
+  return Call<PutDeployResult>(ACCOUNT_PUT_DEPLOY,
+                               RawJson{deploy_json.dump()});
 }
 
 }  // namespace Casper
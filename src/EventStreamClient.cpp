@@ -0,0 +1,197 @@
+#include "EventStreamClient.h"
+
+namespace Casper {
+
+/// EventStreamParser
+
+bool EventStreamParser::Feed(const char* data, size_t length) {
+  for (size_t i = 0; i < length; i++) {
+    if (data[i] != '\n') {
+      mLine += data[i];
+      continue;
+    }
+
+    if (!mLine.empty() && mLine.back() == '\r') mLine.pop_back();
+    bool keep_going = ParseLine(mLine);
+    mLine.clear();
+    if (!keep_going) return false;
+  }
+  return true;
+}
+
+bool EventStreamParser::ParseLine(const std::string& line) {
+  // an empty line ends the message
+  if (line.empty()) {
+    bool keep_going = true;
+    if (!mData.empty()) keep_going = mCallback(mData, mId);
+    mData.clear();
+    mId.reset();
+    return keep_going;
+  }
+
+  // comments are used as keep-alives
+  if (line[0] == ':') return true;
+
+  size_t colon = line.find(':');
+  std::string field = line.substr(0, colon);
+  std::string value;
+  if (colon != std::string::npos) {
+    size_t value_start = colon + 1;
+    if (value_start < line.size() && line[value_start] == ' ') value_start++;
+    value = line.substr(value_start);
+  }
+
+  if (field == "data") {
+    if (!mData.empty()) mData += '\n';
+    mData += value;
+  } else if (field == "id") {
+    try {
+      mId = std::stoull(value);
+    } catch (std::exception& e) {
+      mId.reset();
+    }
+  }
+  return true;
+}
+
+/// EventStreamClient
+
+EventStreamClient::EventStreamClient(const std::string& address,
+                                     const std::string& path,
+                                     size_t queue_capacity)
+    : mAddress(address), mPath(path), mQueue(queue_capacity) {}
+
+EventStreamClient::~EventStreamClient() { Stop(); }
+
+void EventStreamClient::Start(std::optional<uint64_t> start_from) {
+  Stop();
+
+  mQueue.Open();
+  mRunning = true;
+  mReader = std::thread(&EventStreamClient::Run, this, start_from);
+}
+
+void EventStreamClient::Stop() {
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mRunning = false;
+    mStopped.notify_all();
+  }
+  // closed first, so that a reader waiting for room in the queue lets go
+  mQueue.Close();
+
+  {
+    // a stop before the connection opened its socket has no effect, the
+    // connection is stopped again until the reader releases it
+    std::unique_lock<std::mutex> lock(mMutex);
+    while (mConnection != nullptr) {
+      mConnection->stop();
+      mStopped.wait_for(lock, std::chrono::milliseconds(10),
+                        [this] { return mConnection == nullptr; });
+    }
+  }
+
+  if (mReader.joinable()) mReader.join();
+}
+
+bool EventStreamClient::Pop(Event& event) { return mQueue.Pop(event); }
+
+bool EventStreamClient::TryPop(Event& event,
+                               std::chrono::milliseconds timeout) {
+  return mQueue.TryPop(event, timeout);
+}
+
+std::optional<uint64_t> EventStreamClient::GetLastEventId() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mLastEventId;
+}
+
+std::string EventStreamClient::GetApiVersion() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mApiVersion;
+}
+
+void EventStreamClient::SetReconnectDelay(std::chrono::milliseconds delay) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  mReconnectDelay = delay;
+}
+
+void EventStreamClient::SetReadTimeout(std::chrono::seconds timeout) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  mReadTimeout = timeout;
+}
+
+void EventStreamClient::Run(std::optional<uint64_t> start_from) {
+  while (mRunning) {
+    std::string path = mPath;
+    if (start_from.has_value()) {
+      path += "?start_from=" + std::to_string(start_from.value());
+    }
+
+    httplib::Client connection(mAddress.c_str());
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (!mRunning) break;
+      connection.set_read_timeout(mReadTimeout);
+      mConnection = &connection;
+    }
+
+    EventStreamParser parser(
+        [this](const std::string& data, const std::optional<uint64_t>& id) {
+          return OnMessage(data, id);
+        });
+    connection.Get(path.c_str(),
+                   httplib::Headers{{"Accept", "text/event-stream"}},
+                   [&](const char* data, size_t length) {
+                     return mRunning && parser.Feed(data, length);
+                   });
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    mConnection = nullptr;
+    mStopped.notify_all();
+
+    // resume after the last received event
+    if (mLastEventId.has_value()) start_from = mLastEventId.value() + 1;
+
+    mStopped.wait_for(lock, mReconnectDelay, [this] { return !mRunning; });
+  }
+}
+
+bool EventStreamClient::OnMessage(const std::string& data,
+                                  const std::optional<uint64_t>& id) {
+  Event event;
+  try {
+    nlohmann::json j = nlohmann::json::parse(data);
+
+    // the first message of a stream announces the API version
+    if (j.find("ApiVersion") != j.end()) {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mApiVersion = j.at("ApiVersion").get<std::string>();
+      return true;
+    }
+
+    event = j.get<Event>();
+  } catch (std::exception& e) {
+    // an event that cannot be decoded is skipped, the stream goes on
+    CASPER_LOG_WARNING(
+        "EventStreamClient: skipped an event that cannot be decoded, id "
+        << (id.has_value() ? std::to_string(id.value()) : "none") << ": "
+        << e.what());
+  }
+  event.id = id;
+
+  // waits while the queue is full, fails once the client is stopped
+  if ((event.block_added.has_value() || event.deploy_processed.has_value() ||
+       event.finality_signature.has_value()) &&
+      !mQueue.Push(std::move(event))) {
+    return false;
+  }
+
+  if (id.has_value()) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mLastEventId = id;
+  }
+  return true;
+}
+
+}  // namespace Casper
@@ -1,7 +1,11 @@
 #pragma once
 
+#include <algorithm>
+#include <limits>
 #include <optional>
+#include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 #include <iostream>
 #include <sstream>
@@ -75,188 +79,339 @@ inline void reverseHex(std::string& hex_input) {
   std::reverse(hex_input.begin(), hex_input.end());
 }
 
-inline uint128_t u128FromHex(std::string hex_str) {
-  uint32_t len = hexToInteger<uint32_t>(hex_str.substr(0, 2));
-
-  if (len < 1) {
-    return uint128_t(0);
+/*
+Direct conversions between the limbs of the unsigned wide integers and their
+decimal text or their serialized bytes: a length byte followed by the minimal
+little-endian bytes of the value, without any byte for 0.
+*/
+namespace wide {
+/// Number of 64 bits words of a wide integer type.
+template <typename T>
+inline constexpr size_t WORD_COUNT = T::my_width2 / 64;
+
+/// The decimal text is converted by chunks of 19 digits, the largest power
+/// of ten below 2^64.
+constexpr size_t DEC_CHUNK_DIGITS = 19;
+constexpr uint64_t DEC_CHUNK = 10000000000000000000ULL;
+
+constexpr uint64_t POW10[DEC_CHUNK_DIGITS + 1] = {1ULL,
+                                                  10ULL,
+                                                  100ULL,
+                                                  1000ULL,
+                                                  10000ULL,
+                                                  100000ULL,
+                                                  1000000ULL,
+                                                  10000000ULL,
+                                                  100000000ULL,
+                                                  1000000000ULL,
+                                                  10000000000ULL,
+                                                  100000000000ULL,
+                                                  1000000000000ULL,
+                                                  10000000000000ULL,
+                                                  100000000000000ULL,
+                                                  1000000000000000ULL,
+                                                  10000000000000000ULL,
+                                                  100000000000000000ULL,
+                                                  1000000000000000000ULL,
+                                                  DEC_CHUNK};
+
+/// Copies the limbs of a value into words, least significant first.
+template <typename T>
+inline void toWords(const T& value, uint64_t* words) {
+  using limb_type = typename T::limb_type;
+  constexpr size_t LIMB_BITS = std::numeric_limits<limb_type>::digits;
+  constexpr size_t LIMBS_PER_WORD = 64 / LIMB_BITS;
+
+  const auto& limbs = value.crepresentation();
+  for (size_t i = 0; i < WORD_COUNT<T>; i++) {
+    uint64_t word = 0;
+    for (size_t k = 0; k < LIMBS_PER_WORD; k++) {
+      word |= uint64_t(limbs[i * LIMBS_PER_WORD + k]) << (k * LIMB_BITS);
+    }
+    words[i] = word;
   }
-
-  hex_str = hex_str.substr(2, len * 2);
-  reverseHex(hex_str);
-  hex_str = "0x" + hex_str;
-
-  return uint128_t(hex_str.c_str());
 }
 
-inline std::string u128ToHex(uint128_t value) {
-  if (value == 0) {
-    // std::cout << "u128ToHex: value is 0" << std::endl;
-    return "00";
+template <typename T>
+inline T fromWords(const uint64_t* words) {
+  using limb_type = typename T::limb_type;
+  constexpr size_t LIMB_BITS = std::numeric_limits<limb_type>::digits;
+  constexpr size_t LIMBS_PER_WORD = 64 / LIMB_BITS;
+
+  T value;
+  auto& limbs = value.representation();
+  for (size_t i = 0; i < WORD_COUNT<T>; i++) {
+    for (size_t k = 0; k < LIMBS_PER_WORD; k++) {
+      limbs[i * LIMBS_PER_WORD + k] = limb_type(words[i] >> (k * LIMB_BITS));
+    }
   }
+  return value;
+}
 
-  std::stringstream ss;
-  ss << std::hex << value;
-  std::string u128_str;
-  u128_str = ss.str();
+/// Returns the number of words up to the most significant non-zero one.
+inline size_t usedWords(const uint64_t* words, size_t count) {
+  while (count > 0 && words[count - 1] == 0) count--;
+  return count;
+}
 
-  if (u128_str.length() % 2 != 0) {
-    u128_str = "0" + u128_str;
+/// Writes the minimal little-endian bytes of a value, returns their number.
+template <typename T>
+inline size_t toMinimalBytes(const T& value, uint8_t* bytes) {
+  uint64_t words[WORD_COUNT<T>];
+  toWords(value, words);
+  size_t count = usedWords(words, WORD_COUNT<T>) * 8;
+  size_t size = 0;
+  for (size_t i = 0; i < count; i++) {
+    bytes[i] = uint8_t(words[i / 8] >> (i % 8 * 8));
+    if (bytes[i] != 0) size = i + 1;
   }
+  return size;
+}
 
-  //
-  uint8_t bytes_length = u128_str.length() / 2;
-  std::string bytes_length_str = integerToHex<uint8_t>(bytes_length);
-
-  reverseHex(u128_str);
-  // std::cout << "u128_str: " << u128_str << std::endl;
-
-  // this string includes the length of the string and its hex representation
-  std::string encoded_u128_str = bytes_length_str + u128_str;
-
-  return encoded_u128_str;
+inline int hexDigit(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
 }
+}  // namespace wide
 
-inline std::string u128ToDec(uint128_t value) {
-  std::stringstream ss;
-  ss << value;
-  std::string u128_str;
-  u128_str = ss.str();
+/// <summary>
+/// Returns the decimal text of an unsigned wide integer like uint512_t.
+/// </summary>
+template <typename T>
+inline std::string wideToDec(const T& value) {
+  constexpr size_t WORDS = wide::WORD_COUNT<T>;
+  uint64_t words[WORDS];
+  wide::toWords(value, words);
+  size_t size = wide::usedWords(words, WORDS);
+  if (size == 0) return "0";
+
+  // divides the words by 10^19 until they are 0, the remainders are the
+  // chunks of 19 digits, least significant first
+  uint64_t chunks[WORDS * 64 / 63 + 1];
+  size_t chunk_count = 0;
+  while (size > 1) {
+    uint64_t remainder = 0;
+    for (size_t i = size; i-- > 0;) {
+      unsigned __int128 current =
+          (static_cast<unsigned __int128>(remainder) << 64) | words[i];
+      words[i] = uint64_t(current / wide::DEC_CHUNK);
+      remainder = uint64_t(current - (unsigned __int128)words[i] *
+                                         wide::DEC_CHUNK);
+    }
+    chunks[chunk_count++] = remainder;
+    size = wide::usedWords(words, size);
+  }
+  // the last word is divided with 64 bits operations
+  if (size == 1) {
+    for (uint64_t word = words[0]; word != 0; word /= wide::DEC_CHUNK) {
+      chunks[chunk_count++] = word % wide::DEC_CHUNK;
+    }
+  }
 
-  return u128_str;
+  char text[sizeof(chunks) / sizeof(uint64_t) * wide::DEC_CHUNK_DIGITS];
+  char* end = text + sizeof(text);
+  char* begin = end;
+  for (size_t i = 0; i < chunk_count; i++) {
+    uint64_t chunk = chunks[i];
+    bool last = i + 1 == chunk_count;
+    for (size_t k = 0; k < wide::DEC_CHUNK_DIGITS && (!last || chunk); k++) {
+      *--begin = char('0' + chunk % 10);
+      chunk /= 10;
+    }
+  }
+  return std::string(begin, end);
 }
 
-inline uint128_t u128FromDec(std::string dec_str) {
-  return uint128_t(dec_str.c_str());
+/// <summary>
+/// Returns the unsigned wide integer of a decimal text. Throws
+/// std::invalid_argument if the text is not a decimal number and
+/// std::out_of_range if the number does not fit.
+/// </summary>
+template <typename T>
+inline T wideFromDec(std::string_view text) {
+  if (text.empty()) throw std::invalid_argument("Empty decimal number");
+
+  constexpr size_t WORDS = wide::WORD_COUNT<T>;
+  uint64_t words[WORDS] = {};
+  size_t size = 0;
+
+  // the first chunk takes the digits left over by the chunks of 19 digits
+  size_t position = 0;
+  size_t length = text.size() % wide::DEC_CHUNK_DIGITS;
+  if (length == 0) length = wide::DEC_CHUNK_DIGITS;
+  while (position < text.size()) {
+    uint64_t chunk = 0;
+    for (size_t k = 0; k < length; k++) {
+      unsigned digit = unsigned(text[position + k]) - '0';
+      if (digit > 9) {
+        throw std::invalid_argument("Invalid decimal number: " +
+                                    std::string(text));
+      }
+      chunk = chunk * 10 + digit;
+    }
+
+    // words = words * 10^length + chunk
+    uint64_t carry = chunk;
+    for (size_t i = 0; i < size; i++) {
+      unsigned __int128 current =
+          (unsigned __int128)words[i] * wide::POW10[length] + carry;
+      words[i] = uint64_t(current);
+      carry = uint64_t(current >> 64);
+    }
+    if (carry != 0) {
+      if (size == WORDS) {
+        throw std::out_of_range("Decimal number too large: " +
+                                std::string(text));
+      }
+      words[size++] = carry;
+    }
+
+    position += length;
+    length = wide::DEC_CHUNK_DIGITS;
+  }
+  return wide::fromWords<T>(words);
 }
 
-inline void to_json(nlohmann::json& j, const uint128_t& p) { j = u128ToDec(p); }
-
-inline void from_json(const nlohmann::json& j, uint128_t& p) {
-  p = u128FromDec(j.get<std::string>());
+/// <summary>
+/// Returns the serialized bytes of an unsigned wide integer: the number of
+/// bytes, then the minimal little-endian bytes of the value.
+/// </summary>
+template <typename T>
+inline CBytes wideToBytes(const T& value) {
+  uint8_t bytes[T::my_width2 / 8];
+  size_t size = wide::toMinimalBytes(value, bytes);
+  CBytes serialized(1 + size);
+  serialized[0] = uint8_t(size);
+  std::copy(bytes, bytes + size, serialized.begin() + 1);
+  return serialized;
 }
 
-inline uint256_t u256FromHex(std::string hex_str) {
-  uint32_t len = hexToInteger<uint32_t>(hex_str.substr(0, 2));
-
-  if (len < 1) {
-    return uint256_t(0);
+/// <summary>
+/// Returns the unsigned wide integer of serialized bytes, see wideToBytes.
+/// Throws std::invalid_argument if the bytes are truncated or the value does
+/// not fit.
+/// </summary>
+template <typename T>
+inline T wideFromBytes(const uint8_t* bytes, size_t size) {
+  if (size == 0) throw std::invalid_argument("Missing the integer length");
+  size_t length = bytes[0];
+  if (length > T::my_width2 / 8 || length > size - 1) {
+    throw std::invalid_argument("Invalid integer length");
   }
 
-  hex_str = hex_str.substr(2, len * 2);
-  reverseHex(hex_str);
-  hex_str = "0x" + hex_str;
-
-  return uint256_t(hex_str.c_str());
+  uint64_t words[wide::WORD_COUNT<T>] = {};
+  for (size_t i = 0; i < length; i++) {
+    words[i / 8] |= uint64_t(bytes[1 + i]) << (i % 8 * 8);
+  }
+  return wide::fromWords<T>(words);
 }
 
-inline std::string u256ToHex(uint256_t value) {
-  if (value == 0) {
-    // std::cout << "u256ToHex: value is 0" << std::endl;
-    return "00";
+/// <summary>
+/// Returns the hexadecimal text of the serialized bytes of an unsigned wide
+/// integer, see wideToBytes.
+/// </summary>
+template <typename T>
+inline std::string wideToHex(const T& value) {
+  static constexpr char DIGITS[] = "0123456789abcdef";
+  uint8_t bytes[T::my_width2 / 8];
+  size_t size = wide::toMinimalBytes(value, bytes);
+  std::string hex(2 + size * 2, '0');
+  hex[0] = DIGITS[size >> 4];
+  hex[1] = DIGITS[size & 0x0f];
+  for (size_t i = 0; i < size; i++) {
+    hex[2 + 2 * i] = DIGITS[bytes[i] >> 4];
+    hex[3 + 2 * i] = DIGITS[bytes[i] & 0x0f];
   }
+  return hex;
+}
 
-  std::stringstream ss;
-  ss << std::hex << value;
-  std::string u256_str;
-  u256_str = ss.str();
-
-  // std::cout << "u256_str1: " << u256_str << std::endl;
-
-  if (u256_str.length() % 2 != 0) {
-    u256_str = "0" + u256_str;
+/// <summary>
+/// Returns the unsigned wide integer of the hexadecimal text of serialized
+/// bytes, see wideToBytes. Throws std::invalid_argument if the text is not
+/// hexadecimal or the bytes are invalid.
+/// </summary>
+template <typename T>
+inline T wideFromHex(std::string_view hex) {
+  uint8_t bytes[1 + T::my_width2 / 8];
+  size_t size = std::min(hex.size() / 2, sizeof(bytes));
+  for (size_t i = 0; i < size; i++) {
+    int high = wide::hexDigit(hex[2 * i]);
+    int low = wide::hexDigit(hex[2 * i + 1]);
+    if (high < 0 || low < 0) {
+      throw std::invalid_argument("Invalid hexadecimal integer: " +
+                                  std::string(hex));
+    }
+    bytes[i] = uint8_t(high << 4 | low);
   }
-
-  // std::cout << "u256_str2: " << u256_str << std::endl;
-  //
-  uint8_t bytes_length = u256_str.length() / 2;
-  std::string bytes_length_str = integerToHex<uint8_t>(bytes_length);
-
-  // std::cout << "u256_str3: " << u256_str << std::endl;
-  reverseHex(u256_str);
-
-  // this string includes the length of the string and its hex representation
-  std::string encoded_u256_str = bytes_length_str + u256_str;
-
-  return encoded_u256_str;
+  return wideFromBytes<T>(bytes, size);
 }
 
-inline std::string u256ToDec(uint256_t value) {
-  std::stringstream ss;
-  ss << value;
-  std::string u256_str;
-  u256_str = ss.str();
-  return u256_str;
+inline uint128_t u128FromHex(std::string_view hex_str) {
+  return wideFromHex<uint128_t>(hex_str);
 }
 
-inline uint256_t u256FromDec(std::string dec_str) {
-  return uint256_t(dec_str.c_str());
+inline std::string u128ToHex(const uint128_t& value) {
+  return wideToHex(value);
 }
 
-inline void to_json(nlohmann::json& j, const uint256_t& p) { j = u256ToDec(p); }
-
-inline void from_json(const nlohmann::json& j, uint256_t& p) {
-  p = u256FromDec(j.get<std::string>());
+inline std::string u128ToDec(const uint128_t& value) {
+  return wideToDec(value);
 }
 
-inline uint512_t u512FromHex(std::string hex_str) {
-  uint32_t len = hexToInteger<uint32_t>(hex_str.substr(0, 2));
+inline uint128_t u128FromDec(std::string_view dec_str) {
+  return wideFromDec<uint128_t>(dec_str);
+}
 
-  if (len < 1) {
-    return uint512_t(0);
-  }
+inline void to_json(nlohmann::json& j, const uint128_t& p) { j = u128ToDec(p); }
 
-  hex_str = hex_str.substr(2, len * 2);
-  reverseHex(hex_str);
-  hex_str = "0x" + hex_str;
+inline void from_json(const nlohmann::json& j, uint128_t& p) {
+  p = u128FromDec(j.get_ref<const std::string&>());
+}
 
-  return uint512_t(hex_str.c_str());
+inline uint256_t u256FromHex(std::string_view hex_str) {
+  return wideFromHex<uint256_t>(hex_str);
 }
 
-inline std::string u512ToHex(uint512_t value) {
-  if (value == 0) {
-    // std::cout << "u512ToHex: value is 0" << std::endl;
-    return "00";
-  }
+inline std::string u256ToHex(const uint256_t& value) {
+  return wideToHex(value);
+}
 
-  std::stringstream ss;
-  ss << std::hex << value;
-  std::string u512_str;
-  u512_str = ss.str();
+inline std::string u256ToDec(const uint256_t& value) {
+  return wideToDec(value);
+}
 
-  if (u512_str.length() % 2 != 0) {
-    u512_str = "0" + u512_str;
-  }
+inline uint256_t u256FromDec(std::string_view dec_str) {
+  return wideFromDec<uint256_t>(dec_str);
+}
 
-  //
-  uint8_t bytes_length = u512_str.length() / 2;
-  std::string bytes_length_str = integerToHex<uint8_t>(bytes_length);
+inline void to_json(nlohmann::json& j, const uint256_t& p) { j = u256ToDec(p); }
 
-  // std::cout << "u512_str: " << u512_str << std::endl;
-  reverseHex(u512_str);
+inline void from_json(const nlohmann::json& j, uint256_t& p) {
+  p = u256FromDec(j.get_ref<const std::string&>());
+}
 
-  // this string includes the length of the string and its hex representation
-  std::string encoded_u512_str = bytes_length_str + u512_str;
+inline uint512_t u512FromHex(std::string_view hex_str) {
+  return wideFromHex<uint512_t>(hex_str);
+}
 
-  return encoded_u512_str;
+inline std::string u512ToHex(const uint512_t& value) {
+  return wideToHex(value);
 }
 
-inline std::string u512ToDec(uint512_t value) {
-  std::stringstream ss;
-  ss << value;
-  std::string u512_str;
-  u512_str = ss.str();
-  return u512_str;
+inline std::string u512ToDec(const uint512_t& value) {
+  return wideToDec(value);
 }
 
-inline uint512_t u512FromDec(std::string dec_str) {
-  return uint512_t(dec_str.c_str());
+inline uint512_t u512FromDec(std::string_view dec_str) {
+  return wideFromDec<uint512_t>(dec_str);
 }
 
 inline void to_json(nlohmann::json& j, const uint512_t& p) { j = u512ToDec(p); }
 
 inline void from_json(const nlohmann::json& j, uint512_t& p) {
-  p = u512FromDec(j.get<std::string>());
+  p = u512FromDec(j.get_ref<const std::string&>());
 }
 
 }  // namespace Casper
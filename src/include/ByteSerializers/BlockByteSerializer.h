@@ -0,0 +1,91 @@
+#pragma once
+
+#include "ByteSerializers/BaseByteSerializer.h"
+#include "Types/Block.h"
+#include "Utils/StringUtil.h"
+
+namespace Casper {
+struct BlockByteSerializer : public BaseByteSerializer {
+  CBytes ToBytes(const EraEnd& source) {
+    CBytes bytes;
+
+    // the maps are already sorted by public key in the node's JSON output
+    WriteInteger(bytes, source.era_report.equivocators.size());
+    for (auto& equivocator : source.era_report.equivocators) {
+      WriteBytes(bytes, equivocator.GetBytes());
+    }
+
+    WriteInteger(bytes, source.era_report.rewards.size());
+    for (auto& reward : source.era_report.rewards) {
+      WriteBytes(bytes, reward.validator.GetBytes());
+      WriteULong(bytes, reward.amount);
+    }
+
+    WriteInteger(bytes, source.era_report.inactive_validators.size());
+    for (auto& inactive_validator : source.era_report.inactive_validators) {
+      WriteBytes(bytes, inactive_validator.GetBytes());
+    }
+
+    WriteInteger(bytes, source.next_era_validator_weights.size());
+    for (auto& validator_weight : source.next_era_validator_weights) {
+      WriteBytes(bytes, validator_weight.public_key.GetBytes());
+      WriteBytes(bytes, wideToBytes(validator_weight.weight));
+    }
+
+    return bytes;
+  }
+
+  CBytes ToBytes(const BlockHeader& source) {
+    CBytes bytes;
+
+    WriteBytes(bytes, hexDecode(source.parent_hash));
+    WriteBytes(bytes, hexDecode(source.state_root_hash));
+    WriteBytes(bytes, hexDecode(source.body_hash));
+    WriteByte(bytes, source.random_bit ? 1 : 0);
+    WriteBytes(bytes, hexDecode(source.accumulated_seed));
+
+    if (source.era_end.has_value()) {
+      WriteByte(bytes, 1);
+      WriteBytes(bytes, ToBytes(source.era_end.value()));
+    } else {
+      WriteByte(bytes, 0);
+    }
+
+    WriteULong(bytes, strToTimestamp(source.timestamp));
+    WriteULong(bytes, source.era_id);
+    WriteULong(bytes, source.height);
+
+    // protocol version: major, minor and patch as u32
+    std::vector<std::string> version_parts =
+        StringUtil::splitString(source.protocol_version, ".");
+    if (version_parts.size() != 3) {
+      throw std::invalid_argument("Invalid protocol version: " +
+                                  source.protocol_version);
+    }
+    for (auto& part : version_parts) {
+      WriteUInteger(bytes, std::stoul(part));
+    }
+
+    return bytes;
+  }
+
+  CBytes ToBytes(const BlockBody& source) {
+    CBytes bytes;
+
+    WriteBytes(bytes, source.proposer.GetBytes());
+
+    WriteInteger(bytes, source.deploy_hashes.size());
+    for (auto& deploy_hash : source.deploy_hashes) {
+      WriteBytes(bytes, hexDecode(deploy_hash));
+    }
+
+    WriteInteger(bytes, source.transfer_hashes.size());
+    for (auto& transfer_hash : source.transfer_hashes) {
+      WriteBytes(bytes, hexDecode(transfer_hash));
+    }
+
+    return bytes;
+  }
+};
+
+}  // namespace Casper
@@ -1,11 +1,12 @@
 #pragma once
 #include "ByteSerializers/BaseByteSerializer.h"
 #include "Types/CLValue.h"
+#include "Utils/Log.h"
 
 namespace Casper {
 struct CLValueByteSerializer : public BaseByteSerializer {
   ///
-  CBytes ToBytes(CLValue source) {
+  CBytes ToBytes(const CLValue& source) {
     // ByteQueue byte_queue;
     CBytes bytes;
     // serialize data length (4 bytes)
@@ -35,14 +36,11 @@ struct CLValueByteSerializer : public BaseByteSerializer {
     return bytes;
   }
 
-  void CLTypeToBytes(CBytes& sb, CLType innerType, CLTypeParsedRVA parsed) {
+  void CLTypeToBytes(CBytes& sb, const CLType& innerType,
+                     const CLTypeParsedRVA& parsed) {
     // std::cout << "CLTypeToBytes1: " << std::endl;
     int type_idx = innerType.type.index();
-    std::cout << "CLTypeToBytes idx: " << type_idx << std::endl;
-
-    nlohmann::json j;
-    to_json(j, innerType);
-    // std::cout << "CLTypeToBytes json: " << j.dump(2) << std::endl;
+    CASPER_LOG_TRACE("CLTypeToBytes idx: " << type_idx);
 
     if (type_idx == 0) {
       CLTypeEnum type = std::get<CLTypeEnum>(innerType.type);
@@ -51,13 +49,13 @@ struct CLValueByteSerializer : public BaseByteSerializer {
       throw std::runtime_error("CLTypeToBytes: type_idx = 1 not implemented");
     } else if (type_idx == 2) {
       WriteByte(sb, 17);
-      std::map<CLTypeRVA, CLTypeRVA> mp =
+      const auto& mp =
           std::get<std::map<CLTypeRVA, CLTypeRVA>>(innerType.type);
       if (parsed.index() == 16) {
         CLTypeToBytes(sb, mp.begin()->first, parsed);
         CLTypeToBytes(sb, mp.begin()->second, parsed);
       } else {
-        std::map<CLTypeParsedRVA, CLTypeParsedRVA> mp2 =
+        const auto& mp2 =
             std::get<std::map<CLTypeParsedRVA, CLTypeParsedRVA>>(parsed);
 
         CLTypeToBytes(sb, mp.begin()->first, mp2.begin()->first);
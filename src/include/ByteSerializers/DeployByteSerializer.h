@@ -3,27 +3,17 @@
 #include "ByteSerializers/DeployApprovalByteSerializer.h"
 #include "ByteSerializers/ExecutableDeployItemByteSerializer.h"
 #include "Types/Deploy.h"
-#include "date/date.h"
-#include <chrono>
+#include "Utils/Tracing.h"
 namespace Casper {
 struct DeployByteSerializer : public BaseByteSerializer {
-  CBytes ToBytes(DeployHeader source) {
+  CBytes ToBytes(const DeployHeader& source) {
+    TraceSpan span(SpanKind::Serialize,
+                   "DeployByteSerializer::ToBytes(DeployHeader)");
     CBytes bytes;
 
     WriteBytes(bytes, source.account.GetBytes());
-    // std::cout << "acc:" << hexEncode(source.account.GetBytes()) << std::endl;
-    //  replace with source.timestamp
-    /*
-    std::chrono::milliseconds timestmp =
-        std::chrono::duration_cast<std::chrono::milliseconds>(
-            std::chrono::system_clock::now().time_since_epoch());
-*/
-    uint64_t ttp = strToTimestamp(source.timestamp);
-    WriteULong(bytes, ttp);
-    // std::cout << "Timestamp " << ttp << std::endl;
-    // std::cout << "after Timestamp:" << hexEncode(bytes) << std::endl;
-    //  TODO: Create date util, use it with source.ttl
-    WriteULong(bytes, 1800000);
+    WriteULong(bytes, source.timestamp.milliseconds);
+    WriteULong(bytes, source.ttl.milliseconds);
     // std::cout << "after ttl:" << hexEncode(bytes) << std::endl;
     WriteULong(bytes, source.gas_price);
     // std::cout << "after gas price:" << hexEncode(bytes) << std::endl;
@@ -41,7 +31,9 @@ struct DeployByteSerializer : public BaseByteSerializer {
     return bytes;
   }
 
-  CBytes ToBytes(Deploy source) {
+  CBytes ToBytes(const Deploy& source) {
+    TraceSpan span(SpanKind::Serialize,
+                   "DeployByteSerializer::ToBytes(Deploy)");
     CBytes bytes;
 
     ExecutableDeployItemByteSerializer itemSerializer;
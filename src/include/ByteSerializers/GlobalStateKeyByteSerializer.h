@@ -12,9 +12,8 @@ struct GlobalStateKeyByteSerializer : public BaseByteSerializer {
 
     WriteBytes(bytes, source.raw_bytes);
 
-    if (source.ToString().find("uref-") != std::string::npos) {
-      URef uref(source.ToString());
-      WriteByte(bytes, (CryptoPP::byte)uref.access_rights);
+    if (source.key_identifier == KeyIdentifier::URef) {
+      WriteByte(bytes, (CryptoPP::byte)source.access_rights);
     }
 
     return bytes;
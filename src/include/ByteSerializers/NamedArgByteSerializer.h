@@ -6,7 +6,7 @@
 #include "Utils/StringUtil.h"
 namespace Casper {
 struct NamedArgByteSerializer : public BaseByteSerializer {
-  CBytes ToBytes(NamedArg source) {
+  CBytes ToBytes(const NamedArg& source) {
     CBytes bytes;
     // std::cout << "NamedArgByteSerializer: " << std::endl;
     CBytes bName =
@@ -1,10 +1,19 @@
 #pragma once
 
+#include <atomic>
+#include <deque>
 #include <filesystem>
+#include <map>
+#include <mutex>
 #include <string>
 
 // http connection
+#include "JsonRpc/Connection/EventLoopConnector.h"
 #include "JsonRpc/Connection/HttpLibConnector.h"
+#include "JsonRpc/Connection/LoopbackConnector.h"
+#include "JsonRpc/Connection/RecordReplayConnector.h"
+#include "JsonRpc/Connection/MultiNodeConnector.h"
+#include "JsonRpc/RequestTemplate.h"
 
 // json rpc result types
 #include "JsonRpc/ResultTypes/GetAuctionInfoResult.h"
@@ -28,9 +37,14 @@
 #include "Types/URef.h"
 
 // Utils
+#include "Utils/CallContext.h"
 #include "Utils/CryptoUtil.h"
+#include "Utils/Log.h"
+#include "Utils/Metrics.h"
+#include "Utils/Tracing.h"
 
 // external libraries
+#include "jsonrpccxx/batchclient.hpp"
 #include "jsonrpccxx/client.hpp"
 #include "magic_enum/magic_enum.hpp"
 #include "nlohmann/json.hpp"
@@ -39,11 +53,127 @@
 #define CASPER_TEST_ADDRESS "http://138.201.54.44:7777"
 
 namespace Casper {
+/**
+ * @brief Client of the JSON-RPC API of Casper nodes. The calls can be bounded
+ * by a deadline and cancelled with a CallScope around them.
+ *
+ */
 class Client {
  private:
   std::string mAddress;
-  HttpLibConnector mHttpConnector;
-  jsonrpccxx::JsonRpcClient mRpcClient;
+  MultiNodeConnector mHttpConnector;
+
+  /// Dictionary items fetched by key, indexed by state root hash and key.
+  /// The oldest items are evicted first when the cache is full.
+  std::map<std::pair<std::string, std::string>, GetDictionaryItemResult>
+      mDictionaryItemCache;
+  std::deque<std::pair<std::string, std::string>> mDictionaryItemCacheOrder;
+  std::mutex mDictionaryItemCacheMutex;
+
+  /// Cleared when the node answers a JSON-RPC batch request with "method not
+  /// found" or "invalid request".
+  std::atomic<bool> mBatchSupported = true;
+
+  /// Id of the next request, unique so that the responses can be checked
+  /// against their requests.
+  std::atomic<uint64_t> mNextRequestId = 1;
+
+  MetricsRegistry mMetrics;
+
+  /// Sends the request of a RequestTemplate with the given values and
+  /// returns its result, with the error handling of
+  /// jsonrpccxx::JsonRpcClient. The response must have the id of the
+  /// request.
+  template <typename T, typename... Values>
+  T Call(const RequestTemplate& request_template, const Values&... values) {
+    uint64_t id = mNextRequestId++;
+    return Send(
+        request_template.GetMethod(), request_template.Render(id, values...),
+        [id](const nlohmann::json& response) {
+          auto error = response.find("error");
+          if (error != response.end()) {
+            if (error->is_object()) {
+              throw jsonrpccxx::JsonRpcException::fromJson(*error);
+            } else if (error->is_string()) {
+              throw jsonrpccxx::JsonRpcException(jsonrpccxx::internal_error,
+                                                 error->get<std::string>());
+            }
+          }
+
+          auto result = response.find("result");
+          auto response_id = response.find("id");
+          if (result == response.end() || response_id == response.end()) {
+            throw jsonrpccxx::JsonRpcException(
+                jsonrpccxx::internal_error,
+                R"(invalid server response: neither "result" nor "error" fields found)");
+          }
+          if (*response_id != id) {
+            throw jsonrpccxx::JsonRpcException(
+                jsonrpccxx::internal_error,
+                "invalid server response: id " + response_id->dump() +
+                    " does not match the request id " + std::to_string(id));
+          }
+          return result->get<T>();
+        });
+  }
+
+  /// Sends a request to the nodes, parses its JSON response and returns the
+  /// value decoded from it. The phases of the call are measured and traced
+  /// under the method, and its errors are counted by code.
+  template <typename Decode>
+  auto Send(const std::string& method, const std::string& request,
+            Decode decode) {
+    TraceSpan span(SpanKind::Rpc, method.c_str());
+    CallMeasure measure;
+    measure.request_bytes = request.size();
+
+    auto start = std::chrono::steady_clock::now();
+    try {
+      std::string response_text = mHttpConnector.Send(request, &measure.queue);
+      auto received = std::chrono::steady_clock::now();
+      measure.network = received - start - measure.queue;
+      measure.response_bytes = response_text.size();
+
+      std::optional<TraceSpan> decode_span;
+      decode_span.emplace(SpanKind::Decode, method.c_str());
+      nlohmann::json response;
+      try {
+        response = nlohmann::json::parse(response_text);
+      } catch (nlohmann::json::parse_error& e) {
+        throw jsonrpccxx::JsonRpcException(
+            jsonrpccxx::parse_error,
+            std::string("invalid JSON response from server: ") + e.what());
+      }
+      auto parsed = std::chrono::steady_clock::now();
+      measure.parse = parsed - received;
+
+      auto value = decode(response);
+      decode_span.reset();
+      measure.from_json = std::chrono::steady_clock::now() - parsed;
+
+      mMetrics.Record(method, measure);
+      return value;
+    } catch (jsonrpccxx::JsonRpcException& e) {
+      RecordFailure(method, measure, start, e.Code());
+      throw;
+    } catch (...) {
+      RecordFailure(method, measure, start, jsonrpccxx::internal_error);
+      throw;
+    }
+  }
+
+  /// Records a failed call with its error code.
+  void RecordFailure(const std::string& method, CallMeasure& measure,
+                     std::chrono::steady_clock::time_point start,
+                     int error_code) {
+    measure.error_code = error_code;
+    if (measure.response_bytes == 0) {
+      // the call failed before a response
+      measure.network =
+          std::chrono::steady_clock::now() - start - measure.queue;
+    }
+    mMetrics.Record(method, measure);
+  }
 
  public:
   /**
@@ -54,6 +184,93 @@ class Client {
    */
   Client(const std::string& address);
 
+  /**
+   * @brief Construct a new Casper Client object that spreads the calls over
+   * several nodes. Each call goes to the healthy node with the lowest latency
+   * and fails over to the other nodes when a node cannot be reached.
+   *
+   * @param addresses URLs of the nodes like 'http://127.0.0.1:7777'.
+   * @param transport_factory creates the transport to each node, like an
+   * EventLoopConnector. HttpLibConnector by default.
+   */
+  explicit Client(const std::vector<std::string>& addresses,
+                  const TransportFactory& transport_factory =
+                      MultiNodeConnector::DefaultTransportFactory);
+
+  /**
+   * @brief Calls "info_get_status" on every node to update their tip heights.
+   * Nodes lagging behind the others are avoided until they catch up. Call it
+   * periodically to see lagging nodes catch up.
+   */
+  void RefreshNodeStatus();
+
+  /**
+   * @brief Returns the latency, error rate, tip height and health of every
+   * node.
+   */
+  std::vector<NodeStats> GetNodeStats() const;
+
+  /**
+   * @brief Sets the connect, read and write timeouts of the calls. A
+   * CallScope with an earlier deadline shortens them for its calls.
+   */
+  void SetTimeouts(std::chrono::milliseconds connect_timeout,
+                   std::chrono::milliseconds read_timeout,
+                   std::chrono::milliseconds write_timeout);
+
+  /**
+   * @brief Asks the nodes for gzip or deflate compressed responses, which
+   * makes large responses like blocks, deploys and auction info several times
+   * smaller on the wire. Off by default.
+   */
+  void SetCompression(bool on);
+
+  /**
+   * @brief Limits the rate of the calls to each node, to stay under the rate
+   * limit of the nodes. The calls waiting for the limit are sent by priority,
+   * set with CallOptions::WithPriority: interactive calls first, bulk calls
+   * last. PutDeploy is interactive by default.
+   *
+   * @param calls_per_second Rate of the calls to a node, 0 for no limit.
+   * @param burst Number of calls sent at once after an idle period.
+   */
+  void SetRateLimit(double calls_per_second, double burst = 1);
+
+  /**
+   * @brief Sets the time for the error rate of a node to halve while no call
+   * fails, 10 seconds by default. A node failing too often is avoided until
+   * its error rate decayed, then tried again.
+   */
+  void SetErrorRateHalfLife(std::chrono::milliseconds half_life);
+
+  /**
+   * @brief Returns the metrics of the calls, per method: call and error
+   * counts, request and response bytes, and latency histograms of the
+   * queueing, network, JSON parse and from_json phases.
+   */
+  std::map<std::string, MethodMetricsSnapshot> GetMetrics() const;
+
+  /**
+   * @brief Returns the metrics of the calls in the Prometheus text format.
+   */
+  std::string ExportMetrics() const;
+
+  /**
+   * @brief Enables hedged read calls: when a node does not answer a read call
+   * within the policy's delay, the call is sent to a second node as well and
+   * the first answer is returned. Needs a transport completing the requests
+   * in the background, like the EventLoopConnector.
+   *
+   * @param policy Hedging policy, with the delay and the budget of
+   * duplicates.
+   */
+  void SetHedgingPolicy(const HedgingPolicy& policy);
+
+  /**
+   * @brief Returns the number of duplicate calls sent by the hedging policy.
+   */
+  uint64_t GetHedgedCallCount() const;
+
   /**
    * @brief Get a list of the nodes.
    *
@@ -208,6 +425,40 @@ class Client {
       std::string stateRootHash, std::string seedURef,
       std::string dictionaryItemKey);
 
+  /**
+   * @brief Get the Dictionary Items stored under locally derived dictionary
+   * keys. Results are cached per state root hash, the missing items are
+   * requested from the node in a single JSON-RPC batch if it supports it.
+   *
+   * @param stateRootHash The hash of the state root.
+   * @param dictionaryKeys The dictionary keys of the items, see
+   * DictionaryKey::FromSeedURef.
+   * @return std::vector<GetDictionaryItemResult> with one result per key, in
+   * the same order.
+   */
+  std::vector<GetDictionaryItemResult> GetDictionaryItems(
+      std::string stateRootHash,
+      const std::vector<DictionaryKey>& dictionaryKeys);
+
+  /**
+   * @brief Get several Dictionary Items by the seed URef of the dictionary.
+   * The item addresses are derived locally instead of by the node.
+   *
+   * @param stateRootHash The hash of the state root.
+   * @param seedURef The seed URef of the dictionary.
+   * @param dictionaryItemKeys The dictionary item keys to get the values of.
+   * @return std::vector<GetDictionaryItemResult> with one result per item key,
+   * in the same order.
+   */
+  std::vector<GetDictionaryItemResult> GetDictionaryItemsByURef(
+      std::string stateRootHash, std::string seedURef,
+      const std::vector<std::string>& dictionaryItemKeys);
+
+  /**
+   * @brief Drops the dictionary items cached by GetDictionaryItems.
+   */
+  void ClearDictionaryItemCache();
+
   /**
    * @brief Returns the balance of the account.
    * @param purseURef The purse URef of the account as a string.
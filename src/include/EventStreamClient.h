@@ -0,0 +1,153 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+
+#include "JsonRpc/Connection/httplib.h"
+#include "Types/Event.h"
+#include "Utils/BoundedQueue.h"
+
+namespace Casper {
+/// Event stream of blocks, deploys and steps.
+constexpr const char* EVENTS_MAIN_PATH = "/events/main";
+/// Event stream of finality signatures.
+constexpr const char* EVENTS_SIGS_PATH = "/events/sigs";
+/// Event stream of accepted deploys.
+constexpr const char* EVENTS_DEPLOYS_PATH = "/events/deploys";
+
+/**
+ * @brief Incremental parser of a "text/event-stream" body. The body can be fed
+ * in chunks of any size, the callback is called for every complete message
+ * with its data and its id if there is one.
+ */
+class EventStreamParser {
+ public:
+  using MessageCallback = std::function<bool(
+      const std::string& data, const std::optional<uint64_t>& id)>;
+
+  explicit EventStreamParser(MessageCallback callback)
+      : mCallback(std::move(callback)) {}
+
+  /**
+   * @brief Parses a chunk of the stream.
+   *
+   * @return false if the callback asked to stop.
+   */
+  bool Feed(const char* data, size_t length);
+
+ private:
+  bool ParseLine(const std::string& line);
+
+  MessageCallback mCallback;
+  std::string mLine;
+  std::string mData;
+  std::optional<uint64_t> mId;
+};
+
+/**
+ * @brief Subscriber of the event stream of a node. A reader thread decodes
+ * the BlockAdded, DeployProcessed and FinalitySignature events and pushes them
+ * to a bounded queue, other event kinds are skipped. When the queue is full
+ * the reader stops reading from the node until consumer threads catch up. The
+ * stream is resumed from the last received event id when the connection
+ * drops.
+ */
+class EventStreamClient {
+ public:
+  /**
+   * @brief Construct a new Event Stream Client object.
+   *
+   * @param address is a URL of the node like 'http://127.0.0.1:9999'.
+   * @param path of the event stream, EVENTS_MAIN_PATH by default.
+   * @param queue_capacity maximum number of decoded events waiting for a
+   * consumer.
+   */
+  explicit EventStreamClient(const std::string& address,
+                             const std::string& path = EVENTS_MAIN_PATH,
+                             size_t queue_capacity = 1024);
+
+  ~EventStreamClient();
+
+  /**
+   * @brief Starts the reader thread.
+   *
+   * @param start_from id of the first event to receive. Use std::nullopt to
+   * receive new events only.
+   */
+  void Start(std::optional<uint64_t> start_from = std::nullopt);
+
+  /**
+   * @brief Stops the reader thread and wakes up the consumers. Events already
+   * in the queue can still be popped.
+   */
+  void Stop();
+
+  /**
+   * @brief Waits for the next event.
+   *
+   * @return false once the client is stopped and the queue is drained.
+   */
+  bool Pop(Event& event);
+
+  /**
+   * @brief Waits at most the timeout for the next event.
+   *
+   * @return false if no event is available.
+   */
+  bool TryPop(Event& event, std::chrono::milliseconds timeout);
+
+  /**
+   * @brief Returns the id of the last event read from the stream, to resume
+   * the stream later.
+   */
+  std::optional<uint64_t> GetLastEventId() const;
+
+  /**
+   * @brief Returns the API version announced by the node, empty before the
+   * first connection.
+   */
+  std::string GetApiVersion() const;
+
+  /**
+   * @brief Sets the time to wait before reconnecting after the connection
+   * drops. Can be called while the client runs.
+   */
+  void SetReconnectDelay(std::chrono::milliseconds delay);
+
+  /**
+   * @brief Sets the time without any data after which the connection is
+   * considered dead and reopened. Can be called while the client runs, the
+   * open connection keeps its timeout.
+   */
+  void SetReadTimeout(std::chrono::seconds timeout);
+
+ private:
+  void Run(std::optional<uint64_t> start_from);
+
+  bool OnMessage(const std::string& data, const std::optional<uint64_t>& id);
+
+  std::string mAddress;
+  std::string mPath;
+  BoundedQueue<Event> mQueue;
+
+  std::thread mReader;
+  std::atomic<bool> mRunning = false;
+
+  /// The connection in use by the reader, to interrupt it on Stop().
+  httplib::Client* mConnection = nullptr;
+  mutable std::mutex mMutex;
+  std::condition_variable mStopped;
+
+  /// Guarded by mMutex, like the connection.
+  std::optional<uint64_t> mLastEventId;
+  std::string mApiVersion;
+  std::chrono::milliseconds mReconnectDelay = std::chrono::seconds(1);
+  std::chrono::seconds mReadTimeout = std::chrono::seconds(60);
+};
+
+}  // namespace Casper
@@ -0,0 +1,687 @@
+#include "JsonRpc/Connection/EventLoopConnector.h"
+
+#include <fcntl.h>
+#include <netdb.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cctype>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+
+#include "JsonRpc/Connection/httplib.h"
+#include "JsonRpc/RequestTemplate.h"
+#include "zlib.h"
+
+namespace Casper {
+
+namespace {
+/// Size of the reads from the sockets.
+constexpr const size_t READ_SIZE = 64 * 1024;
+
+#ifdef MSG_NOSIGNAL
+constexpr const int SEND_FLAGS = MSG_NOSIGNAL;
+#else
+constexpr const int SEND_FLAGS = 0;
+#endif
+
+bool SetNonBlocking(int fd) {
+  int flags = fcntl(fd, F_GETFL, 0);
+  return flags >= 0 && fcntl(fd, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+std::string ToLower(std::string str) {
+  std::transform(str.begin(), str.end(), str.begin(),
+                 [](unsigned char c) { return std::tolower(c); });
+  return str;
+}
+
+std::exception_ptr MakeError(int code, const std::string& message) {
+  return std::make_exception_ptr(jsonrpccxx::JsonRpcException(code, message));
+}
+
+/// Inflates a gzip or zlib compressed body in place. Returns false if the
+/// body is not valid compressed data.
+bool Inflate(std::string& body) {
+  z_stream stream{};
+  // 32 detects the gzip or the zlib header, like httplib
+  if (inflateInit2(&stream, 32 + 15) != Z_OK) return false;
+
+  std::string inflated;
+  char buffer[READ_SIZE];
+  stream.next_in = reinterpret_cast<Bytef*>(body.data());
+  stream.avail_in = static_cast<uInt>(body.size());
+  int result = Z_OK;
+  while (result == Z_OK) {
+    stream.next_out = reinterpret_cast<Bytef*>(buffer);
+    stream.avail_out = sizeof(buffer);
+    result = inflate(&stream, Z_NO_FLUSH);
+    inflated.append(buffer, sizeof(buffer) - stream.avail_out);
+  }
+  inflateEnd(&stream);
+
+  if (result != Z_STREAM_END) return false;
+  body = std::move(inflated);
+  return true;
+}
+
+/// Returns the JSON text of the "id" member of a JSON object, or an empty
+/// string.
+std::string FindJsonId(const std::string& json) {
+  size_t position, size;
+  if (!RequestTemplate::FindId(json, position, size)) return "";
+  return json.substr(position, size);
+}
+}  // namespace
+
+/// ResponseParser
+
+EventLoopConnector::ResponseParser::Result
+EventLoopConnector::ResponseParser::Parse(const std::string& input, bool eof) {
+  if (!head_done) {
+    size_t head_end = input.find("\r\n\r\n");
+    if (head_end == std::string::npos) {
+      return eof ? Result::Invalid : Result::Incomplete;
+    }
+
+    // status line, like "HTTP/1.1 200 OK"
+    size_t line_end = input.find("\r\n");
+    std::string status_line = input.substr(0, line_end);
+    size_t space = status_line.find(' ');
+    if (status_line.compare(0, 5, "HTTP/") != 0 ||
+        space == std::string::npos) {
+      return Result::Invalid;
+    }
+    status = std::atoi(status_line.c_str() + space + 1);
+    close = status_line.compare(0, 8, "HTTP/1.0") == 0;
+
+    size_t line_start = line_end + 2;
+    while (line_start < head_end) {
+      line_end = input.find("\r\n", line_start);
+      size_t colon = input.find(':', line_start);
+      if (colon != std::string::npos && colon < line_end) {
+        std::string name =
+            ToLower(input.substr(line_start, colon - line_start));
+        size_t value_start =
+            std::min(input.find_first_not_of(' ', colon + 1), line_end);
+        std::string value =
+            ToLower(input.substr(value_start, line_end - value_start));
+
+        if (name == "content-length") {
+          try {
+            content_length = std::stoull(value);
+          } catch (std::exception&) {
+            return Result::Invalid;
+          }
+        } else if (name == "transfer-encoding") {
+          chunked = value.find("chunked") != std::string::npos;
+        } else if (name == "connection") {
+          close = value.find("close") != std::string::npos;
+        } else if (name == "content-encoding") {
+          content_encoding = value;
+        }
+      }
+      line_start = line_end + 2;
+    }
+
+    head_done = true;
+    position = head_end + 4;
+  }
+
+  if (chunked) return ParseChunks(input);
+
+  if (content_length.has_value()) {
+    if (input.size() < position + content_length.value()) {
+      return eof ? Result::Invalid : Result::Incomplete;
+    }
+    body.assign(input, position, content_length.value());
+    consumed = position + content_length.value();
+    return Decode();
+  }
+
+  // the body ends with the connection
+  if (!eof) return Result::Incomplete;
+  body.assign(input, position, std::string::npos);
+  consumed = input.size();
+  close = true;
+  return Decode();
+}
+
+EventLoopConnector::ResponseParser::Result
+EventLoopConnector::ResponseParser::Decode() {
+  if (content_encoding.empty() || content_encoding == "identity") {
+    return Result::Complete;
+  }
+  if ((content_encoding == "gzip" || content_encoding == "deflate") &&
+      Inflate(body)) {
+    return Result::Complete;
+  }
+  return Result::Invalid;
+}
+
+EventLoopConnector::ResponseParser::Result
+EventLoopConnector::ResponseParser::ParseChunks(const std::string& input) {
+  // the chunks are decoded as they arrive, position is the next chunk
+  while (true) {
+    size_t line_end = input.find("\r\n", position);
+    if (line_end == std::string::npos) return Result::Incomplete;
+
+    size_t size = 0;
+    try {
+      size = std::stoull(input.substr(position, line_end - position),
+                         nullptr, 16);
+    } catch (std::exception&) {
+      return Result::Invalid;
+    }
+
+    if (size == 0) {
+      // optional trailers, then an empty line
+      size_t end = input.find("\r\n", line_end + 2);
+      while (end != std::string::npos && end != line_end + 2) {
+        line_end = end;
+        end = input.find("\r\n", line_end + 2);
+      }
+      if (end == std::string::npos) return Result::Incomplete;
+      consumed = end + 2;
+      return Decode();
+    }
+
+    if (input.size() < line_end + 2 + size + 2) return Result::Incomplete;
+    body.append(input, line_end + 2, size);
+    position = line_end + 2 + size + 2;
+  }
+}
+
+void EventLoopConnector::ResponseParser::Reset() {
+  status = 0;
+  body.clear();
+  close = false;
+  consumed = 0;
+  head_done = false;
+  chunked = false;
+  content_length.reset();
+  content_encoding.clear();
+  position = 0;
+}
+
+/// EventLoopConnector
+
+EventLoopConnector::EventLoopConnector(const std::string& address,
+                                       size_t max_connections,
+                                       size_t pipeline_depth)
+    : mMaxConnections(std::max<size_t>(1, max_connections)),
+      mPipelineDepth(std::max<size_t>(1, pipeline_depth)),
+      mConnectTimeout(
+          std::chrono::seconds(CPPHTTPLIB_CONNECTION_TIMEOUT_SECOND)),
+      mReadTimeout(std::chrono::seconds(CPPHTTPLIB_READ_TIMEOUT_SECOND)),
+      mWriteTimeout(std::chrono::seconds(CPPHTTPLIB_WRITE_TIMEOUT_SECOND)) {
+  std::string host = address;
+  if (host.compare(0, 7, "http://") == 0) {
+    host = host.substr(7);
+  } else if (host.find("://") != std::string::npos) {
+    throw std::invalid_argument("Only http node addresses are supported: " +
+                                address);
+  }
+  host = host.substr(0, host.find('/'));
+
+  mHostHeader = host;
+  size_t colon = host.rfind(':');
+  if (colon != std::string::npos) {
+    mHost = host.substr(0, colon);
+    mPort = host.substr(colon + 1);
+  } else {
+    mHost = host;
+    mPort = "80";
+  }
+
+  if (pipe(mWakeFds) != 0 || !SetNonBlocking(mWakeFds[0]) ||
+      !SetNonBlocking(mWakeFds[1])) {
+    throw std::runtime_error("Cannot create the event loop.");
+  }
+
+  mConnections.resize(mMaxConnections);
+  mLoop = std::thread(&EventLoopConnector::Run, this);
+}
+
+EventLoopConnector::~EventLoopConnector() {
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mRunning = false;
+  }
+  Wake();
+  mLoop.join();
+
+  for (auto& connection : mConnections) {
+    for (auto& call : connection.calls) {
+      if (!call.callback) continue;
+      call.callback(std::string(),
+                    MakeError(TRANSPORT_ERROR, "connector destroyed"));
+    }
+    Close(connection);
+  }
+  for (auto& call : mPending) {
+    call.callback(std::string(),
+                  MakeError(TRANSPORT_ERROR, "connector destroyed"));
+  }
+
+  close(mWakeFds[0]);
+  close(mWakeFds[1]);
+}
+
+void EventLoopConnector::SendAsync(std::string request, Callback callback) {
+  Call call;
+  call.message.reserve(request.size() + 128);
+  call.message += "POST /rpc HTTP/1.1\r\nHost: ";
+  call.message += mHostHeader;
+  call.message +=
+      "\r\nContent-Type: application/json\r\nAccept: application/json";
+  if (mCompression) call.message += "\r\nAccept-Encoding: gzip, deflate";
+  call.message += "\r\nContent-Length: ";
+  call.message += std::to_string(request.size());
+  call.message += "\r\n\r\n";
+  call.message += request;
+  call.id = FindJsonId(request);
+  call.callback = std::move(callback);
+
+  const CallOptions* options = CallScope::Current();
+  if (options != nullptr) call.deadline = options->deadline;
+
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    if (mRunning) {
+      mPending.push_back(std::move(call));
+      call.callback = nullptr;
+    }
+  }
+  if (call.callback) {
+    call.callback(std::string(),
+                  MakeError(TRANSPORT_ERROR, "connector destroyed"));
+    return;
+  }
+  Wake();
+}
+
+void EventLoopConnector::SetTimeouts(std::chrono::milliseconds connect_timeout,
+                                     std::chrono::milliseconds read_timeout,
+                                     std::chrono::milliseconds write_timeout) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  mConnectTimeout = connect_timeout;
+  mReadTimeout = read_timeout;
+  mWriteTimeout = write_timeout;
+}
+
+void EventLoopConnector::SetCompression(bool on) { mCompression = on; }
+
+void EventLoopConnector::Wake() {
+  char byte = 0;
+  ssize_t ignored = write(mWakeFds[1], &byte, 1);
+  (void)ignored;
+}
+
+bool EventLoopConnector::Connect(Connection& connection) {
+  addrinfo hints;
+  std::memset(&hints, 0, sizeof(hints));
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = SOCK_STREAM;
+
+  addrinfo* result = nullptr;
+  if (getaddrinfo(mHost.c_str(), mPort.c_str(), &hints, &result) != 0) {
+    return false;
+  }
+
+  for (addrinfo* info = result; info != nullptr; info = info->ai_next) {
+    int fd = socket(info->ai_family, info->ai_socktype, info->ai_protocol);
+    if (fd < 0) continue;
+
+    int one = 1;
+    setsockopt(fd, IPPROTO_TCP, TCP_NODELAY, &one, sizeof(one));
+#ifdef SO_NOSIGPIPE
+    setsockopt(fd, SOL_SOCKET, SO_NOSIGPIPE, &one, sizeof(one));
+#endif
+    if (!SetNonBlocking(fd) ||
+        (connect(fd, info->ai_addr, info->ai_addrlen) != 0 &&
+         errno != EINPROGRESS)) {
+      close(fd);
+      continue;
+    }
+
+    connection.fd = fd;
+    connection.connected = false;
+    connection.reused = false;
+    mConnectionCount++;
+    break;
+  }
+  freeaddrinfo(result);
+  return connection.fd >= 0;
+}
+
+void EventLoopConnector::Close(Connection& connection) {
+  connection.output.clear();
+  connection.written = 0;
+  connection.input.clear();
+  connection.parser.Reset();
+
+  if (connection.fd < 0) return;
+  close(connection.fd);
+  connection.fd = -1;
+  connection.connected = false;
+  mConnectionCount--;
+}
+
+void EventLoopConnector::Fail(Connection& connection, int code,
+                              const std::string& message) {
+  // a keep-alive connection closed by the node before the response
+  bool closed_idle = connection.reused && connection.input.empty() &&
+                     code == TRANSPORT_ERROR;
+  Close(connection);
+
+  std::deque<Call> calls;
+  calls.swap(connection.calls);
+  std::deque<Call> retried;
+  for (size_t i = 0; i < calls.size(); i++) {
+    Call& call = calls[i];
+    if (!call.callback) continue;
+
+    if (i > 0 || (closed_idle && !call.retried)) {
+      if (i == 0) call.retried = true;
+      retried.push_back(std::move(call));
+    } else {
+      call.callback(std::string(), MakeError(code, message));
+    }
+  }
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  mPending.insert(mPending.begin(), std::make_move_iterator(retried.begin()),
+                  std::make_move_iterator(retried.end()));
+}
+
+void EventLoopConnector::FailAll(Connection& connection, int code,
+                                 const std::string& message) {
+  Close(connection);
+
+  std::deque<Call> calls;
+  calls.swap(connection.calls);
+  for (auto& call : calls) {
+    if (call.callback) call.callback(std::string(), MakeError(code, message));
+  }
+}
+
+bool EventLoopConnector::Complete(Connection& connection) {
+  int status = connection.parser.status;
+  const std::string& id = connection.calls.front().id;
+  if (status == 200 && !id.empty() &&
+      FindJsonId(connection.parser.body) != id) {
+    return false;
+  }
+
+  Call call = std::move(connection.calls.front());
+  connection.calls.pop_front();
+  connection.reused = true;
+
+  std::string body = std::move(connection.parser.body);
+  connection.input.erase(0, connection.parser.consumed);
+  connection.parser.Reset();
+  if (!call.callback) return true;
+
+  if (status != 200) {
+    call.callback(std::string(),
+                  MakeError(TRANSPORT_ERROR,
+                            "client connector error, received status != 200"));
+  } else {
+    call.callback(std::move(body), nullptr);
+  }
+  return true;
+}
+
+void EventLoopConnector::OnWritable(Connection& connection) {
+  if (!connection.connected) {
+    int error = 0;
+    socklen_t length = sizeof(error);
+    if (getsockopt(connection.fd, SOL_SOCKET, SO_ERROR, &error, &length) != 0 ||
+        error != 0) {
+      Fail(connection, TRANSPORT_ERROR, "cannot connect to the node");
+      return;
+    }
+    connection.connected = true;
+  }
+
+  std::string& output = connection.output;
+  while (connection.written < output.size()) {
+    ssize_t count = send(connection.fd, output.data() + connection.written,
+                         output.size() - connection.written, SEND_FLAGS);
+    if (count < 0) {
+      if (errno == EAGAIN || errno == EWOULDBLOCK) return;
+      if (errno == EINTR) continue;
+      Fail(connection, TRANSPORT_ERROR, "cannot send the request");
+      return;
+    }
+    connection.written += count;
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    connection.timeout = std::chrono::steady_clock::now() +
+                         (connection.written < output.size() ? mWriteTimeout
+                                                             : mReadTimeout);
+  }
+
+  // keeps the capacity for the next requests
+  output.clear();
+  connection.written = 0;
+}
+
+void EventLoopConnector::OnReadable(Connection& connection) {
+  bool eof = false;
+  char buffer[READ_SIZE];
+  while (true) {
+    ssize_t count = recv(connection.fd, buffer, sizeof(buffer), 0);
+    if (count > 0) {
+      connection.input.append(buffer, count);
+      continue;
+    }
+    if (count == 0) {
+      eof = true;
+    } else if (errno == EINTR) {
+      continue;
+    } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+      eof = true;
+    }
+    break;
+  }
+
+  // the responses come in the order of the requests
+  while (!connection.calls.empty()) {
+    auto result = connection.parser.Parse(connection.input, eof);
+    if (result == ResponseParser::Result::Incomplete) break;
+    if (result == ResponseParser::Result::Invalid) {
+      Fail(connection, TRANSPORT_ERROR, "invalid response from the node");
+      return;
+    }
+
+    bool close = connection.parser.close;
+    if (!Complete(connection)) {
+      if (mPipelineDepth == 1) {
+        Fail(connection, TRANSPORT_ERROR,
+             "response id does not match the request id");
+        return;
+      }
+      // the node dropped pipelined requests, or processed them without
+      // answering: they are not sent again, the next requests are sent one
+      // at a time
+      mPipelineDepth = 1;
+      FailAll(connection, TRANSPORT_ERROR,
+              "response id does not match the request id");
+      return;
+    }
+    if (close) {
+      // the calls not answered yet are sent again
+      Fail(connection, TRANSPORT_ERROR, "connection closed by the node");
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    connection.timeout = std::chrono::steady_clock::now() + mReadTimeout;
+  }
+
+  if (connection.calls.empty()) {
+    // an idle connection closed by the node, or sending unexpected data
+    if (eof || !connection.input.empty()) Close(connection);
+  } else if (eof) {
+    Fail(connection, TRANSPORT_ERROR, "connection closed by the node");
+  }
+}
+
+void EventLoopConnector::ExpireCalls(
+    std::chrono::steady_clock::time_point now) {
+  for (auto& connection : mConnections) {
+    if (connection.calls.empty()) continue;
+
+    // the responses of the calls past their deadline are dropped, the
+    // connection stays in sync
+    for (auto& call : connection.calls) {
+      if (call.callback && call.deadline.has_value() &&
+          now >= call.deadline.value()) {
+        Callback callback = std::move(call.callback);
+        call.callback = nullptr;
+        callback(std::string(), MakeError(CALL_DEADLINE_EXCEEDED,
+                                          "call deadline exceeded"));
+      }
+    }
+    if (now >= connection.timeout) {
+      Fail(connection, TRANSPORT_ERROR, "timeout of the node connection");
+    }
+  }
+
+  std::vector<Call> expired;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    for (auto it = mPending.begin(); it != mPending.end();) {
+      if (it->deadline.has_value() && now >= it->deadline.value()) {
+        expired.push_back(std::move(*it));
+        it = mPending.erase(it);
+      } else {
+        ++it;
+      }
+    }
+  }
+  for (auto& call : expired) {
+    call.callback(std::string(), MakeError(CALL_DEADLINE_EXCEEDED,
+                                           "call deadline exceeded"));
+  }
+}
+
+void EventLoopConnector::Run() {
+  std::vector<pollfd> poll_fds;
+  std::vector<Connection*> polled;
+
+  while (true) {
+    auto now = std::chrono::steady_clock::now();
+
+    // hands the waiting calls to the connections with room in their pipeline
+    for (auto& connection : mConnections) {
+      while (connection.calls.size() < mPipelineDepth) {
+        Call call;
+        std::chrono::milliseconds connect_timeout, write_timeout;
+        {
+          std::lock_guard<std::mutex> lock(mMutex);
+          if (!mRunning) return;
+          if (mPending.empty()) break;
+          call = std::move(mPending.front());
+          mPending.pop_front();
+          connect_timeout = mConnectTimeout;
+          write_timeout = mWriteTimeout;
+        }
+
+        if (connection.calls.empty()) {
+          connection.timeout =
+              now + (connection.fd < 0 ? connect_timeout : write_timeout);
+        }
+        connection.output += call.message;
+        connection.calls.push_back(std::move(call));
+
+        if (connection.fd < 0 && !Connect(connection)) {
+          Fail(connection, TRANSPORT_ERROR, "cannot connect to the node");
+          break;
+        }
+      }
+    }
+
+    std::optional<std::chrono::steady_clock::time_point> next_timeout;
+    auto earliest = [&next_timeout](std::chrono::steady_clock::time_point t) {
+      if (!next_timeout.has_value() || t < next_timeout.value()) {
+        next_timeout = t;
+      }
+    };
+
+    poll_fds.clear();
+    polled.clear();
+    poll_fds.push_back({mWakeFds[0], POLLIN, 0});
+    for (auto& connection : mConnections) {
+      if (connection.fd < 0) continue;
+
+      short events = POLLIN;
+      if (!connection.calls.empty()) {
+        if (!connection.connected ||
+            connection.written < connection.output.size()) {
+          events |= POLLOUT;
+        }
+        earliest(connection.timeout);
+        for (auto& call : connection.calls) {
+          if (call.callback && call.deadline.has_value()) {
+            earliest(call.deadline.value());
+          }
+        }
+      }
+      poll_fds.push_back({connection.fd, events, 0});
+      polled.push_back(&connection);
+    }
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      if (!mRunning) return;
+      for (auto& call : mPending) {
+        if (call.deadline.has_value()) earliest(call.deadline.value());
+      }
+    }
+
+    int timeout_ms = -1;
+    if (next_timeout.has_value()) {
+      timeout_ms = static_cast<int>(std::max<int64_t>(
+          0, std::chrono::ceil<std::chrono::milliseconds>(next_timeout.value() -
+                                                          now)
+                 .count()));
+    }
+
+    if (poll(poll_fds.data(), poll_fds.size(), timeout_ms) < 0 &&
+        errno != EINTR) {
+      continue;
+    }
+
+    if (poll_fds[0].revents & POLLIN) {
+      char buffer[64];
+      while (read(mWakeFds[0], buffer, sizeof(buffer)) > 0) {
+      }
+    }
+
+    for (size_t i = 0; i < polled.size(); i++) {
+      Connection& connection = *polled[i];
+      short revents = poll_fds[i + 1].revents;
+      if (revents == 0 || connection.fd < 0) continue;
+
+      if (!connection.calls.empty() && (revents & (POLLOUT | POLLERR)) &&
+          (!connection.connected ||
+           connection.written < connection.output.size())) {
+        OnWritable(connection);
+      }
+      if (connection.fd >= 0 && (revents & (POLLIN | POLLHUP | POLLERR))) {
+        OnReadable(connection);
+      }
+    }
+
+    ExpireCalls(std::chrono::steady_clock::now());
+  }
+}
+
+}  // namespace Casper
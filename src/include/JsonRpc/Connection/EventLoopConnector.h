@@ -0,0 +1,184 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <deque>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "JsonRpc/Connection/Transport.h"
+
+namespace Casper {
+/**
+ * @brief Transport that multiplexes the requests of every thread over a few
+ * keep-alive HTTP/1.1 connections, driven by a single event loop thread
+ * polling non-blocking sockets. Many requests can be in flight without a
+ * thread each, and the connection buffers are reused from a request to the
+ * next. Plain http only, on POSIX systems.
+ *
+ * With a pipeline depth above 1, several requests are written back to back on
+ * a connection before their responses, which the node sends in the same
+ * order. The id of each response is checked against the id of its request.
+ * The requests not answered when the node closes the connection are sent
+ * again on a new one. When a response does not match its request, the node
+ * dropped pipelined requests: pipelining is turned off and the requests in
+ * flight on the connection fail with TRANSPORT_ERROR rather than being sent
+ * again, since the node may have processed some of them.
+ *
+ */
+class EventLoopConnector : public Transport {
+ public:
+  /**
+   * @brief Construct a new Event Loop Connector object and starts its event
+   * loop.
+   *
+   * @param address URL of the node like 'http://127.0.0.1:7777'.
+   * @param max_connections Maximum number of connections to the node.
+   * @param pipeline_depth Maximum number of requests in flight on a
+   * connection. The other requests wait for a connection.
+   */
+  explicit EventLoopConnector(const std::string& address,
+                              size_t max_connections = 8,
+                              size_t pipeline_depth = 1);
+
+  /**
+   * @brief Stops the event loop. The requests not completed yet fail.
+   */
+  ~EventLoopConnector();
+
+  EventLoopConnector(const EventLoopConnector&) = delete;
+  EventLoopConnector& operator=(const EventLoopConnector&) = delete;
+
+  void SendAsync(std::string request, Callback callback) override;
+
+  void SetTimeouts(std::chrono::milliseconds connect_timeout,
+                   std::chrono::milliseconds read_timeout,
+                   std::chrono::milliseconds write_timeout) override;
+
+  /**
+   * @brief Asks the node for gzip or deflate compressed responses, inflated
+   * before they are returned.
+   */
+  void SetCompression(bool on) override;
+
+  /**
+   * @brief Returns the number of open connections to the node.
+   */
+  size_t GetConnectionCount() const { return mConnectionCount; }
+
+  /**
+   * @brief Returns the maximum number of requests in flight on a connection,
+   * 1 once pipelining is turned off.
+   */
+  size_t GetPipelineDepth() const { return mPipelineDepth; }
+
+ private:
+  struct Call {
+    /// HTTP request, head and body.
+    std::string message;
+    /// JSON text of the request id, empty for batches.
+    std::string id;
+    /// Reset once the call is completed or past its deadline. The response
+    /// of a call past its deadline is dropped.
+    Callback callback;
+    std::optional<std::chrono::steady_clock::time_point> deadline;
+    /// Set when the call is sent again after a keep-alive connection was
+    /// closed by the node.
+    bool retried = false;
+  };
+
+  /// Incremental parser of the HTTP responses.
+  struct ResponseParser {
+    enum class Result { Incomplete, Complete, Invalid };
+
+    Result Parse(const std::string& input, bool eof);
+    void Reset();
+
+    int status = 0;
+    std::string body;
+    bool close = false;
+    /// Number of bytes of the input used by the response.
+    size_t consumed = 0;
+
+   private:
+    Result ParseChunks(const std::string& input);
+    /// Inflates the complete body if it is compressed.
+    Result Decode();
+
+    bool head_done = false;
+    bool chunked = false;
+    std::optional<size_t> content_length;
+    std::string content_encoding;
+    size_t position = 0;
+  };
+
+  struct Connection {
+    int fd = -1;
+    bool connected = false;
+    /// Set once a response was received on the connection.
+    bool reused = false;
+    /// Calls in flight, in the order of their requests.
+    std::deque<Call> calls;
+    /// Requests not written yet, from the written offset.
+    std::string output;
+    size_t written = 0;
+    std::string input;
+    ResponseParser parser;
+    /// End of the current connect, write or read phase.
+    std::chrono::steady_clock::time_point timeout;
+  };
+
+  void Run();
+  void Wake();
+
+  /// Starts the non-blocking connection to the node.
+  bool Connect(Connection& connection);
+  void Close(Connection& connection);
+
+  /// Closes the connection and fails its first call, or sends it again if
+  /// the node closed an idle keep-alive connection. The other calls were not
+  /// answered and are sent again.
+  void Fail(Connection& connection, int code, const std::string& message);
+
+  /// Closes the connection and fails all its calls.
+  void FailAll(Connection& connection, int code, const std::string& message);
+
+  /// Completes the first call of the connection with the parsed response.
+  /// Returns false, without completing it, if the response does not match
+  /// the request.
+  bool Complete(Connection& connection);
+
+  void OnWritable(Connection& connection);
+  void OnReadable(Connection& connection);
+
+  /// Fails the calls past their deadline or their phase timeout.
+  void ExpireCalls(std::chrono::steady_clock::time_point now);
+
+  std::string mHost;
+  std::string mPort;
+  std::string mHostHeader;
+  size_t mMaxConnections;
+  std::atomic<size_t> mPipelineDepth;
+
+  std::mutex mMutex;
+  std::deque<Call> mPending;
+  bool mRunning = true;
+  std::chrono::milliseconds mConnectTimeout;
+  std::chrono::milliseconds mReadTimeout;
+  std::chrono::milliseconds mWriteTimeout;
+  std::atomic<bool> mCompression = false;
+
+  /// Self-pipe waking the event loop up.
+  int mWakeFds[2] = {-1, -1};
+
+  /// Owned by the event loop thread.
+  std::vector<Connection> mConnections;
+  std::atomic<size_t> mConnectionCount = 0;
+
+  std::thread mLoop;
+};
+
+}  // namespace Casper
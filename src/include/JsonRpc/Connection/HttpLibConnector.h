@@ -1,8 +1,11 @@
 #pragma once
+#include <chrono>
+#include <mutex>
 #include <string>
 
+#include "JsonRpc/Connection/Transport.h"
 #include "JsonRpc/Connection/httplib.h"
-#include "jsonrpccxx/iclientconnector.hpp"
+#include "Utils/CallContext.h"
 #include "jsonrpccxx/server.hpp"
 
 /**
@@ -10,7 +13,7 @@
  *
  */
 namespace Casper {
-class HttpLibConnector : public jsonrpccxx::IClientConnector {
+class HttpLibConnector : public Transport {
  public:
   /**
    * @brief Construct a new Http Lib Connector object. Explicit to prevent
@@ -21,23 +24,104 @@ class HttpLibConnector : public jsonrpccxx::IClientConnector {
   explicit HttpLibConnector(const std::string& host)
       : httpClient(host.c_str()) {}
 
+  /**
+   * @brief Sets the connect, read and write timeouts used when the call has
+   * no deadline, or a later one.
+   */
+  void SetTimeouts(std::chrono::milliseconds connect_timeout,
+                   std::chrono::milliseconds read_timeout,
+                   std::chrono::milliseconds write_timeout) override {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mConnectTimeout = connect_timeout;
+    mReadTimeout = read_timeout;
+    mWriteTimeout = write_timeout;
+  }
+
+  /**
+   * @brief Asks the node for gzip or deflate compressed responses. The
+   * responses are decompressed while they are received.
+   */
+  void SetCompression(bool on) override {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCompression = on;
+  }
+
   /**
    * @brief Send the request to the server via the Http Client Connection class.
+   * The deadline and the cancellation token of the current CallScope bound
+   * the call.
    *
    * @param request
    * @return std::string
    */
   std::string Send(const std::string& request) override {
-    auto res = httpClient.Post("/rpc", request, "application/json");
+    // httplib sends the requests of a client one at a time, the timeouts are
+    // set for each of them
+    std::lock_guard<std::mutex> lock(mMutex);
+    CallScope::ThrowIfDone();
+
+    std::optional<std::chrono::milliseconds> remaining =
+        CallScope::GetRemainingTime();
+    auto bound = [&remaining](std::chrono::milliseconds timeout) {
+      if (remaining.has_value()) {
+        timeout = std::max(std::chrono::milliseconds(1),
+                           std::min(timeout, remaining.value()));
+      }
+      return timeout;
+    };
+    httpClient.set_connection_timeout(bound(mConnectTimeout));
+    httpClient.set_read_timeout(bound(mReadTimeout));
+    httpClient.set_write_timeout(bound(mWriteTimeout));
+
+    // a cancellation interrupts the request in flight, Unregister waits for
+    // a stop in progress so that it cannot hit the next request
+    const CallOptions* options = CallScope::Current();
+    size_t registration = 0;
+    if (options != nullptr && options->cancellation.has_value()) {
+      registration =
+          options->cancellation->Register([this] { httpClient.stop(); });
+    }
+
+    httplib::Headers headers;
+    if (mCompression) headers.emplace("Accept-Encoding", "gzip, deflate");
+    auto res = httpClient.Post("/rpc", headers, request, "application/json");
+
+    if (registration != 0) options->cancellation->Unregister(registration);
+
     if (!res || res->status != 200) {
+      CallScope::ThrowIfDone();
       throw jsonrpccxx::JsonRpcException(
-          -32003, "client connector error, received status != 200");
+          TRANSPORT_ERROR, "client connector error, received status != 200");
     }
     return res->body;
   }
 
+  /**
+   * @brief httplib is blocking: the request is sent on the calling thread,
+   * which runs the callback before returning.
+   */
+  void SendAsync(std::string request, Callback callback) override {
+    std::string response;
+    try {
+      response = Send(request);
+    } catch (...) {
+      callback(std::string(), std::current_exception());
+      return;
+    }
+    callback(std::move(response), nullptr);
+  }
+
  private:
   /// httplib::Client object to send the request to the server as an RPC call.
   httplib::Client httpClient;
+
+  std::mutex mMutex;
+  bool mCompression = false;
+  std::chrono::milliseconds mConnectTimeout =
+      std::chrono::seconds(CPPHTTPLIB_CONNECTION_TIMEOUT_SECOND);
+  std::chrono::milliseconds mReadTimeout =
+      std::chrono::seconds(CPPHTTPLIB_READ_TIMEOUT_SECOND);
+  std::chrono::milliseconds mWriteTimeout =
+      std::chrono::seconds(CPPHTTPLIB_WRITE_TIMEOUT_SECOND);
 };
 }  // namespace Casper
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <functional>
+#include <string>
+
+#include "JsonRpc/Connection/Transport.h"
+
+namespace Casper {
+/**
+ * @brief In-process transport that hands the requests to a handler instead of
+ * a node, on the calling thread. Used to measure the client without the
+ * network, and in tests.
+ *
+ */
+class LoopbackConnector : public Transport {
+ public:
+  /// Returns the JSON-RPC response of a request.
+  using Handler = std::function<std::string(const std::string& request)>;
+
+  /**
+   * @brief Construct a new Loopback Connector object.
+   *
+   * @param handler called with each request.
+   */
+  explicit LoopbackConnector(Handler handler) : mHandler(std::move(handler)) {}
+
+  std::string Send(const std::string& request) override {
+    CallScope::ThrowIfDone();
+    return mHandler(request);
+  }
+
+  void SendAsync(std::string request, Callback callback) override {
+    std::string response;
+    try {
+      response = Send(request);
+    } catch (...) {
+      callback(std::string(), std::current_exception());
+      return;
+    }
+    callback(std::move(response), nullptr);
+  }
+
+ private:
+  Handler mHandler;
+};
+
+}  // namespace Casper
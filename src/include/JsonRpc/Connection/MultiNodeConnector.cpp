@@ -0,0 +1,439 @@
+#include "JsonRpc/Connection/MultiNodeConnector.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+
+#include "Utils/ThreadUtil.h"
+#include "nlohmann/json.hpp"
+
+namespace Casper {
+namespace {
+/// Weight of the last call in the moving averages.
+constexpr const double EWMA_ALPHA = 0.2;
+
+/// Nodes failing more often than this are unhealthy.
+constexpr const double MAX_ERROR_RATE = 0.5;
+
+/// Nodes more blocks than this behind the highest tip are unhealthy.
+constexpr const uint64_t MAX_TIP_LAG = 3;
+
+/// Number of recent latencies kept for the hedging delay.
+constexpr const size_t LATENCY_WINDOW = 256;
+
+/// Calls are not hedged on a percentile of fewer latencies.
+constexpr const size_t MIN_LATENCY_SAMPLES = 20;
+
+double Ewma(double average, double value) {
+  return average + EWMA_ALPHA * (value - average);
+}
+
+/// Returns the method name of a JSON-RPC request without parsing it.
+std::string GetMethodName(const std::string& request) {
+  size_t key = request.find("\"method\"");
+  if (key == std::string::npos) return "";
+
+  size_t colon = request.find(':', key);
+  size_t start = request.find('"', colon);
+  if (colon == std::string::npos || start == std::string::npos) return "";
+
+  size_t end = request.find('"', start + 1);
+  if (end == std::string::npos) return "";
+  return request.substr(start + 1, end - start - 1);
+}
+}  // namespace
+
+MultiNodeConnector::MultiNodeConnector(
+    const std::vector<std::string>& addresses,
+    const TransportFactory& transport_factory) {
+  if (addresses.empty()) {
+    throw std::invalid_argument("At least one node address is required.");
+  }
+
+  for (auto& address : addresses) {
+    mNodes.push_back(
+        std::make_unique<Node>(address, transport_factory(address)));
+  }
+}
+
+std::unique_ptr<Transport> MultiNodeConnector::DefaultTransportFactory(
+    const std::string& address) {
+  return std::make_unique<HttpLibConnector>(address);
+}
+
+MultiNodeConnector::~MultiNodeConnector() {
+  std::unique_lock<std::mutex> lock(mMutex);
+  mPendingCallsDone.wait(lock, [this] { return mPendingCallCount == 0; });
+}
+
+std::string MultiNodeConnector::Send(const std::string& request) {
+  return Send(request, nullptr);
+}
+
+std::string MultiNodeConnector::Send(const std::string& request,
+                                     std::chrono::nanoseconds* queue_time) {
+  std::vector<size_t> ranking = RankNodes();
+
+  std::optional<std::chrono::milliseconds> hedging_delay =
+      GetHedgingDelay(request);
+  if (hedging_delay.has_value()) {
+    return SendHedged(request, ranking, hedging_delay.value());
+  }
+
+  std::exception_ptr last_error;
+  for (size_t index : ranking) {
+    // no failover past the deadline of the call
+    CallScope::ThrowIfDone();
+    try {
+      return SendTo(index, request, queue_time);
+    } catch (...) {
+      last_error = std::current_exception();
+    }
+  }
+  std::rethrow_exception(last_error);
+}
+
+std::string MultiNodeConnector::SendTo(size_t index, const std::string& request,
+                                       std::chrono::nanoseconds* queue_time) {
+  Node& node = *mNodes[index];
+  auto start = BeginCall(node, queue_time);
+  try {
+    std::string response = node.connector->Send(request);
+    RecordSuccess(node, start);
+    return response;
+  } catch (...) {
+    RecordFailure(node, IsNodeError(std::current_exception()));
+    throw;
+  }
+}
+
+std::chrono::steady_clock::time_point MultiNodeConnector::BeginCall(
+    Node& node, std::chrono::nanoseconds* queue_time) {
+  // the time spent waiting for the rate limit is not latency of the node
+  auto queued = std::chrono::steady_clock::now();
+  node.rate_limiter.Acquire();
+  if (queue_time != nullptr) {
+    *queue_time += std::chrono::steady_clock::now() - queued;
+  }
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  node.stats.in_flight++;
+  node.stats.call_count++;
+  return std::chrono::steady_clock::now();
+}
+
+void MultiNodeConnector::RecordSuccess(
+    Node& node, std::chrono::steady_clock::time_point start) {
+  double latency_ms = std::chrono::duration<double, std::milli>(
+                          std::chrono::steady_clock::now() - start)
+                          .count();
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  node.stats.in_flight--;
+  node.stats.latency_ms = node.stats.latency_ms == 0
+                              ? latency_ms
+                              : Ewma(node.stats.latency_ms, latency_ms);
+  node.stats.error_rate = Ewma(node.stats.error_rate, 0);
+  UpdateHealth();
+
+  mRecentLatencies.push_back(latency_ms);
+  if (mRecentLatencies.size() > LATENCY_WINDOW) mRecentLatencies.pop_front();
+}
+
+bool MultiNodeConnector::IsNodeError(std::exception_ptr error) {
+  try {
+    std::rethrow_exception(error);
+  } catch (jsonrpccxx::JsonRpcException& e) {
+    // calls stopped by the caller do not count against the node
+    return e.Code() != CALL_DEADLINE_EXCEEDED && e.Code() != CALL_CANCELLED;
+  } catch (...) {
+    return true;
+  }
+}
+
+void MultiNodeConnector::RecordFailure(Node& node, bool node_error) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  node.stats.in_flight--;
+  if (node_error) {
+    node.stats.error_count++;
+    node.stats.error_rate = Ewma(node.stats.error_rate, 1);
+    UpdateHealth();
+  }
+}
+
+std::vector<size_t> MultiNodeConnector::RankNodes() {
+  std::lock_guard<std::mutex> lock(mMutex);
+  DecayErrorRates();
+
+  // nodes without latency yet are tried first unless they are busy, busy
+  // nodes are slower
+  double max_latency_ms = 1;
+  for (auto& node : mNodes) {
+    max_latency_ms = std::max(max_latency_ms, node->stats.latency_ms);
+  }
+
+  std::vector<std::pair<double, size_t>> scores;
+  for (size_t i = 0; i < mNodes.size(); i++) {
+    const NodeStats& stats = mNodes[i]->stats;
+    double latency_ms = stats.latency_ms;
+    if (latency_ms == 0 && stats.in_flight > 0) latency_ms = max_latency_ms;
+
+    double score = latency_ms * (stats.in_flight + 1);
+    if (!stats.healthy) score += 1e12 * (1 + stats.error_rate);
+    scores.emplace_back(score, i);
+  }
+  std::stable_sort(scores.begin(), scores.end(),
+                   [](auto& a, auto& b) { return a.first < b.first; });
+
+  std::vector<size_t> ranking;
+  for (auto& score : scores) ranking.push_back(score.second);
+  return ranking;
+}
+
+void MultiNodeConnector::UpdateHealth() {
+  uint64_t max_tip_height = 0;
+  for (auto& node : mNodes) {
+    max_tip_height =
+        std::max(max_tip_height, node->stats.tip_height.value_or(0));
+  }
+
+  for (auto& node : mNodes) {
+    NodeStats& stats = node->stats;
+    bool lagging = stats.tip_height.has_value() &&
+                   stats.tip_height.value() + MAX_TIP_LAG < max_tip_height;
+    stats.healthy = stats.error_rate <= MAX_ERROR_RATE && !lagging;
+  }
+}
+
+void MultiNodeConnector::DecayErrorRates() {
+  auto now = std::chrono::steady_clock::now();
+  for (auto& node : mNodes) {
+    double half_lives =
+        std::chrono::duration<double>(now - node->decayed_at).count() /
+        std::chrono::duration<double>(mErrorRateHalfLife).count();
+    node->stats.error_rate *= std::exp2(-half_lives);
+    node->decayed_at = now;
+  }
+  // an unhealthy node is tried again once its error rate decayed
+  UpdateHealth();
+}
+
+void MultiNodeConnector::RefreshStatus() {
+  const std::string request =
+      nlohmann::json{{"jsonrpc", "2.0"},
+                     {"id", 1},
+                     {"method", "info_get_status"},
+                     {"params", nlohmann::json::object()}}
+          .dump();
+
+  ThreadUtil::ParallelFor(mNodes.size(), mNodes.size(), [&](size_t i) {
+    std::optional<uint64_t> tip_height;
+    try {
+      nlohmann::json response = nlohmann::json::parse(SendTo(i, request));
+      const nlohmann::json& block_info =
+          response.at("result").at("last_added_block_info");
+      if (!block_info.is_null()) {
+        tip_height = block_info.at("height").get<uint64_t>();
+      }
+    } catch (std::exception& e) {
+      // the failure is already counted in the node's error rate
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mMutex);
+    mNodes[i]->stats.tip_height = tip_height;
+    UpdateHealth();
+  });
+}
+
+void MultiNodeConnector::SetTimeouts(std::chrono::milliseconds connect_timeout,
+                                     std::chrono::milliseconds read_timeout,
+                                     std::chrono::milliseconds write_timeout) {
+  for (auto& node : mNodes) {
+    node->connector->SetTimeouts(connect_timeout, read_timeout, write_timeout);
+  }
+}
+
+void MultiNodeConnector::SetCompression(bool on) {
+  for (auto& node : mNodes) node->connector->SetCompression(on);
+}
+
+void MultiNodeConnector::SetRateLimit(double calls_per_second, double burst) {
+  for (auto& node : mNodes) {
+    node->rate_limiter.SetRate(calls_per_second, burst);
+  }
+}
+
+void MultiNodeConnector::SetErrorRateHalfLife(
+    std::chrono::milliseconds half_life) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  mErrorRateHalfLife = std::max(half_life, std::chrono::milliseconds(1));
+}
+
+void MultiNodeConnector::SetHedgingPolicy(const HedgingPolicy& policy) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  mHedgingPolicy = policy;
+}
+
+uint64_t MultiNodeConnector::GetHedgedCallCount() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mHedgedCallCount;
+}
+
+std::optional<std::chrono::milliseconds> MultiNodeConnector::GetHedgingDelay(
+    const std::string& request) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (!mHedgingPolicy.enabled || mNodes.size() < 2 ||
+      mHedgingPolicy.methods.count(GetMethodName(request)) == 0) {
+    return std::nullopt;
+  }
+
+  mHedgeableCallCount++;
+  if (mHedgingPolicy.delay.count() > 0) return mHedgingPolicy.delay;
+
+  if (mRecentLatencies.size() < MIN_LATENCY_SAMPLES) return std::nullopt;
+
+  std::vector<double> latencies(mRecentLatencies.begin(),
+                                mRecentLatencies.end());
+  size_t rank = std::min(
+      latencies.size() - 1,
+      static_cast<size_t>(mHedgingPolicy.percentile * latencies.size()));
+  std::nth_element(latencies.begin(), latencies.begin() + rank,
+                   latencies.end());
+  return std::chrono::milliseconds(
+      static_cast<std::chrono::milliseconds::rep>(latencies[rank]) + 1);
+}
+
+std::string MultiNodeConnector::SendHedged(const std::string& request,
+                                           const std::vector<size_t>& ranking,
+                                           std::chrono::milliseconds delay) {
+  // shared with the callbacks of the calls, which outlive this one when
+  // their answer is ignored
+  struct HedgedCall {
+    std::mutex mutex;
+    std::condition_variable done;
+    std::optional<std::string> response;
+    std::exception_ptr error;
+    size_t failed_count = 0;
+  };
+  auto call = std::make_shared<HedgedCall>();
+
+  // the calls are handed to the transports, bounded by the CallScope of the
+  // caller, and complete on their threads or on this one
+  auto launch = [&](size_t index) {
+    Node& node = *mNodes[index];
+    auto start = BeginCall(node);
+    {
+      std::lock_guard<std::mutex> lock(mMutex);
+      mPendingCallCount++;
+    }
+
+    node.connector->SendAsync(
+        request, [this, call, &node, start](std::string&& response,
+                                            std::exception_ptr error) {
+          if (error) {
+            RecordFailure(node, IsNodeError(error));
+          } else {
+            RecordSuccess(node, start);
+          }
+
+          {
+            std::lock_guard<std::mutex> lock(call->mutex);
+            if (error) {
+              call->failed_count++;
+              call->error = error;
+            } else if (!call->response.has_value()) {
+              call->response = std::move(response);
+            }
+            call->done.notify_all();
+          }
+
+          std::lock_guard<std::mutex> lock(mMutex);
+          mPendingCallCount--;
+          mPendingCallsDone.notify_all();
+        });
+  };
+
+  // a cancellation wakes up the caller
+  const CallOptions* options = CallScope::Current();
+  size_t registration = 0;
+  if (options != nullptr && options->cancellation.has_value()) {
+    registration = options->cancellation->Register([call] {
+      std::lock_guard<std::mutex> lock(call->mutex);
+      call->done.notify_all();
+    });
+  }
+  struct Unregister {
+    const CallOptions* options;
+    size_t registration;
+    ~Unregister() {
+      if (registration != 0) options->cancellation->Unregister(registration);
+    }
+  } unregister{options, registration};
+
+  launch(ranking[0]);
+  size_t launched_count = 1;
+
+  std::unique_lock<std::mutex> lock(call->mutex);
+  auto answered = [&] {
+    return call->response.has_value() ||
+           call->failed_count == launched_count ||
+           (options != nullptr && options->cancellation.has_value() &&
+            options->cancellation->IsCancelled());
+  };
+  auto deadline = std::chrono::steady_clock::now() + delay;
+  if (options != nullptr && options->deadline.has_value()) {
+    deadline = std::min(deadline, options->deadline.value());
+  }
+
+  if (!call->done.wait_until(lock, deadline, answered) &&
+      ranking.size() > 1 &&
+      (options == nullptr || !options->deadline.has_value() ||
+       std::chrono::steady_clock::now() < options->deadline.value())) {
+    bool within_budget;
+    {
+      std::lock_guard<std::mutex> stats_lock(mMutex);
+      within_budget = mHedgedCallCount + 1 <=
+                      mHedgingPolicy.budget * mHedgeableCallCount;
+      if (within_budget) mHedgedCallCount++;
+    }
+
+    if (within_budget) {
+      lock.unlock();
+      launch(ranking[1]);
+      lock.lock();
+      launched_count++;
+    }
+  }
+
+  if (options != nullptr && options->deadline.has_value()) {
+    call->done.wait_until(lock, options->deadline.value(), answered);
+  } else {
+    call->done.wait(lock, answered);
+  }
+  if (call->response.has_value()) return call->response.value();
+  std::exception_ptr last_error = call->error;
+  lock.unlock();
+
+  // every call sent so far failed, fail over to the other nodes
+  CallScope::ThrowIfDone();
+  for (size_t i = launched_count; i < ranking.size(); i++) {
+    CallScope::ThrowIfDone();
+    try {
+      return SendTo(ranking[i], request);
+    } catch (...) {
+      last_error = std::current_exception();
+    }
+  }
+  std::rethrow_exception(last_error);
+}
+
+std::vector<NodeStats> MultiNodeConnector::GetNodeStats() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+
+  std::vector<NodeStats> stats;
+  for (auto& node : mNodes) stats.push_back(node->stats);
+  return stats;
+}
+
+}  // namespace Casper
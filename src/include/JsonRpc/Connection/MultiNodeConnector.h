@@ -0,0 +1,257 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "JsonRpc/Connection/HttpLibConnector.h"
+#include "JsonRpc/Connection/Transport.h"
+#include "Utils/RateLimiter.h"
+
+namespace Casper {
+/**
+ * @brief Health and latency statistics of a node.
+ *
+ */
+struct NodeStats {
+  /// URL of the node.
+  std::string address;
+
+  /// Exponentially weighted moving average of the successful call latencies.
+  double latency_ms = 0;
+
+  /// Exponentially weighted moving average of the failed calls, from 0 to 1.
+  /// It also decays with time, so that a node failing too often is tried
+  /// again once it stopped failing for a while.
+  double error_rate = 0;
+
+  /// Height of the last block added to the node, from its status.
+  std::optional<uint64_t> tip_height = std::nullopt;
+
+  /// Number of calls sent and not answered yet.
+  size_t in_flight = 0;
+
+  /// Total number of calls and failed calls.
+  uint64_t call_count = 0;
+  uint64_t error_count = 0;
+
+  /// False if the node fails too often or lags behind the other nodes.
+  bool healthy = true;
+};
+
+/**
+ * @brief Policy for hedged requests: when a read call is not answered after a
+ * delay, a duplicate is sent to the next best node and the first answer wins.
+ * The other answer is ignored. The calls are handed to the SendAsync of the
+ * transports, so duplicates need a transport completing the requests in the
+ * background like the EventLoopConnector. A blocking transport answers the
+ * first call before the delay.
+ *
+ */
+struct HedgingPolicy {
+  /// Hedging is opt-in.
+  bool enabled = false;
+
+  /// Delay before sending the duplicate. Use 0 to wait for the given
+  /// percentile of the recent call latencies instead.
+  std::chrono::milliseconds delay = std::chrono::milliseconds(0);
+
+  /// Percentile of the recent call latencies used as the delay.
+  double percentile = 0.95;
+
+  /// Maximum number of duplicates, as a ratio of the hedgeable calls.
+  double budget = 0.05;
+
+  /// Idempotent methods that can be sent twice.
+  std::set<std::string> methods = {"chain_get_block",
+                                   "chain_get_block_transfers",
+                                   "chain_get_era_info_by_switch_block",
+                                   "chain_get_state_root_hash",
+                                   "info_get_deploy",
+                                   "state_get_auction_info",
+                                   "state_get_balance",
+                                   "state_get_dictionary_item",
+                                   "state_get_item"};
+};
+
+/**
+ * @brief Connector that spreads the calls over several nodes. Each call is
+ * sent to the healthy node with the lowest expected latency, taking into
+ * account the calls already in flight to it, and is sent again to the next
+ * node when the node cannot be reached or answers with an HTTP error.
+ * JSON-RPC errors are answers and are not retried. The deadline and the
+ * cancellation token of the current CallScope stop the failover and the
+ * hedging. With a rate limit, the calls wait for their node's rate limiter
+ * in the order of their CallScope priority.
+ *
+ */
+class MultiNodeConnector : public jsonrpccxx::IClientConnector {
+ public:
+  /**
+   * @brief Construct a new Multi Node Connector object.
+   *
+   * @param addresses URLs of the nodes like 'http://127.0.0.1:7777'.
+   * @param transport_factory creates the transport to each node, an
+   * HttpLibConnector by default.
+   */
+  explicit MultiNodeConnector(const std::vector<std::string>& addresses,
+                              const TransportFactory& transport_factory =
+                                  DefaultTransportFactory);
+
+  /**
+   * @brief Returns an HttpLibConnector to the address.
+   */
+  static std::unique_ptr<Transport> DefaultTransportFactory(
+      const std::string& address);
+
+  /**
+   * @brief Waits for the ignored hedged calls still in flight.
+   */
+  ~MultiNodeConnector();
+
+  /**
+   * @brief Send the request to the best node, failing over to the other
+   * nodes.
+   *
+   * @param request
+   * @return std::string
+   */
+  std::string Send(const std::string& request) override;
+
+  /**
+   * @brief Send the request like Send, and adds the time spent waiting for
+   * the rate limit of the nodes to queue_time. The wait of hedged calls is
+   * not measured.
+   */
+  std::string Send(const std::string& request,
+                   std::chrono::nanoseconds* queue_time);
+
+  /**
+   * @brief Calls "info_get_status" on every node to update their tip heights
+   * and health.
+   */
+  void RefreshStatus();
+
+  /**
+   * @brief Returns a copy of the statistics of every node, in the order of
+   * the addresses.
+   */
+  std::vector<NodeStats> GetNodeStats() const;
+
+  size_t GetNodeCount() const { return mNodes.size(); }
+
+  /**
+   * @brief Sets the connect, read and write timeouts of every node, used when
+   * the call has no deadline or a later one.
+   */
+  void SetTimeouts(std::chrono::milliseconds connect_timeout,
+                   std::chrono::milliseconds read_timeout,
+                   std::chrono::milliseconds write_timeout);
+
+  /**
+   * @brief Asks every node for compressed responses.
+   */
+  void SetCompression(bool on);
+
+  /**
+   * @brief Limits the rate of the calls to each node.
+   *
+   * @param calls_per_second Rate of the calls to a node, 0 for no limit.
+   * @param burst Number of calls sent at once after an idle period.
+   */
+  void SetRateLimit(double calls_per_second, double burst = 1);
+
+  /**
+   * @brief Sets the time for the error rate of a node to halve without calls
+   * failing, 10 seconds by default.
+   */
+  void SetErrorRateHalfLife(std::chrono::milliseconds half_life);
+
+  /**
+   * @brief Sets the hedging policy of the read calls.
+   */
+  void SetHedgingPolicy(const HedgingPolicy& policy);
+
+  /**
+   * @brief Returns the number of duplicates sent by the hedging policy.
+   */
+  uint64_t GetHedgedCallCount() const;
+
+ private:
+  struct Node {
+    Node(const std::string& address, std::unique_ptr<Transport> transport)
+        : connector(std::move(transport)) {
+      stats.address = address;
+    }
+
+    std::unique_ptr<Transport> connector;
+    RateLimiter rate_limiter;
+    NodeStats stats;
+    /// Last time the error rate decayed.
+    std::chrono::steady_clock::time_point decayed_at =
+        std::chrono::steady_clock::now();
+  };
+
+  /// Returns the node indexes from the best to the worst.
+  std::vector<size_t> RankNodes();
+
+  /// Sends the request to a node and updates its statistics.
+  std::string SendTo(size_t index, const std::string& request,
+                     std::chrono::nanoseconds* queue_time = nullptr);
+
+  /// Waits for the rate limit of the node and counts the call in its
+  /// statistics. Returns the start time of the call.
+  std::chrono::steady_clock::time_point BeginCall(
+      Node& node, std::chrono::nanoseconds* queue_time = nullptr);
+
+  /// Updates the statistics of a successful call.
+  void RecordSuccess(Node& node, std::chrono::steady_clock::time_point start);
+
+  /// Updates the statistics of a failed call.
+  void RecordFailure(Node& node, bool node_error);
+
+  /// Returns false for the calls stopped by the caller, which do not count
+  /// against the node.
+  static bool IsNodeError(std::exception_ptr error);
+
+  void UpdateHealth();
+
+  /// Decays the error rates with the time elapsed since the last decay.
+  void DecayErrorRates();
+
+  /// Returns the delay before hedging the call, or std::nullopt if the call
+  /// must not be hedged.
+  std::optional<std::chrono::milliseconds> GetHedgingDelay(
+      const std::string& request);
+
+  /// Hands the request to the transport of the first node, then to the one
+  /// of the second node after the delay, and returns the first answer.
+  std::string SendHedged(const std::string& request,
+                         const std::vector<size_t>& ranking,
+                         std::chrono::milliseconds delay);
+
+  std::vector<std::unique_ptr<Node>> mNodes;
+  mutable std::mutex mMutex;
+
+  std::chrono::milliseconds mErrorRateHalfLife = std::chrono::seconds(10);
+
+  HedgingPolicy mHedgingPolicy;
+  /// Latencies of the last successful calls, for the hedging delay.
+  std::deque<double> mRecentLatencies;
+  uint64_t mHedgeableCallCount = 0;
+  uint64_t mHedgedCallCount = 0;
+
+  /// Hedged calls not completed by their transport yet, waited for on
+  /// destruction.
+  size_t mPendingCallCount = 0;
+  std::condition_variable mPendingCallsDone;
+};
+
+}  // namespace Casper
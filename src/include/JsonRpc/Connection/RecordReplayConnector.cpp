@@ -0,0 +1,250 @@
+#include "JsonRpc/Connection/RecordReplayConnector.h"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+
+#include "JsonRpc/RequestTemplate.h"
+
+namespace Casper {
+
+namespace {
+/// Size of the magic, without its terminating zero.
+constexpr const size_t MAGIC_SIZE = sizeof(RpcLogWriter::MAGIC) - 1;
+
+void WriteBytes(std::FILE* file, const void* data, size_t size) {
+  if (std::fwrite(data, 1, size, file) != size) {
+    throw std::runtime_error(std::string("Cannot write the RPC log: ") +
+                             std::strerror(errno));
+  }
+}
+
+void WriteSize(std::FILE* file, uint32_t size) {
+  uint8_t bytes[4];
+  for (int i = 0; i < 4; i++) bytes[i] = (size >> (i * 8)) & 0xff;
+  WriteBytes(file, bytes, sizeof(bytes));
+}
+
+uint32_t ReadSize(const char* data) {
+  uint32_t size = 0;
+  for (int i = 0; i < 4; i++) {
+    size |= uint32_t(static_cast<uint8_t>(data[i])) << (i * 8);
+  }
+  return size;
+}
+
+/// Returns the text of a request or a response before and after its id.
+std::pair<std::string_view, std::string_view> SplitAtId(
+    std::string_view json) {
+  size_t position, size;
+  if (!RequestTemplate::FindId(json, position, size)) return {json, {}};
+  return {json.substr(0, position), json.substr(position + size)};
+}
+
+uint64_t Fnv1a(std::string_view text, uint64_t hash) {
+  for (char c : text) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 0x100000001b3ULL;
+  }
+  return hash;
+}
+}  // namespace
+
+/// RpcLogWriter
+
+RpcLogWriter::RpcLogWriter(const std::string& path)
+    : mFile(std::fopen(path.c_str(), "wb")) {
+  if (mFile == nullptr) {
+    throw std::runtime_error("Cannot create the RPC log " + path);
+  }
+  try {
+    WriteBytes(mFile, MAGIC, MAGIC_SIZE);
+  } catch (...) {
+    std::fclose(mFile);
+    throw;
+  }
+}
+
+RpcLogWriter::~RpcLogWriter() { std::fclose(mFile); }
+
+void RpcLogWriter::Append(std::string_view request,
+                          std::string_view response) {
+  if (request.size() > UINT32_MAX || response.size() > UINT32_MAX) {
+    throw std::length_error(
+        "Cannot write the RPC log: a request or a response is 4 GiB or "
+        "larger.");
+  }
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (mFailed) {
+    throw std::runtime_error("Cannot write the RPC log after a write error.");
+  }
+  // a record written in part would be misread by the replay, the log is not
+  // written again after an error
+  mFailed = true;
+  WriteSize(mFile, uint32_t(request.size()));
+  WriteSize(mFile, uint32_t(response.size()));
+  WriteBytes(mFile, request.data(), request.size());
+  WriteBytes(mFile, response.data(), response.size());
+  mFailed = false;
+  mRecordCount++;
+}
+
+void RpcLogWriter::Flush() {
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (std::fflush(mFile) != 0) {
+    mFailed = true;
+    throw std::runtime_error(std::string("Cannot write the RPC log: ") +
+                             std::strerror(errno));
+  }
+}
+
+/// RecordingConnector
+
+TransportFactory RecordingConnector::Wrap(TransportFactory factory,
+                                          std::shared_ptr<RpcLogWriter> log) {
+  return [factory = std::move(factory),
+          log = std::move(log)](const std::string& address) {
+    return std::make_unique<RecordingConnector>(factory(address), log);
+  };
+}
+
+void RecordingConnector::SendAsync(std::string request, Callback callback) {
+  // the request is moved into the transport, a copy is kept for the log
+  auto recorded = std::make_shared<std::string>(request);
+  mTransport->SendAsync(
+      std::move(request),
+      [log = mLog, recorded, callback = std::move(callback)](
+          std::string&& response, std::exception_ptr error) {
+        // a response that cannot be recorded fails the call
+        if (!error) {
+          try {
+            log->Append(*recorded, response);
+          } catch (...) {
+            error = std::current_exception();
+          }
+        }
+        callback(std::move(response), error);
+      });
+}
+
+/// ReplayConnector
+
+ReplayConnector::ReplayConnector(const std::string& path) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) throw std::runtime_error("Cannot open the RPC log " + path);
+
+  struct stat status;
+  if (fstat(fd, &status) != 0 || size_t(status.st_size) < MAGIC_SIZE) {
+    close(fd);
+    throw std::runtime_error("Invalid RPC log " + path);
+  }
+  mSize = status.st_size;
+  void* data = mmap(nullptr, mSize, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw std::runtime_error("Cannot map the RPC log " + path);
+  }
+  mData = static_cast<const char*>(data);
+
+  if (std::memcmp(mData, RpcLogWriter::MAGIC, MAGIC_SIZE) != 0) {
+    munmap(const_cast<char*>(mData), mSize);
+    throw std::runtime_error("Invalid RPC log " + path);
+  }
+
+  // a truncated last record, from a recording that did not end, is skipped
+  size_t offset = MAGIC_SIZE;
+  while (mSize - offset >= 8) {
+    size_t request_size = ReadSize(mData + offset);
+    size_t response_size = ReadSize(mData + offset + 4);
+    if (mSize - offset - 8 < request_size + response_size) break;
+    std::string_view request(mData + offset + 8, request_size);
+    std::string_view response(request.data() + request_size, response_size);
+    mRecords.push_back({request, response});
+    offset += 8 + request_size + response_size;
+  }
+
+  // the records do not move anymore
+  for (const Record& record : mRecords) {
+    uint64_t hash = HashWithoutId(record.request);
+    Entry* entry = nullptr;
+    auto range = mEntries.equal_range(hash);
+    for (auto it = range.first; it != range.second; ++it) {
+      if (EqualWithoutId(it->second->records.front()->request,
+                         record.request)) {
+        entry = it->second.get();
+        break;
+      }
+    }
+    if (entry == nullptr) {
+      entry = mEntries.emplace(hash, std::make_unique<Entry>())
+                  ->second.get();
+    }
+    entry->records.push_back(&record);
+  }
+}
+
+ReplayConnector::~ReplayConnector() {
+  munmap(const_cast<char*>(mData), mSize);
+}
+
+std::string ReplayConnector::Send(const std::string& request) {
+  CallScope::ThrowIfDone();
+
+  const Record* record = nullptr;
+  auto range = mEntries.equal_range(HashWithoutId(request));
+  for (auto it = range.first; it != range.second; ++it) {
+    Entry& entry = *it->second;
+    if (EqualWithoutId(entry.records.front()->request, request)) {
+      record = entry.records[entry.next++ % entry.records.size()];
+      break;
+    }
+  }
+  if (record == nullptr) {
+    throw jsonrpccxx::JsonRpcException(TRANSPORT_ERROR,
+                                       "no recorded response for the request");
+  }
+
+  // the response gets the id of the request
+  size_t position, size;
+  if (!RequestTemplate::FindId(request, position, size)) {
+    return std::string(record->response);
+  }
+  auto [before, after] = SplitAtId(record->response);
+  if (after.data() == nullptr) return std::string(record->response);
+
+  std::string response;
+  response.reserve(before.size() + size + after.size());
+  response.append(before);
+  response.append(request, position, size);
+  response.append(after);
+  return response;
+}
+
+void ReplayConnector::SendAsync(std::string request, Callback callback) {
+  std::string response;
+  try {
+    response = Send(request);
+  } catch (...) {
+    callback(std::string(), std::current_exception());
+    return;
+  }
+  callback(std::move(response), nullptr);
+}
+
+uint64_t ReplayConnector::HashWithoutId(std::string_view request) {
+  auto [before, after] = SplitAtId(request);
+  return Fnv1a(after, Fnv1a(before, 0xcbf29ce484222325ULL));
+}
+
+bool ReplayConnector::EqualWithoutId(std::string_view a, std::string_view b) {
+  return SplitAtId(a) == SplitAtId(b);
+}
+
+}  // namespace Casper
@@ -0,0 +1,161 @@
+#pragma once
+
+#include <atomic>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "JsonRpc/Connection/Transport.h"
+
+namespace Casper {
+/**
+ * @brief Log of JSON-RPC request and response pairs. The file starts with an
+ * 8 bytes magic, then each pair is stored as the little-endian 32 bits sizes
+ * of the request and the response, followed by their texts.
+ *
+ */
+class RpcLogWriter {
+ public:
+  /// First bytes of a log file.
+  static constexpr const char MAGIC[] = "CSPRRPC1";
+
+  /**
+   * @brief Creates the log file, replacing an existing one.
+   */
+  explicit RpcLogWriter(const std::string& path);
+
+  /**
+   * @brief Writes the pairs not written yet and closes the file.
+   */
+  ~RpcLogWriter();
+
+  RpcLogWriter(const RpcLogWriter&) = delete;
+  RpcLogWriter& operator=(const RpcLogWriter&) = delete;
+
+  /**
+   * @brief Adds a request and its response to the log. Thread-safe. Throws
+   * std::length_error if one of them is 4 GiB or larger, and
+   * std::runtime_error if the file cannot be written, after which the log
+   * takes no more pairs.
+   */
+  void Append(std::string_view request, std::string_view response);
+
+  /**
+   * @brief Writes the pairs added so far to the file. Throws
+   * std::runtime_error if the file cannot be written.
+   */
+  void Flush();
+
+  size_t GetRecordCount() const { return mRecordCount; }
+
+ private:
+  std::mutex mMutex;
+  std::FILE* mFile;
+  std::atomic<size_t> mRecordCount = 0;
+  /// Set when a write failed.
+  bool mFailed = false;
+};
+
+/**
+ * @brief Transport recording every request and response sent through another
+ * transport, like HttpLibConnector, into a log. The failed requests are not
+ * recorded, and a response that cannot be written to the log fails its call.
+ *
+ */
+class RecordingConnector : public Transport {
+ public:
+  /**
+   * @brief Construct a new Recording Connector object.
+   *
+   * @param transport transport sending the requests.
+   * @param log log of the requests and responses, may be shared between the
+   * transports of several nodes.
+   */
+  RecordingConnector(std::unique_ptr<Transport> transport,
+                     std::shared_ptr<RpcLogWriter> log)
+      : mTransport(std::move(transport)), mLog(std::move(log)) {}
+
+  /**
+   * @brief Returns a factory of the transports of the given factory, with
+   * their requests recorded into the log.
+   */
+  static TransportFactory Wrap(TransportFactory factory,
+                               std::shared_ptr<RpcLogWriter> log);
+
+  void SendAsync(std::string request, Callback callback) override;
+
+  void SetTimeouts(std::chrono::milliseconds connect_timeout,
+                   std::chrono::milliseconds read_timeout,
+                   std::chrono::milliseconds write_timeout) override {
+    mTransport->SetTimeouts(connect_timeout, read_timeout, write_timeout);
+  }
+
+  void SetCompression(bool on) override { mTransport->SetCompression(on); }
+
+ private:
+  std::unique_ptr<Transport> mTransport;
+  std::shared_ptr<RpcLogWriter> mLog;
+};
+
+/**
+ * @brief Transport answering the requests with the responses of a log
+ * written by a RecordingConnector, without network. The log is memory-mapped
+ * and the responses are served from it.
+ *
+ * The requests are matched without their id, and the id of the request is
+ * put in the response. A request recorded several times gets its recorded
+ * responses in turn. A request not in the log fails with TRANSPORT_ERROR.
+ *
+ */
+class ReplayConnector : public Transport {
+ public:
+  /**
+   * @brief Maps the log file. Throws std::runtime_error if the file cannot
+   * be read or is not a log.
+   */
+  explicit ReplayConnector(const std::string& path);
+
+  /**
+   * @brief Unmaps the log file.
+   */
+  ~ReplayConnector();
+
+  ReplayConnector(const ReplayConnector&) = delete;
+  ReplayConnector& operator=(const ReplayConnector&) = delete;
+
+  std::string Send(const std::string& request) override;
+
+  void SendAsync(std::string request, Callback callback) override;
+
+  size_t GetRecordCount() const { return mRecords.size(); }
+
+ private:
+  struct Record {
+    std::string_view request;
+    std::string_view response;
+  };
+
+  /// Recorded requests with the same text without their id, answered in
+  /// turn.
+  struct Entry {
+    std::vector<const Record*> records;
+    std::atomic<size_t> next = 0;
+  };
+
+  /// Returns the hash of a request without its id.
+  static uint64_t HashWithoutId(std::string_view request);
+
+  /// Returns true if the requests are the same without their id.
+  static bool EqualWithoutId(std::string_view a, std::string_view b);
+
+  const char* mData = nullptr;
+  size_t mSize = 0;
+  std::vector<Record> mRecords;
+  std::unordered_multimap<uint64_t, std::unique_ptr<Entry>> mEntries;
+};
+
+}  // namespace Casper
@@ -0,0 +1,126 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+
+#include "Utils/CallContext.h"
+#include "jsonrpccxx/iclientconnector.hpp"
+
+namespace Casper {
+/// Error code of the transport failures: the node cannot be reached or
+/// answers with an HTTP error.
+constexpr const int TRANSPORT_ERROR = -32003;
+
+/**
+ * @brief Transport of the JSON-RPC requests to a node. A transport completes
+ * the requests asynchronously with SendAsync, and synchronously with Send on
+ * top of it.
+ *
+ */
+class Transport : public jsonrpccxx::IClientConnector {
+ public:
+  /// Called once per request with the response, or with the error of the
+  /// request. It may run on a thread of the transport.
+  using Callback =
+      std::function<void(std::string&& response, std::exception_ptr error)>;
+
+  virtual ~Transport() = default;
+
+  /**
+   * @brief Sends the request and calls the callback on completion. The
+   * deadline of the current CallScope bounds the request.
+   *
+   * @param request JSON-RPC request, moved into the transport.
+   * @param callback called with the response or the error.
+   */
+  virtual void SendAsync(std::string request, Callback callback) = 0;
+
+  /**
+   * @brief Sends the request and waits for the response. The deadline and the
+   * cancellation token of the current CallScope bound the wait.
+   *
+   * @param request
+   * @return std::string
+   */
+  std::string Send(const std::string& request) override {
+    struct Completion {
+      std::mutex mutex;
+      std::condition_variable done_cv;
+      bool done = false;
+      std::string response;
+      std::exception_ptr error;
+    };
+    // shared with the callback, which may run after a cancelled wait
+    auto completion = std::make_shared<Completion>();
+
+    SendAsync(request, [completion](std::string&& response,
+                                    std::exception_ptr error) {
+      std::lock_guard<std::mutex> lock(completion->mutex);
+      completion->response = std::move(response);
+      completion->error = error;
+      completion->done = true;
+      completion->done_cv.notify_all();
+    });
+
+    const CallOptions* options = CallScope::Current();
+    size_t registration = 0;
+    if (options != nullptr && options->cancellation.has_value()) {
+      registration = options->cancellation->Register([completion] {
+        std::lock_guard<std::mutex> lock(completion->mutex);
+        completion->done_cv.notify_all();
+      });
+    }
+
+    std::unique_lock<std::mutex> lock(completion->mutex);
+    auto stopped = [&options] {
+      return options != nullptr && options->cancellation.has_value() &&
+             options->cancellation->IsCancelled();
+    };
+    if (options != nullptr && options->deadline.has_value()) {
+      completion->done_cv.wait_until(lock, options->deadline.value(), [&] {
+        return completion->done || stopped();
+      });
+    } else {
+      completion->done_cv.wait(
+          lock, [&] { return completion->done || stopped(); });
+    }
+    lock.unlock();
+
+    if (registration != 0) options->cancellation->Unregister(registration);
+
+    lock.lock();
+    if (!completion->done) {
+      lock.unlock();
+      CallScope::ThrowIfDone();
+      throw jsonrpccxx::JsonRpcException(CALL_DEADLINE_EXCEEDED,
+                                         "call deadline exceeded");
+    }
+    if (completion->error) std::rethrow_exception(completion->error);
+    return std::move(completion->response);
+  }
+
+  /**
+   * @brief Sets the connect, read and write timeouts, used when the request
+   * has no deadline or a later one. Ignored by transports without network.
+   */
+  virtual void SetTimeouts(std::chrono::milliseconds /*connect_timeout*/,
+                           std::chrono::milliseconds /*read_timeout*/,
+                           std::chrono::milliseconds /*write_timeout*/) {}
+
+  /**
+   * @brief Asks for compressed responses. Ignored by the transports that do
+   * not support it.
+   */
+  virtual void SetCompression(bool /*on*/) {}
+};
+
+/// Creates the transport to the node at the given address.
+using TransportFactory =
+    std::function<std::unique_ptr<Transport>(const std::string& address)>;
+
+}  // namespace Casper
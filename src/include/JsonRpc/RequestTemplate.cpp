@@ -0,0 +1,110 @@
+#include "JsonRpc/RequestTemplate.h"
+
+namespace Casper {
+
+RequestTemplate::RequestTemplate(const std::string& method,
+                                 const std::string& params)
+    : mMethod(method) {
+  // same member order as the requests of jsonrpccxx
+  std::string method_json;
+  AppendString(method_json, method);
+  mParts.push_back("{\"id\":");
+
+  std::string rest = ",\"jsonrpc\":\"2.0\",\"method\":" + method_json;
+  if (params.empty()) {
+    mParts.push_back(rest + "}");
+  } else {
+    rest += ",\"params\":";
+    for (char c : params) {
+      if (c == '$') {
+        mParts.push_back(rest);
+        rest.clear();
+      } else {
+        rest += c;
+      }
+    }
+    mParts.push_back(rest + "}");
+  }
+
+  for (const std::string& part : mParts) mFixedSize += part.size();
+}
+
+void RequestTemplate::AppendString(std::string& out, const std::string& value) {
+  static const char HEX_DIGITS[] = "0123456789abcdef";
+
+  out += '"';
+  for (char c : value) {
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out += "\\u00";
+          out += HEX_DIGITS[(c >> 4) & 0x0f];
+          out += HEX_DIGITS[c & 0x0f];
+        } else {
+          out += c;
+        }
+    }
+  }
+  out += '"';
+}
+
+bool RequestTemplate::FindId(std::string_view json, size_t& position,
+                             size_t& size) {
+  int depth = 0;
+  bool expect_key = false;
+  for (size_t i = 0; i < json.size(); i++) {
+    char c = json[i];
+    if (c == '{' || c == '[') {
+      depth++;
+      expect_key = depth == 1 && c == '{';
+    } else if (c == '}' || c == ']') {
+      depth--;
+    } else if (c == ',') {
+      expect_key = depth == 1;
+    } else if (c == '"') {
+      size_t start = i;
+      for (i++; i < json.size() && json[i] != '"'; i++) {
+        if (json[i] == '\\') i++;
+      }
+      if (!expect_key) continue;
+      expect_key = false;
+      if (json.compare(start, i - start + 1, "\"id\"") != 0) continue;
+
+      // the value, a number, a string or null
+      size_t value_start = json.find_first_not_of(" \t\r\n:", i + 1);
+      if (value_start == std::string_view::npos) return false;
+      size_t value_end = value_start + 1;
+      if (json[value_start] == '"') {
+        for (; value_end < json.size() && json[value_end] != '"';
+             value_end++) {
+          if (json[value_end] == '\\') value_end++;
+        }
+        value_end++;
+      } else {
+        value_end = json.find_first_of(",} \t\r\n", value_start);
+      }
+      if (value_end > json.size()) return false;
+      position = value_start;
+      size = value_end - value_start;
+      return true;
+    }
+  }
+  return false;
+}
+
+}  // namespace Casper
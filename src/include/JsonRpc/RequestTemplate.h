@@ -0,0 +1,132 @@
+#pragma once
+
+#include <charconv>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <vector>
+
+namespace Casper {
+/**
+ * @brief JSON text spliced as is into a request template, like a serialized
+ * deploy.
+ *
+ */
+struct RawJson {
+  const std::string& text;
+};
+
+/**
+ * @brief Pre-rendered JSON-RPC request of a method. The request is rendered
+ * once as text with slots for the parameter values, and each call only
+ * appends the id and the values between the fixed parts, without building a
+ * json tree.
+ *
+ * The parameters are given as JSON text where each '$' marks a slot:
+ * @code
+ * RequestTemplate get_block("chain_get_block",
+ *                           R"({"block_identifier":{"Height":$}})");
+ * std::string request = get_block.Render(1, height);
+ * @endcode
+ *
+ */
+class RequestTemplate {
+ public:
+  /**
+   * @brief Construct a new Request Template object.
+   *
+   * @param method name of the JSON-RPC method.
+   * @param params JSON text of the named parameters with '$' slots, or an
+   * empty string for a method without parameters.
+   */
+  RequestTemplate(const std::string& method, const std::string& params = "");
+
+  /**
+   * @brief Returns the request with the given id and slot values. Integers
+   * are written as JSON numbers, strings are quoted and escaped, vectors of
+   * strings are written as arrays and RawJson as is.
+   */
+  template <typename... Values>
+  std::string Render(uint64_t id, const Values&... values) const {
+    std::string request;
+    RenderTo(request, id, values...);
+    return request;
+  }
+
+  /**
+   * @brief Renders the request into the given buffer, reusing its capacity.
+   */
+  template <typename... Values>
+  void RenderTo(std::string& request, uint64_t id,
+                const Values&... values) const {
+    if (sizeof...(Values) != GetSlotCount()) {
+      throw std::invalid_argument("Wrong number of values for the request of " +
+                                  mMethod);
+    }
+
+    request.clear();
+    request.reserve(mFixedSize + 64);
+    request += mParts[0];
+    AppendNumber(request, id);
+
+    size_t part = 1;
+    ((request += mParts[part++], Append(request, values)), ...);
+    request += mParts[part];
+  }
+
+  size_t GetSlotCount() const { return mParts.size() - 2; }
+
+  const std::string& GetMethod() const { return mMethod; }
+
+  /// Appends a JSON string with its quotes.
+  static void AppendString(std::string& out, const std::string& value);
+
+  /**
+   * @brief Finds the "id" member of a JSON-RPC request or response without
+   * parsing the other members. Returns false if the text is not an object
+   * with an id, like a batch.
+   *
+   * @param json JSON text of the request or the response.
+   * @param position set to the position of the JSON text of the id.
+   * @param size set to the size of the JSON text of the id.
+   */
+  static bool FindId(std::string_view json, size_t& position, size_t& size);
+
+ private:
+  template <typename T>
+  static void AppendNumber(std::string& out, T value) {
+    char buffer[24];
+    auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+    out.append(buffer, result.ptr);
+  }
+
+  template <typename T>
+  static void Append(std::string& out, const T& value) {
+    if constexpr (std::is_same_v<T, bool>) {
+      out += value ? "true" : "false";
+    } else if constexpr (std::is_integral_v<T>) {
+      AppendNumber(out, value);
+    } else if constexpr (std::is_same_v<T, RawJson>) {
+      out += value.text;
+    } else if constexpr (std::is_same_v<T, std::vector<std::string>>) {
+      out += '[';
+      for (size_t i = 0; i < value.size(); i++) {
+        if (i != 0) out += ',';
+        AppendString(out, value[i]);
+      }
+      out += ']';
+    } else {
+      AppendString(out, value);
+    }
+  }
+
+  std::string mMethod;
+
+  /// Fixed parts of the request around the id and the slots.
+  std::vector<std::string> mParts;
+  size_t mFixedSize = 0;
+};
+
+}  // namespace Casper
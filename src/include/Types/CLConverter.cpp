@@ -2,23 +2,17 @@
 
 #include <chrono>
 
-#include "date/date.h"
+#include "Types/Timestamp.h"
+#include "Utils/Log.h"
 //#include "bigint/BigIntegerLibrary.hh"
 namespace Casper
 {
 
   uint64_t strToTimestamp(std::string str_date)
   {
-    using namespace date;
-    using namespace std;
-    using namespace std::chrono;
-
-    istringstream in{str_date};
-    in.exceptions(ios::failbit);
-    date::sys_time<milliseconds> tp;
-    in >> parse("%FT%TZ", tp);
-    cout << tp << " = " << tp.time_since_epoch() << '\n';
-    return duration_cast<milliseconds>(tp.time_since_epoch()).count();
+    uint64_t timestamp = Timestamp::Parse(str_date).milliseconds;
+    CASPER_LOG_TRACE("strToTimestamp: " << str_date << " = " << timestamp);
+    return timestamp;
   }
 
   // Encoding & Decoding
@@ -111,7 +105,7 @@ namespace Casper
     CBytes uref_bytes;
     uref_bytes = hexDecode(byte_str);
 
-    return URef::FromString(URef::byteToStringWithAccessRights(uref_bytes));
+    return URef(uref_bytes);
   }
 
   PublicKey publicKeyDecode(const std::string &byte_str)
@@ -5,6 +5,7 @@
 #include "Types/GlobalStateKey.h"
 #include "Types/PublicKey.h"
 #include "Types/URef.h"
+#include "Utils/Log.h"
 
 #include "rva/variant.hpp"
 #include <tuple>
@@ -141,8 +142,6 @@ inline void to_json(nlohmann::json& j, const CLTypeRVA& p) {
   }
   /// inner type - maybe delete
   else if (p.index() == 1) {
-    std::cout << "\n\nrva::get<std::vector<CLTypeRVA>>(p)\n\n" << std::endl;
-
     auto& p_type = rva::get<std::vector<CLTypeRVA>>(p);
     // TODO: should not be called, be careful check this.
     j = p_type;
@@ -282,7 +281,6 @@ inline void from_json(const nlohmann::json& j, CLTypeRVA& p) {
       throw std::runtime_error("Invalid CLType");
     }
   } else if (j.is_array()) {
-    std::cout << "arraycltype" << std::endl;
     auto inner_vec = std::vector<CLTypeRVA>();
     for (auto& inner : j) {
       CLTypeRVA inner_val;
@@ -314,15 +312,12 @@ struct CLType {
 
     switch (tag) {
       case CLTypeEnum::List:
-        std::cout << "list cltype switch" << std::endl;
         obj_type = type_;
         list_map["List"] = obj_type;
         type = list_map;
-        std::cout << "list cltype switch end" << std::endl;
         break;
 
       default:
-        std::cout << "Invalid Tag" << std::endl;
         throw std::runtime_error("Invalid CLType");
     }
   }
@@ -10,6 +10,7 @@
 #include "Types/GlobalStateKey.h"
 #include "Types/PublicKey.h"
 #include "Types/URef.h"
+#include "Utils/Log.h"
 #include "magic_enum/magic_enum.hpp"
 #include "nlohmann/json.hpp"
 #include "rva/variant.hpp"
@@ -89,7 +90,6 @@ inline void to_json(nlohmann::json& j, const CLTypeParsedRVA& p) {
     j = p_type;
   } else if (p.index() == 10) {
     auto& p_type = rva::get<URef>(p);
-    std::cout << "\nURef to_json\n" << std::endl;
     j = p_type.ToString();
   } else if (p.index() == 11) {
     auto p_type = rva::get<GlobalStateKey>(p);
@@ -158,13 +158,13 @@ inline void from_json(const nlohmann::json& j, CLTypeParsedRVA& p,
         p = j.get<uint64_t>();
         break;
       case CLTypeEnum::U128:
-        p = u128FromDec(j.get<std::string>());
+        p = u128FromDec(j.get_ref<const std::string&>());
         break;
       case CLTypeEnum::U256:
-        p = u256FromDec(j.get<std::string>());
+        p = u256FromDec(j.get_ref<const std::string&>());
         break;
       case CLTypeEnum::U512:
-        p = u512FromDec(j.get<std::string>());
+        p = u512FromDec(j.get_ref<const std::string&>());
         break;
       case CLTypeEnum::Unit:
       case CLTypeEnum::Any:
@@ -174,10 +174,12 @@ inline void from_json(const nlohmann::json& j, CLTypeParsedRVA& p,
         p = j.get<std::string>();
         break;
       case CLTypeEnum::URef:  // compare with a CLTypeEnum::URef examle
-        p = URef::FromString(j.get<std::string>());
+        p = GlobalStateKey(j.get_ref<const std::string&>(),
+                           KeyIdentifier::URef);
         break;
       case CLTypeEnum::Key:
-        p = GlobalStateKey::FromString(j.begin().value().get<std::string>());
+        p = GlobalStateKey::FromString(
+            j.begin().value().get_ref<const std::string&>());
         break;
       case CLTypeEnum::PublicKey:
         p = PublicKey::FromHexString(j.get<std::string>());
@@ -234,7 +236,6 @@ inline void from_json(const nlohmann::json& j, CLTypeParsedRVA& p,
     }
 
   } else if (cl_type_.type.index() == 3) {
-    std::cout << "\nCLTypeRVA from_json 3\n" << std::endl;
     /// option, list, result
 
     auto obj = std::get<std::map<std::string, CLTypeRVA>>(cl_type_.type);
@@ -305,7 +306,7 @@ inline void from_json(const nlohmann::json& j, CLTypeParsedRVA& p,
       }
 
     } else {
-      std::cout << "Unknown type\n" << std::endl;
+      CASPER_LOG_WARNING("CLTypeParsed from_json: unknown type");
       // TODO: Check this case, maybe error
     }
   }
@@ -337,7 +338,8 @@ inline void from_json(const nlohmann::json& j, CLTypeParsedRVA& p,
   }
 
   else {
-    std::cout << "\nERROR CLTypeRVA from_json 4\n" << std::endl;
+    CASPER_LOG_WARNING("CLTypeParsed from_json: unsupported type index "
+                       << cl_type_.type.index());
   }
 
   ////////////////////////////
@@ -5,6 +5,7 @@
 #include "Types/CLType.h"
 #include "Types/CLTypeParsed.h"
 #include "Utils/CEP57Checksum.h"
+#include "Utils/Log.h"
 #include "cryptopp/secblock.h"
 #include "nlohmann/json.hpp"
 
@@ -105,8 +106,7 @@ struct CLValue {
   /// Returns a `CLValue` object with an U128 type.
   /// </summary>
   static CLValue U128(uint128_t value) {
-    CBytes bytes = hexDecode(u128ToHex(value));
-
+    CBytes bytes = wideToBytes(value);
     return CLValue(bytes, CLTypeEnum::U128, u128ToDec(value));
   }
 
@@ -114,8 +114,7 @@ struct CLValue {
   /// Returns a `CLValue` object with an U256 type.
   /// </summary>
   static CLValue U256(uint256_t value) {
-    CBytes bytes = hexDecode(u256ToHex(value));
-
+    CBytes bytes = wideToBytes(value);
     return CLValue(bytes, CLTypeEnum::U256, u256ToDec(value));
   }
 
@@ -123,9 +122,7 @@ struct CLValue {
   /// Returns a `CLValue` object with an U512 type.
   /// </summary>
   static CLValue U512(uint512_t value) {
-    // std::cout << "u512ToHex: " << u512ToHex(value) << std::endl;
-    CBytes bytes = hexDecode(u512ToHex(value));
-    // std::cout << "after bytes" << std::endl;
+    CBytes bytes = wideToBytes(value);
     return CLValue(bytes, CLTypeEnum::U512, u512ToDec(value));
   }
 
@@ -347,7 +344,6 @@ struct CLValue {
 
   static CLValue List(std::vector<CLValue> values) {
     if (values.size() == 0) {
-      std::cout << "List size is 0" << std::endl;
       throw std::runtime_error("List cannot be empty");
     }
 
@@ -442,13 +438,12 @@ struct CLValue {
     CLTypeRVA keyType;
     CLTypeRVA valueType;
     CBytes bytes;
-    std::cout << "dict size: " << dict.size() << std::endl;
+    CASPER_LOG_TRACE("CLValue::Map size: " << dict.size());
 
     CBytes len = hexDecode(u32Encode(dict.size()));
     std::map<CLTypeParsedRVA, CLTypeParsedRVA> parsed_dict;
     bytes += len;
     int i = 0;
-    std::cout << "dict size: " << dict.size() << std::endl;
     for (auto kv : dict) {
       parsed_dict[kv.first.parsed.parsed] = kv.second.parsed.parsed;
       if (i == 0) {
@@ -465,12 +460,9 @@ struct CLValue {
       bytes += kv.second.bytes;
       i++;
     }
-    std::cout << "bytes: " << bytes.size() << std::endl;
     std::map<CLTypeRVA, CLTypeRVA> mp;
     mp[keyType] = valueType;
-    std::cout << "map: " << mp.size() << std::endl;
     CLTypeRVA ty(mp);
-    std::cout << "ty: " << std::endl;
 
     return CLValue(bytes, CLType(ty), parsed_dict);
   }
@@ -564,11 +556,8 @@ struct CLValue {
     CBytes accountHash =
         AccountHashKey(publicKey.GetAccountHash()).raw_bytes;
 
-    std::cout << "\n\n\n\n\nAccountHashKey size: " << accountHash.size()
-              << std::endl
-              << std::endl
-              << std::endl
-              << std::endl;
+    CASPER_LOG_TRACE("KeyFromPublicKey account hash size: "
+                     << accountHash.size());
 
 
     CBytes bytes(1 + accountHash.size());
@@ -605,7 +594,7 @@ inline void to_json(nlohmann::json& j, const CLValue& p) {
     std::string tmp_bytes = hexEncode(p.bytes);
     j["bytes"] = tmp_bytes;
   } catch (const std::exception& e) {
-    std::cout << "CLValue-to_json-bytes what(): " << e.what() << std::endl;
+    CASPER_LOG_WARNING("CLValue to_json bytes: " << e.what());
   }
 
   to_json(j["parsed"], p.parsed);
@@ -618,7 +607,7 @@ inline void from_json(const nlohmann::json& j, CLValue& p) {
     std::string hex_bytes_str = j.at("bytes").get<std::string>();
     p.bytes = hexDecode(hex_bytes_str);
   } catch (const std::exception& e) {
-    std::cout << "CLValue-from_json-bytes what(): " << e.what() << std::endl;
+    CASPER_LOG_WARNING("CLValue from_json bytes: " << e.what());
   }
 
   // std::cout << j.at("parsed").dump(2) << std::endl;
@@ -1,6 +1,8 @@
 #include "Types/Deploy.h"
 #include "ByteSerializers/ExecutableDeployItemByteSerializer.h"
 #include "ByteSerializers/DeployByteSerializer.h"
+#include "Utils/Tracing.h"
+#include "Utils/Log.h"
 
 namespace Casper {
 
@@ -14,25 +16,27 @@ Deploy::Deploy(DeployHeader header, ExecutableDeployItem payment,
 
   this->hash = hexEncode(ComputeHeaderHash(this->header));
 
-  this->payment = payment;
-  this->session = session;
+  this->payment = std::move(payment);
+  this->session = std::move(session);
 }
 
 /// <summary>
 /// Signs the deploy with a private key and adds a new Approval to it.
 /// </summary>
 void Deploy::Sign(KeyPair keyPair) {
+  TraceSpan span(SpanKind::Sign, "Deploy::Sign");
   CBytes signature = keyPair.Sign(CEP57Checksum::Decode(this->hash));
 
   this->approvals.emplace_back(
       keyPair.public_key,
-      Signature::FromRawBytes(signature, keyPair.public_key.key_algorithm));
+      Signature::FromRawBytes(signature, keyPair.public_key.GetKeyAlgorithm()));
 }
 
 /// <summary>
 /// Signs the deploy with a private key and adds a new Approval to it.
 /// </summary>
 void Deploy::Sign(Secp256k1Key& sec_key) {
+  TraceSpan span(SpanKind::Sign, "Deploy::Sign");
   CBytes signature = sec_key.sign(CEP57Checksum::Decode(this->hash));
 
   std::string public_key_str = "02" + sec_key.getPublicKeyStr();
@@ -110,8 +114,9 @@ int Deploy::GetDeploySizeInBytes() const {
   return serializer.ToBytes(*this).size();
 }
 
-CBytes Deploy::ComputeBodyHash(ExecutableDeployItem payment,
-                               ExecutableDeployItem session) {
+CBytes Deploy::ComputeBodyHash(const ExecutableDeployItem& payment,
+                               const ExecutableDeployItem& session) {
+  TraceSpan span(SpanKind::Hash, "Deploy::ComputeBodyHash");
   CBytes sb;
   // std::cout << "ComputeBodyHash" << std::endl;
   ExecutableDeployItemByteSerializer itemSerializer;
@@ -131,14 +136,10 @@ CBytes Deploy::ComputeBodyHash(ExecutableDeployItem payment,
   return hash;
 }
 
-CBytes Deploy::ComputeHeaderHash(DeployHeader header) {
+CBytes Deploy::ComputeHeaderHash(const DeployHeader& header) {
+  TraceSpan span(SpanKind::Hash, "Deploy::ComputeHeaderHash");
   DeployByteSerializer serializer;
 
-  nlohmann::json j;
-  to_json(j, header);
-  // std::cout << "ComputeHeaderHash header: \n";
-  // std::cout << j.dump(2) << std::endl;
-
   CBytes bHeader = serializer.ToBytes(header);
 
   CryptoPP::BLAKE2b bcBl2bdigest(32u);
@@ -176,7 +177,8 @@ Deploy Deploy::loadFromFile(const std::string& file_name) {
     std::ifstream ifs(file_name);
     input_json = nlohmann::json::parse(ifs);
   } catch (std::exception& e) {
-    std::cout << "Error! Loading deploy file: " << file_name << std::endl;
+    CASPER_LOG_ERROR("cannot load the deploy file " << file_name << ": "
+                                                     << e.what());
   }
 
   // create a Deploy from the json
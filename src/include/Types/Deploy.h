@@ -45,8 +45,8 @@ struct Deploy {
          ExecutableDeployItem session_, std::vector<DeployApproval> approvals_)
       : hash(hash_),
         header(header_),
-        payment(payment_),
-        session(session_),
+        payment(std::move(payment_)),
+        session(std::move(session_)),
         approvals(approvals_) {}
 
   Deploy(DeployHeader header, ExecutableDeployItem payment,
@@ -70,10 +70,10 @@ struct Deploy {
 
   int GetDeploySizeInBytes() const;
 
-  CBytes ComputeBodyHash(ExecutableDeployItem payment,
-                         ExecutableDeployItem session);
+  CBytes ComputeBodyHash(const ExecutableDeployItem& payment,
+                         const ExecutableDeployItem& session);
 
-  CBytes ComputeHeaderHash(DeployHeader header);
+  CBytes ComputeHeaderHash(const DeployHeader& header);
 
   nlohmann::json toJson() const;
 
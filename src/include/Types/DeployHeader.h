@@ -1,7 +1,9 @@
 #pragma once
 
 #include "Base.h"
+#include "Types/Duration.h"
 #include "Types/PublicKey.h"
+#include "Types/Timestamp.h"
 #include "nlohmann/json.hpp"
 
 namespace Casper {
@@ -16,15 +18,15 @@ struct DeployHeader {
   PublicKey account;
 
   /// <summary>
-  /// Timestamp formatted as per RFC 3339
+  /// Creation time of the Deploy, formatted as per RFC 3339 in JSON.
   /// </summary>
-  std::string timestamp;
+  Timestamp timestamp;
 
   /// <summary>
-  /// Duration of the Deploy in milliseconds (from timestamp).
+  /// Duration of the Deploy in milliseconds (from timestamp), formatted like
+  /// "30m" in JSON.
   /// </summary>
-  // TODOMS3: [JsonConverter(typeof(HumanizeTTLConverter))]
-  std::string ttl;
+  Duration ttl;
 
   /// <summary>
   /// Gas price
@@ -49,9 +51,8 @@ struct DeployHeader {
 
   DeployHeader() {}
 
-  DeployHeader(const PublicKey& account_, const std::string& timestamp_,
-               const std::string& ttl_, uint64_t gas_price_,
-               const std::string& body_hash_,
+  DeployHeader(const PublicKey& account_, Timestamp timestamp_, Duration ttl_,
+               uint64_t gas_price_, const std::string& body_hash_,
                const std::vector<std::string>& dependencies_,
                const std::string& chain_name_)
       : account(account_),
@@ -61,6 +62,24 @@ struct DeployHeader {
         body_hash(body_hash_),
         dependencies(dependencies_),
         chain_name(chain_name_) {}
+
+  /// <summary>
+  /// Constructs a header from the texts of the timestamp, like
+  /// "2021-12-13T12:00:00.000Z", and of the time to live, like "30m". Throws
+  /// std::invalid_argument if they cannot be parsed.
+  /// </summary>
+  DeployHeader(const PublicKey& account_, std::string_view timestamp_,
+               std::string_view ttl_, uint64_t gas_price_,
+               const std::string& body_hash_,
+               const std::vector<std::string>& dependencies_,
+               const std::string& chain_name_)
+      : account(account_),
+        timestamp(Timestamp::Parse(timestamp_)),
+        ttl(Duration::Parse(ttl_)),
+        gas_price(gas_price_),
+        body_hash(body_hash_),
+        dependencies(dependencies_),
+        chain_name(chain_name_) {}
 };
 
 // to_json of DeployHeader
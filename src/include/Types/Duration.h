@@ -0,0 +1,189 @@
+#pragma once
+
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "nlohmann/json.hpp"
+
+namespace Casper {
+/// <summary>
+/// Duration in milliseconds, like the time to live of a deploy. Its text is
+/// in the humantime format of the node, like "30m", "1h 30m" or "2days 1h".
+/// </summary>
+struct Duration {
+  uint64_t milliseconds = 0;
+
+  /// Longest text written by Write, like
+  /// "584542046years 11months 30days 23h 59m 59s 999ms".
+  static constexpr size_t MAX_TEXT_SIZE = 64;
+
+  Duration() {}
+
+  explicit Duration(uint64_t milliseconds_) : milliseconds(milliseconds_) {}
+
+  /// <summary>
+  /// Parses a humantime duration: numbers followed by a unit, from "ns" to
+  /// "years", optionally separated by spaces. Returns false if the text is
+  /// not a duration. The parts below a millisecond are truncated.
+  /// </summary>
+  static bool TryParse(std::string_view text, Duration& duration) {
+    // the units in nanoseconds, a year is 365.25 days and a month 30.44 days
+    struct Unit {
+      std::string_view name;
+      uint64_t nanoseconds;
+    };
+    static constexpr uint64_t SECOND = 1000000000;
+    static constexpr Unit UNITS[] = {
+        {"nanoseconds", 1},          {"nanosecond", 1},
+        {"nanos", 1},                {"nsec", 1},
+        {"ns", 1},                   {"microseconds", 1000},
+        {"microsecond", 1000},       {"micros", 1000},
+        {"usec", 1000},              {"us", 1000},
+        {"milliseconds", 1000000},   {"millisecond", 1000000},
+        {"millis", 1000000},         {"msec", 1000000},
+        {"ms", 1000000},             {"seconds", SECOND},
+        {"second", SECOND},          {"secs", SECOND},
+        {"sec", SECOND},             {"s", SECOND},
+        {"minutes", 60 * SECOND},    {"minute", 60 * SECOND},
+        {"mins", 60 * SECOND},       {"min", 60 * SECOND},
+        {"m", 60 * SECOND},          {"hours", 3600 * SECOND},
+        {"hour", 3600 * SECOND},     {"hrs", 3600 * SECOND},
+        {"hr", 3600 * SECOND},       {"h", 3600 * SECOND},
+        {"days", 86400 * SECOND},    {"day", 86400 * SECOND},
+        {"d", 86400 * SECOND},       {"weeks", 604800 * SECOND},
+        {"week", 604800 * SECOND},   {"w", 604800 * SECOND},
+        {"months", MONTH * SECOND},  {"month", MONTH * SECOND},
+        {"M", MONTH * SECOND},       {"years", YEAR * SECOND},
+        {"year", YEAR * SECOND},     {"y", YEAR * SECOND}};
+
+    unsigned __int128 nanoseconds = 0;
+    size_t position = SkipSpaces(text, 0);
+    if (position == text.size()) return false;
+    while (position < text.size()) {
+      uint64_t number = 0;
+      size_t digits_start = position;
+      while (position < text.size() && text[position] >= '0' &&
+             text[position] <= '9') {
+        if (number > (UINT64_MAX - 9) / 10) return false;
+        number = number * 10 + (text[position++] - '0');
+      }
+      if (position == digits_start) return false;
+
+      position = SkipSpaces(text, position);
+      size_t unit_start = position;
+      while (position < text.size() &&
+             ((text[position] >= 'a' && text[position] <= 'z') ||
+              (text[position] >= 'A' && text[position] <= 'Z'))) {
+        position++;
+      }
+      std::string_view name = text.substr(unit_start, position - unit_start);
+      const Unit* unit = nullptr;
+      for (const Unit& candidate : UNITS) {
+        if (candidate.name == name) {
+          unit = &candidate;
+          break;
+        }
+      }
+      if (unit == nullptr) return false;
+
+      nanoseconds += (unsigned __int128)number * unit->nanoseconds;
+      if (nanoseconds / 1000000 > UINT64_MAX) return false;
+      position = SkipSpaces(text, position);
+    }
+
+    duration.milliseconds = uint64_t(nanoseconds / 1000000);
+    return true;
+  }
+
+  /// <summary>
+  /// Parses a humantime duration, see TryParse. Throws std::invalid_argument
+  /// if the text is not a duration.
+  /// </summary>
+  static Duration Parse(std::string_view text) {
+    Duration duration;
+    if (!TryParse(text, duration)) {
+      throw std::invalid_argument("Invalid duration: " + std::string(text));
+    }
+    return duration;
+  }
+
+  /// <summary>
+  /// Writes the duration like the node, "1h 30m" or "0s", to a buffer of at
+  /// least MAX_TEXT_SIZE characters. Returns the number of characters
+  /// written, without a terminating zero.
+  /// </summary>
+  size_t Write(char* buffer) const {
+    uint64_t seconds = milliseconds / 1000;
+    // years and months are not whole days, the days and the time of the day
+    // are what remains after them
+    uint64_t month_seconds = seconds % YEAR % MONTH;
+    uint64_t parts[] = {seconds / YEAR,
+                        seconds % YEAR / MONTH,
+                        month_seconds / 86400,
+                        month_seconds % 86400 / 3600,
+                        month_seconds % 3600 / 60,
+                        month_seconds % 60,
+                        milliseconds % 1000};
+    static constexpr const char* UNIT_NAMES[] = {"year", "month", "day", "h",
+                                                 "m",    "s",     "ms"};
+
+    char* end = buffer;
+    for (size_t i = 0; i < std::size(parts); i++) {
+      if (parts[i] == 0) continue;
+      if (end != buffer) *end++ = ' ';
+      end = WriteNumber(end, parts[i]);
+      for (const char* c = UNIT_NAMES[i]; *c; c++) *end++ = *c;
+      // years, months and days are plural
+      if (i < 3 && parts[i] > 1) *end++ = 's';
+    }
+    if (end == buffer) {
+      *end++ = '0';
+      *end++ = 's';
+    }
+    return end - buffer;
+  }
+
+  std::string ToString() const {
+    char buffer[MAX_TEXT_SIZE];
+    return std::string(buffer, Write(buffer));
+  }
+
+  bool operator==(const Duration& other) const {
+    return milliseconds == other.milliseconds;
+  }
+
+  bool operator!=(const Duration& other) const { return !(*this == other); }
+
+ private:
+  /// Length of a year and a month in seconds, like humantime.
+  static constexpr uint64_t YEAR = 31557600;
+  static constexpr uint64_t MONTH = 2630016;
+
+  static size_t SkipSpaces(std::string_view text, size_t position) {
+    while (position < text.size() && text[position] == ' ') position++;
+    return position;
+  }
+
+  static char* WriteNumber(char* buffer, uint64_t number) {
+    char digits[20];
+    size_t count = 0;
+    do {
+      digits[count++] = char('0' + number % 10);
+      number /= 10;
+    } while (number != 0);
+    while (count > 0) *buffer++ = digits[--count];
+    return buffer;
+  }
+};
+
+inline void to_json(nlohmann::json& j, const Duration& p) {
+  j = p.ToString();
+}
+
+inline void from_json(const nlohmann::json& j, Duration& p) {
+  p = Duration::Parse(j.get_ref<const std::string&>());
+}
+
+}  // namespace Casper
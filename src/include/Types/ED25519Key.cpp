@@ -8,6 +8,7 @@
 #include "cryptopp/files.h"
 #include "cryptopp/pem.h"
 #include "Utils/CEP57Checksum.h"
+#include "Utils/Log.h"
 
 namespace Casper {
 Ed25519Key::Ed25519Key(std::string pem_file_path)
@@ -15,20 +16,20 @@ Ed25519Key::Ed25519Key(std::string pem_file_path)
   FILE* fp = fopen(pem_file_path.c_str(), "r");
 
   if (!fp) {
-    printf("ERROR: file %s does not exist\n", pem_file_path.c_str());
+    CASPER_LOG_ERROR("file " << pem_file_path << " does not exist");
     return;
   }
   EVP_PKEY* pkey = PEM_read_PrivateKey(fp, nullptr, nullptr, nullptr);
 
   if (pkey == nullptr) {
-    printf("ERROR: file %s is not a valid private key\n",
-           pem_file_path.c_str());
+    CASPER_LOG_ERROR("file " << pem_file_path
+                             << " is not a valid private key");
     return;
   }
 
   if (EVP_PKEY_id(pkey) != EVP_PKEY_ED25519) {
-    printf("ERROR: file %s is not a valid ED25519 private key\n",
-           pem_file_path.c_str());
+    CASPER_LOG_ERROR("file " << pem_file_path
+                             << " is not a valid ED25519 private key");
     return;
   }
 
@@ -91,7 +92,7 @@ CryptoPP::SecByteBlock Ed25519Key::sign(const CryptoPP::SecByteBlock& message) {
     throw std::runtime_error("Error encoding signature to hex");
   }
 
-  std::cout << "signature: " << encoded << std::endl;
+  CASPER_LOG_DEBUG("ED25519 signature: " << encoded);
 
   CryptoPP::SecByteBlock signature_block(hexDecode(encoded));
 
@@ -106,7 +107,8 @@ bool Ed25519Key::verify(const CryptoPP::SecByteBlock& message,
   bool is_valid = verifier.VerifyMessage(message.BytePtr(), message.size(),
                                          (CryptoPP::byte*)signature.data(),
                                          signature.size());
-  std::cout << "Verification: " << std::boolalpha << is_valid << std::endl;
+  CASPER_LOG_DEBUG("ED25519 signature verification: " << std::boolalpha
+                                                       << is_valid);
   return is_valid;
 }
 
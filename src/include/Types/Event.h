@@ -0,0 +1,165 @@
+#pragma once
+
+#include <optional>
+
+#include "Base.h"
+#include "Types/Block.h"
+#include "Types/ExecutionResult.h"
+#include "Types/PublicKey.h"
+#include "Types/Signature.h"
+#include "nlohmann/json.hpp"
+
+namespace Casper {
+/// <summary>
+/// A block added to the linear chain, sent by the node's event stream.
+/// </summary>
+struct BlockAddedEvent {
+  /// <summary>
+  /// Hash of the added block.
+  /// </summary>
+  std::string block_hash;
+
+  /// <summary>
+  /// The added block.
+  /// </summary>
+  Block block;
+
+  BlockAddedEvent() {}
+};
+
+// from_json of BlockAddedEvent
+inline void from_json(const nlohmann::json& j, BlockAddedEvent& p) {
+  j.at("block_hash").get_to(p.block_hash);
+  j.at("block").get_to(p.block);
+}
+
+/// <summary>
+/// A deploy executed in a block, sent by the node's event stream.
+/// </summary>
+struct DeployProcessedEvent {
+  /// <summary>
+  /// Hash of the executed deploy.
+  /// </summary>
+  std::string deploy_hash;
+
+  /// <summary>
+  /// Public key of the account that created the deploy.
+  /// </summary>
+  PublicKey account;
+
+  /// <summary>
+  /// Timestamp of the deploy.
+  /// </summary>
+  std::string timestamp;
+
+  /// <summary>
+  /// Time to live of the deploy.
+  /// </summary>
+  std::string ttl;
+
+  /// <summary>
+  /// Hashes of the deploys this deploy depends on.
+  /// </summary>
+  std::vector<std::string> dependencies;
+
+  /// <summary>
+  /// Hash of the block the deploy was executed in.
+  /// </summary>
+  std::string block_hash;
+
+  /// <summary>
+  /// Result of the execution, with the block hash.
+  /// </summary>
+  ExecutionResult execution_result;
+
+  DeployProcessedEvent() {}
+};
+
+// from_json of DeployProcessedEvent
+inline void from_json(const nlohmann::json& j, DeployProcessedEvent& p) {
+  j.at("deploy_hash").get_to(p.deploy_hash);
+  j.at("account").get_to(p.account);
+  j.at("timestamp").get_to(p.timestamp);
+  j.at("ttl").get_to(p.ttl);
+  j.at("dependencies").get_to(p.dependencies);
+  j.at("block_hash").get_to(p.block_hash);
+
+  // the event holds the Success or Failure result directly
+  const nlohmann::json& result = j.at("execution_result");
+  if (result.find("Success") != result.end()) {
+    p.execution_result.success =
+        result.at("Success").get<ExecutionResultSuccess>();
+  } else if (result.find("Failure") != result.end()) {
+    p.execution_result.failure =
+        result.at("Failure").get<ExecutionResultFailure>();
+  }
+  p.execution_result.block_hash = p.block_hash;
+}
+
+/// <summary>
+/// A validator's signature of a finalized block, sent by the node's event
+/// stream.
+/// </summary>
+struct FinalitySignatureEvent {
+  /// <summary>
+  /// Hash of the signed block.
+  /// </summary>
+  std::string block_hash;
+
+  /// <summary>
+  /// Era of the signed block.
+  /// </summary>
+  uint64_t era_id;
+
+  /// <summary>
+  /// Signature of the block hash and era id.
+  /// </summary>
+  Signature signature;
+
+  /// <summary>
+  /// Public key of the signing validator.
+  /// </summary>
+  PublicKey public_key;
+
+  FinalitySignatureEvent() {}
+};
+
+// from_json of FinalitySignatureEvent
+inline void from_json(const nlohmann::json& j, FinalitySignatureEvent& p) {
+  j.at("block_hash").get_to(p.block_hash);
+  j.at("era_id").get_to(p.era_id);
+  j.at("signature").get_to(p.signature);
+  j.at("public_key").get_to(p.public_key);
+}
+
+/// <summary>
+/// An event of the node's event stream. Only one of the events is set.
+/// </summary>
+struct Event {
+  /// <summary>
+  /// Id of the event in the stream, used to resume the stream.
+  /// </summary>
+  std::optional<uint64_t> id = std::nullopt;
+
+  std::optional<BlockAddedEvent> block_added = std::nullopt;
+
+  std::optional<DeployProcessedEvent> deploy_processed = std::nullopt;
+
+  std::optional<FinalitySignatureEvent> finality_signature = std::nullopt;
+
+  Event() {}
+};
+
+// from_json of Event, leaves every event unset for unknown event kinds
+inline void from_json(const nlohmann::json& j, Event& p) {
+  if (j.find("BlockAdded") != j.end()) {
+    p.block_added = j.at("BlockAdded").get<BlockAddedEvent>();
+  } else if (j.find("DeployProcessed") != j.end()) {
+    p.deploy_processed = j.at("DeployProcessed").get<DeployProcessedEvent>();
+  } else if (j.find("FinalitySignature") != j.end()) {
+    p.finality_signature =
+        j.at("FinalitySignature").get<FinalitySignatureEvent>();
+  }
+}
+
+}  // namespace Casper
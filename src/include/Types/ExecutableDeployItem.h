@@ -1,6 +1,7 @@
 #pragma once
 
-#include <optional>
+#include <string_view>
+#include <variant>
 
 #include "Base.h"
 #include "Types/ModuleBytes.h"
@@ -8,41 +9,93 @@
 #include "Types/StoredContractByName.h"
 #include "Types/StoredVersionedContractByHash.h"
 #include "Types/StoredVersionedContractByName.h"
+#include "Types/TaggedUnion.h"
 #include "Types/TransferDeployItem.h"
 #include "magic_enum/magic_enum.hpp"
 #include "nlohmann/json.hpp"
 
 namespace Casper {
-/// Represents possible variants of an executable deploy.
+/// Type of an ExecutableDeployItem, the index of its alternative and its tag
+/// in the serialized deploy.
+enum class ExecutableDeployItemType {
+  ModuleBytes = 0,
+  StoredContractByHash = 1,
+  StoredContractByName = 2,
+  StoredVersionedContractByHash = 3,
+  StoredVersionedContractByName = 4,
+  Transfer = 5
+};
+
+/// Represents possible variants of an executable deploy. It holds one of
+/// them, empty ModuleBytes by default.
 struct ExecutableDeployItem {
-  std::optional<ModuleBytes> module_bytes = std::nullopt;
-  std::optional<StoredContractByHash> stored_contract_by_hash = std::nullopt;
-  std::optional<StoredContractByName> stored_contract_by_name = std::nullopt;
-  std::optional<StoredVersionedContractByHash>
-      stored_versioned_contract_by_hash = std::nullopt;
-  std::optional<StoredVersionedContractByName>
-      stored_versioned_contract_by_name = std::nullopt;
-  std::optional<TransferDeployItem> transfer = std::nullopt;
+  std::variant<ModuleBytes, StoredContractByHash, StoredContractByName,
+               StoredVersionedContractByHash, StoredVersionedContractByName,
+               TransferDeployItem>
+      value;
+
+  /// JSON names of the types, in the order of ExecutableDeployItemType.
+  static constexpr std::string_view NAMES[] = {
+      "ModuleBytes",
+      "StoredContractByHash",
+      "StoredContractByName",
+      "StoredVersionedContractByHash",
+      "StoredVersionedContractByName",
+      "Transfer"};
 
   ExecutableDeployItem() {}
 
-  ExecutableDeployItem(ModuleBytes module_bytes) : module_bytes(module_bytes) {}
+  ExecutableDeployItem(ModuleBytes module_bytes)
+      : value(std::move(module_bytes)) {}
 
   ExecutableDeployItem(StoredContractByHash stored_contract_by_hash)
-      : stored_contract_by_hash(stored_contract_by_hash) {}
+      : value(std::move(stored_contract_by_hash)) {}
 
   ExecutableDeployItem(StoredContractByName stored_contract_by_name)
-      : stored_contract_by_name(stored_contract_by_name) {}
+      : value(std::move(stored_contract_by_name)) {}
 
   ExecutableDeployItem(
       StoredVersionedContractByHash stored_versioned_contract_by_hash)
-      : stored_versioned_contract_by_hash(stored_versioned_contract_by_hash) {}
+      : value(std::move(stored_versioned_contract_by_hash)) {}
 
   ExecutableDeployItem(
       StoredVersionedContractByName stored_versioned_contract_by_name)
-      : stored_versioned_contract_by_name(stored_versioned_contract_by_name) {}
+      : value(std::move(stored_versioned_contract_by_name)) {}
+
+  ExecutableDeployItem(TransferDeployItem transfer)
+      : value(std::move(transfer)) {}
+
+  ExecutableDeployItemType GetType() const {
+    return ExecutableDeployItemType(value.index());
+  }
+
+  /// <summary>
+  /// Returns the item of the type, like
+  /// Get<ExecutableDeployItemType::Transfer>(). Throws
+  /// std::bad_variant_access if it is of another type.
+  /// </summary>
+  template <ExecutableDeployItemType T>
+  auto& Get() {
+    return std::get<size_t(T)>(value);
+  }
 
-  ExecutableDeployItem(TransferDeployItem transfer) : transfer(transfer) {}
+  template <ExecutableDeployItemType T>
+  const auto& Get() const {
+    return std::get<size_t(T)>(value);
+  }
+
+  /// <summary>
+  /// Returns the item of the type, or nullptr if it is of another type.
+  /// </summary>
+  template <ExecutableDeployItemType T>
+  auto* GetIf() {
+    return std::get_if<size_t(T)>(&value);
+  }
+
+  template <ExecutableDeployItemType T>
+  const auto* GetIf() const {
+    return std::get_if<size_t(T)>(&value);
+  }
 };
 
 /**
@@ -52,22 +105,7 @@ struct ExecutableDeployItem {
  * @param p ExecutableDeployItem object to construct from.
  */
 inline void to_json(nlohmann::json& j, const ExecutableDeployItem& p) {
-  if (p.module_bytes.has_value()) {
-    j["ModuleBytes"] = p.module_bytes.value();
-  } else if (p.stored_contract_by_hash.has_value()) {
-    j["StoredContractByHash"] = p.stored_contract_by_hash.value();
-  } else if (p.stored_contract_by_name.has_value()) {
-    j["StoredContractByName"] = p.stored_contract_by_name.value();
-  } else if (p.stored_versioned_contract_by_hash.has_value()) {
-    j["StoredVersionedContractByHash"] =
-        p.stored_versioned_contract_by_hash.value();
-  } else if (p.stored_versioned_contract_by_name.has_value()) {
-    j["StoredVersionedContractByName"] =
-        p.stored_versioned_contract_by_name.value();
-  } else if (p.transfer.has_value()) {
-    j["Transfer"] = p.transfer.value();
-  }
-  // TODOMS3: maybe return "null" if no value is set?
+  TaggedUnion::ToJson(j, p.value, ExecutableDeployItem::NAMES);
 }
 
 /**
@@ -77,26 +115,7 @@ inline void to_json(nlohmann::json& j, const ExecutableDeployItem& p) {
  * @param p ExecutableDeployItem object to construct.
  */
 inline void from_json(const nlohmann::json& j, ExecutableDeployItem& p) {
-  if (j.find("ModuleBytes") != j.end()) {
-    p.module_bytes = j["ModuleBytes"].get<ModuleBytes>();
-  } else if (j.find("StoredContractByHash") != j.end()) {
-    p.stored_contract_by_hash =
-        j["StoredContractByHash"].get<StoredContractByHash>();
-  } else if (j.find("StoredContractByName") != j.end()) {
-    p.stored_contract_by_name =
-        j["StoredContractByName"].get<StoredContractByName>();
-  } else if (j.find("StoredVersionedContractByHash") != j.end()) {
-    p.stored_versioned_contract_by_hash =
-        j["StoredVersionedContractByHash"].get<StoredVersionedContractByHash>();
-  } else if (j.find("StoredVersionedContractByName") != j.end()) {
-    p.stored_versioned_contract_by_name =
-        j["StoredVersionedContractByName"].get<StoredVersionedContractByName>();
-  } else if (j.find("Transfer") != j.end()) {
-    p.transfer = j["Transfer"].get<TransferDeployItem>();
-  } else {
-    throw std::runtime_error("Invalid ExecutableDeployItem");
-  }
-  // TODOMS3: maybe not throw if no value is set?
+  TaggedUnion::FromJson(j, p.value, ExecutableDeployItem::NAMES);
 }
 
 }  // namespace Casper
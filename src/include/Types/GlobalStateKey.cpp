@@ -1,6 +1,6 @@
 #include "Types/GlobalStateKey.h"
 
-#include <sstream>
+#include <charconv>
 
 #include "Types/URef.h"
 #include "Utils/CEP57Checksum.h"
@@ -9,113 +9,228 @@
 
 namespace Casper {
 
-CBytes GlobalStateKey::_GetRawBytesFromKey(std::string key) {
-  return CryptoUtil::hexDecode(key.substr(key.find_last_of("-") + 1));
+namespace {
+/// Size of the raw bytes of the keys, other than the EraInfo keys.
+constexpr size_t ADDRESS_SIZE = 32;
+/// Size of the raw bytes of the EraInfo keys, a u64.
+constexpr size_t ERA_ID_SIZE = 8;
+
+/// Formatted prefix of the keys, by key identifier.
+constexpr std::string_view PREFIXES[] = {
+    "account-hash-", "hash-",    "uref-",     "transfer-", "deploy-",
+    "era-",          "balance-", "bid-",      "withdraw-", "dictionary-"};
+
+struct ParsedPrefix {
+  std::string_view text;
+  KeyIdentifier key_identifier;
+};
+
+/// Prefixes accepted by FromString, a prefix before the prefixes it starts.
+constexpr ParsedPrefix PARSED_PREFIXES[] = {
+    {"account-hash-", KeyIdentifier::Account},
+    {"hash-", KeyIdentifier::Hash},
+    {"uref-", KeyIdentifier::URef},
+    {"contract-package-wasm", KeyIdentifier::Hash},
+    {"contract-wasm-", KeyIdentifier::Hash},
+    {"contract-", KeyIdentifier::Hash},
+    {"transfer-", KeyIdentifier::Transfer},
+    {"deploy-", KeyIdentifier::DeployInfo},
+    {"dictionary-", KeyIdentifier::Dictionary},
+    {"era-", KeyIdentifier::EraInfo},
+    {"balance-", KeyIdentifier::Balance},
+    {"bid-", KeyIdentifier::Bid},
+    {"withdraw-", KeyIdentifier::Withdraw}};
+
+int HexValue(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
 }
 
-GlobalStateKey::GlobalStateKey() {}
-/// <summary>
-/// Constructor for the GlobalStateKey class.
-/// </summary>
-GlobalStateKey::GlobalStateKey(std::string key_)
-    : key{key_}, raw_bytes{_GetRawBytesFromKey(key_)} {}
-
-/// <summary>
-/// Constructor for the GlobalStateKey class with key prefix.
-/// </summary>
-GlobalStateKey::GlobalStateKey(std::string key_, std::string key_prefix) {
-  if (key_.rfind(key_prefix, 0) != 0)
-    throw std::invalid_argument(
-        "Key not valid. It should start with '{key_prefix}'.");
-  CBytes res = CEP57Checksum::Decode(key_.substr(key_.find_last_of('-') + 1));
-  key = key_prefix + CEP57Checksum::Encode(res);
-  raw_bytes = _GetRawBytesFromKey(key);
+/// Decodes the hexadecimal text to bytes of half its size. Returns true if the
+/// text mixes lower and upper case letters, so it has a CEP-57 checksum.
+bool DecodeHex(std::string_view hex, uint8_t* bytes) {
+  bool lower = false, upper = false;
+  for (size_t i = 0; i < hex.size(); i++) {
+    int value = HexValue(hex[i]);
+    if (value < 0) {
+      throw std::invalid_argument("Key not valid. Invalid hex character.");
+    }
+    lower |= hex[i] >= 'a';
+    upper |= hex[i] >= 'A' && hex[i] <= 'F';
+    if (i % 2 == 0) {
+      bytes[i / 2] = uint8_t(value << 4);
+    } else {
+      bytes[i / 2] |= uint8_t(value);
+    }
+  }
+  return lower && upper;
 }
 
-std::string GlobalStateKey::ToHexString() {
-  //
-  return CEP57Checksum::Encode(raw_bytes);
+/// Appends the access rights of a URef as three digits, like "007".
+void AppendAccessRights(std::string& key, AccessRights access_rights) {
+  uint8_t value = static_cast<uint8_t>(access_rights);
+  key += char('0' + value / 100);
+  key += char('0' + value / 10 % 10);
+  key += char('0' + value % 10);
 }
+}  // namespace
 
-GlobalStateKey GlobalStateKey::FromString(std::string value) {
-  if (StringUtil::startsWith(value, "account-hash-"))
-    return AccountHashKey(value);
-  if (StringUtil::startsWith(value, "hash-")) return HashKey(value);
+GlobalStateKey::GlobalStateKey() {}
 
-  if (StringUtil::startsWith(value, "contract-package-wasm")) {
-    std::string new_value = value;
-    std::string prefix = "contract-package-wasm";
-    size_t pos = new_value.find(prefix);
-    new_value.replace(pos, prefix.length(), "hash-");
-    return HashKey(new_value);
+GlobalStateKey::GlobalStateKey(std::string_view key_) {
+  const ParsedPrefix* prefix = nullptr;
+  for (const ParsedPrefix& candidate : PARSED_PREFIXES) {
+    if (key_.substr(0, candidate.text.size()) == candidate.text) {
+      prefix = &candidate;
+      break;
+    }
+  }
+  if (prefix == nullptr) {
+    throw std::invalid_argument("Key not valid. Unknown key prefix.");
+  }
+  key_identifier = prefix->key_identifier;
+  std::string_view value = key_.substr(prefix->text.size());
+  std::string_view prefix_text = PREFIXES[size_t(key_identifier)];
+
+  if (key_identifier == KeyIdentifier::EraInfo) {
+    uint64_t era_id = 0;
+    auto [end, error] =
+        std::from_chars(value.data(), value.data() + value.size(), era_id);
+    if (value.empty() || error != std::errc() ||
+        end != value.data() + value.size()) {
+      throw std::invalid_argument("Key not valid. Cannot parse era number.");
+    }
+    raw_bytes.New(ERA_ID_SIZE);
+    for (size_t i = 0; i < ERA_ID_SIZE; i++) {
+      raw_bytes[i] = uint8_t(era_id >> (i * 8));
+    }
+    key.append(prefix_text).append(std::to_string(era_id));
+    return;
   }
-  if (StringUtil::startsWith(value, "contract-wasm-")) {
-    std::string new_value = value;
-    std::string prefix = "contract-wasm-";
-    size_t pos = new_value.find(prefix);
-    new_value.replace(pos, prefix.length(), "hash-");
-    return HashKey(new_value);
+
+  if (key_identifier == KeyIdentifier::URef) {
+    // 32 bytes, then the 3 digit access rights suffix
+    if (value.size() != ADDRESS_SIZE * 2 + 4 ||
+        value[ADDRESS_SIZE * 2] != '-') {
+      throw std::invalid_argument(
+          "Key not valid. A URef must contain a 32 byte value and a 3 digit "
+          "access rights suffix.");
+    }
+    unsigned int rights = 0;
+    for (char c : value.substr(ADDRESS_SIZE * 2 + 1)) {
+      if (c < '0' || c > '9') {
+        throw std::invalid_argument("Key not valid. Invalid access rights.");
+      }
+      rights = rights * 10 + (c - '0');
+    }
+    if (rights > static_cast<uint8_t>(AccessRights::READ_ADD_WRITE)) {
+      throw std::invalid_argument("Key not valid. Invalid access rights.");
+    }
+    access_rights = static_cast<AccessRights>(rights);
+    value = value.substr(0, ADDRESS_SIZE * 2);
+  } else if (value.size() != ADDRESS_SIZE * 2) {
+    throw std::invalid_argument("Key not valid. It should contain 32 bytes.");
   }
-  if (StringUtil::startsWith(value, "contract-")) {
-    std::string new_value = value;
-    std::string prefix = "contract-";
-    size_t pos = new_value.find(prefix);
-    new_value.replace(pos, prefix.length(), "hash-");
-    return HashKey(new_value);
+
+  raw_bytes.New(ADDRESS_SIZE);
+  bool has_checksum = DecodeHex(value, raw_bytes.data());
+  std::string encoded = CEP57Checksum::Encode(raw_bytes.data(), ADDRESS_SIZE);
+  if (has_checksum && encoded != value) {
+    throw std::invalid_argument("Key not valid. Invalid checksum.");
   }
 
-  if (StringUtil::startsWith(value, "uref-")) return URef(value);
-  if (StringUtil::startsWith(value, "transfer-")) return TransferKey(value);
-  if (StringUtil::startsWith(value, "deploy-")) return DeployInfoKey(value);
-  if (StringUtil::startsWith(value, "era-")) return EraInfoKey(value);
-  if (StringUtil::startsWith(value, "balance-")) return BalanceKey(value);
-  if (StringUtil::startsWith(value, "bid")) return BidKey(value);
-  if (StringUtil::startsWith(value, "withdraw")) return WithdrawKey(value);
-  if (StringUtil::startsWith(value, "dictionary")) return DictionaryKey(value);
+  key.reserve(prefix_text.size() + encoded.size() + 4);
+  key.append(prefix_text).append(encoded);
+  if (key_identifier == KeyIdentifier::URef) {
+    key += '-';
+    AppendAccessRights(key, access_rights);
+  }
+}
 
-  throw std::invalid_argument("Key not valid. Unknown key prefix.");
+GlobalStateKey::GlobalStateKey(std::string_view key_,
+                               KeyIdentifier key_identifier_)
+    : GlobalStateKey(key_) {
+  if (key_identifier != key_identifier_) {
+    throw std::invalid_argument(
+        "Key not valid. It should start with '" +
+        std::string(PREFIXES[size_t(key_identifier_)]) + "'.");
+  }
+}
+
+GlobalStateKey::GlobalStateKey(KeyIdentifier key_identifier_,
+                               const uint8_t* bytes, size_t size,
+                               AccessRights access_rights_)
+    : key_identifier(key_identifier_), access_rights(access_rights_) {
+  if (size_t(key_identifier) >= std::size(PREFIXES)) {
+    throw std::invalid_argument("Key not valid. Unknown key prefix.");
+  }
+  size_t expected_size = key_identifier == KeyIdentifier::EraInfo
+                             ? ERA_ID_SIZE
+                             : ADDRESS_SIZE;
+  if (size != expected_size) {
+    throw std::invalid_argument("Key not valid. Wrong number of bytes.");
+  }
+  raw_bytes.Assign(bytes, size);
+
+  std::string_view prefix_text = PREFIXES[size_t(key_identifier)];
+  if (key_identifier == KeyIdentifier::EraInfo) {
+    uint64_t era_id = 0;
+    for (size_t i = 0; i < ERA_ID_SIZE; i++) {
+      era_id |= uint64_t(bytes[i]) << (i * 8);
+    }
+    key.append(prefix_text).append(std::to_string(era_id));
+    return;
+  }
+
+  key.reserve(prefix_text.size() + size * 2 + 4);
+  key.append(prefix_text).append(CEP57Checksum::Encode(bytes, size));
+  if (key_identifier == KeyIdentifier::URef) {
+    key += '-';
+    AppendAccessRights(key, access_rights);
+  }
+}
+
+std::string GlobalStateKey::ToHexString() const {
+  return CEP57Checksum::Encode(raw_bytes);
+}
+
+GlobalStateKey GlobalStateKey::FromString(std::string_view value) {
+  return GlobalStateKey(value);
 }
 
 GlobalStateKey GlobalStateKey::FromBytes(const CBytes& bytes) {
-  CBytes new_bytes(bytes.size() - 1);
-  std::copy(bytes.begin() + 1, bytes.end(), new_bytes.begin());
-  uint64_t era_number = *(uint64_t*)new_bytes.begin();
-
-  switch (bytes[0]) {
-    case 0x00:
-      return AccountHashKey("account-hash-" + CryptoUtil::hexEncode(new_bytes));
-    case 0x01:
-      return HashKey("hash-" + CryptoUtil::hexEncode(new_bytes));
-    case 0x02:
-      return URef("uref-" + CEP57Checksum::Encode(new_bytes));
-    case 0x03:
-      return TransferKey("transfer-" + CEP57Checksum::Encode(new_bytes));
-    case 0x04:
-      return DeployInfoKey("deploy-" + CEP57Checksum::Encode(new_bytes));
-    case 0x05:
-      return EraInfoKey("era-" + std::to_string(era_number));
-    case 0x06:
-      return BalanceKey("balance-" + CEP57Checksum::Encode(new_bytes));
-    case 0x07:
-      return BidKey("bid-" + CEP57Checksum::Encode(new_bytes));
-    case 0x08:
-      return WithdrawKey("withdraw-" + CEP57Checksum::Encode(new_bytes));
-    case 0x09:
-      return DictionaryKey("dictionary-" + CEP57Checksum::Encode(new_bytes));
-    default:
-      throw std::invalid_argument("Key not valid. Unknown key prefix.");
+  return FromBytes(bytes.data(), bytes.size());
+}
+
+GlobalStateKey GlobalStateKey::FromBytes(const uint8_t* bytes, size_t size) {
+  if (size == 0) {
+    throw std::invalid_argument("Key not valid. Missing key identifier.");
   }
+  KeyIdentifier key_identifier = static_cast<KeyIdentifier>(bytes[0]);
+
+  // the access rights of a URef follow its address
+  if (key_identifier == KeyIdentifier::URef) {
+    if (size != ADDRESS_SIZE + 2) {
+      throw std::invalid_argument("Key not valid. Wrong number of bytes.");
+    }
+    return GlobalStateKey(key_identifier, bytes + 1, ADDRESS_SIZE,
+                          static_cast<AccessRights>(bytes[ADDRESS_SIZE + 1]));
+  }
+  return GlobalStateKey(key_identifier, bytes + 1, size - 1);
 }
 
-CBytes GlobalStateKey::GetBytes() {
-  CBytes ms(this->raw_bytes.size() + 1);
-  ms[0] = static_cast<uint8_t>(this->key_identifier);
-  std::copy(this->raw_bytes.begin(), this->raw_bytes.end(), ms.begin() + 1);
+CBytes GlobalStateKey::GetBytes() const {
+  bool is_uref = key_identifier == KeyIdentifier::URef;
+  CBytes ms(1 + raw_bytes.size() + is_uref);
+  ms[0] = static_cast<uint8_t>(key_identifier);
+  std::copy(raw_bytes.begin(), raw_bytes.end(), ms.begin() + 1);
+  if (is_uref) ms[ms.size() - 1] = static_cast<uint8_t>(access_rights);
   return ms;
 }
 
-std::string GlobalStateKey::ToString() { return this->key; }
-// GlobalStateKey
+std::string GlobalStateKey::ToString() const { return key; }
 
 bool GlobalStateKey::operator<(const GlobalStateKey& other) const {
   return this->key < other.key;
@@ -130,103 +245,89 @@ bool GlobalStateKey::operator!=(const GlobalStateKey& other) const {
 }
 
 AccountHashKey::AccountHashKey(std::string key)
-    : GlobalStateKey::GlobalStateKey(key, "account-hash-") {
-  key_identifier = KeyIdentifier::Account;
-}
+    : GlobalStateKey::GlobalStateKey(key, KeyIdentifier::Account) {}
 
 AccountHashKey::AccountHashKey(PublicKey publicKey)
     : GlobalStateKey::GlobalStateKey(publicKey.GetAccountHash(),
-                                     "account-hash-") {}
+                                     KeyIdentifier::Account) {}
 
 HashKey::HashKey(std::string key)
-    : GlobalStateKey::GlobalStateKey(key, "hash-") {
-  key_identifier = KeyIdentifier::Hash;
-}
+    : GlobalStateKey::GlobalStateKey(key, KeyIdentifier::Hash) {}
 
 HashKey::HashKey(CBytes key)
-    : HashKey::HashKey("hash-" + CEP57Checksum::Encode(key)) {}
+    : GlobalStateKey::GlobalStateKey(KeyIdentifier::Hash, key.data(),
+                                     key.size()) {}
 
 TransferKey::TransferKey(std::string key)
-    : GlobalStateKey::GlobalStateKey(key, "transfer-") {
-  key_identifier = KeyIdentifier::Transfer;
-}
+    : GlobalStateKey::GlobalStateKey(key, KeyIdentifier::Transfer) {}
 
 TransferKey::TransferKey(CBytes key)
-    : TransferKey::TransferKey("transfer-" + CEP57Checksum::Encode(key)) {}
+    : GlobalStateKey::GlobalStateKey(KeyIdentifier::Transfer, key.data(),
+                                     key.size()) {}
 
 DeployInfoKey::DeployInfoKey(std::string key)
-    : GlobalStateKey::GlobalStateKey(key, "deploy-") {
-  key_identifier = KeyIdentifier::DeployInfo;
-}
+    : GlobalStateKey::GlobalStateKey(key, KeyIdentifier::DeployInfo) {}
 
 DeployInfoKey::DeployInfoKey(CBytes key)
-    : DeployInfoKey::DeployInfoKey("deploy-" + CEP57Checksum::Encode(key)) {}
-
-EraInfoKey::EraInfoKey(std::string key) : GlobalStateKey::GlobalStateKey(key) {
-  key_identifier = KeyIdentifier::EraInfo;
-  if (!StringUtil::startsWith(key, "era-"))
-    throw std::invalid_argument("EraInfoKey must start with 'era-'");
-
-  int64_t era_num;
-  try {
-    std::istringstream iss(key.substr(4));
-    iss >> era_num;
-  } catch (std::exception& e) {
-    throw std::invalid_argument("Key not valid. Cannot parse era number.");
-  }
-}
+    : GlobalStateKey::GlobalStateKey(KeyIdentifier::DeployInfo, key.data(),
+                                     key.size()) {}
 
-CBytes EraInfoKey::GetBytes() {
-  CBytes ms(9);
-  ms[0] = uint8_t(this->key_identifier);
-  std::copy(ms.begin() + 1, ms.end(), raw_bytes.begin());
-  return ms;
-}
-
-CBytes EraInfoKey::_GetRawBytesFromKey(std::string key) {
-  uint64_t u64;
-  std::istringstream iss(key.substr(4));
-  iss >> u64;
-
-  CBytes bytes(8);
-  std::copy(reinterpret_cast<uint8_t*>(&u64),
-            reinterpret_cast<uint8_t*>(&u64) + 8, bytes.begin());
-
-  // TODOMS3: Check endianness
-  // if (!BitConverter.IsLittleEndian) Array.Reverse(bytes);
-
-  return bytes;
-}
+EraInfoKey::EraInfoKey(std::string key)
+    : GlobalStateKey::GlobalStateKey(key, KeyIdentifier::EraInfo) {}
 
 BalanceKey::BalanceKey(std::string key)
-    : GlobalStateKey::GlobalStateKey(key, "balance-") {
-  key_identifier = KeyIdentifier::Balance;
-}
+    : GlobalStateKey::GlobalStateKey(key, KeyIdentifier::Balance) {}
 
 BalanceKey::BalanceKey(CBytes key)
-    : BalanceKey::BalanceKey("balance-" + CEP57Checksum::Encode(key)) {}
+    : GlobalStateKey::GlobalStateKey(KeyIdentifier::Balance, key.data(),
+                                     key.size()) {}
 
-BidKey::BidKey(std::string key) : GlobalStateKey::GlobalStateKey(key, "bid-") {
-  key_identifier = KeyIdentifier::Bid;
-}
+BidKey::BidKey(std::string key)
+    : GlobalStateKey::GlobalStateKey(key, KeyIdentifier::Bid) {}
 
 BidKey::BidKey(CBytes key)
-    : BidKey::BidKey("bid-" + CEP57Checksum::Encode(key)) {}
+    : GlobalStateKey::GlobalStateKey(KeyIdentifier::Bid, key.data(),
+                                     key.size()) {}
 
 WithdrawKey::WithdrawKey(std::string key)
-    : GlobalStateKey::GlobalStateKey(key, "withdraw-") {
-  key_identifier = KeyIdentifier::Withdraw;
-}
+    : GlobalStateKey::GlobalStateKey(key, KeyIdentifier::Withdraw) {}
 
 WithdrawKey::WithdrawKey(CBytes key)
-    : WithdrawKey::WithdrawKey("withdraw-" + CEP57Checksum::Encode(key)) {}
+    : GlobalStateKey::GlobalStateKey(KeyIdentifier::Withdraw, key.data(),
+                                     key.size()) {}
 
 DictionaryKey::DictionaryKey(std::string key)
-    : GlobalStateKey::GlobalStateKey(key, "dictionary-") {
-  key_identifier = KeyIdentifier::Dictionary;
-}
+    : GlobalStateKey::GlobalStateKey(key, KeyIdentifier::Dictionary) {}
+
 DictionaryKey::DictionaryKey(CBytes key)
-    : DictionaryKey::DictionaryKey("dictionary-" + CEP57Checksum::Encode(key)) {
+    : GlobalStateKey::GlobalStateKey(KeyIdentifier::Dictionary, key.data(),
+                                     key.size()) {}
+
+DictionaryKey DictionaryKey::FromSeedURef(
+    const URef& seed_uref, const std::string& dictionary_item_key) {
+  CryptoPP::BLAKE2b hasher(32u);
+  hasher.Update(seed_uref.raw_bytes, seed_uref.raw_bytes.size());
+  hasher.Update(
+      reinterpret_cast<const CryptoPP::byte*>(dictionary_item_key.data()),
+      dictionary_item_key.size());
+
+  CBytes address(hasher.DigestSize());
+  hasher.Final(address);
+
+  return DictionaryKey(address);
+}
+
+std::vector<DictionaryKey> DictionaryKey::ListFromSeedURef(
+    const URef& seed_uref,
+    const std::vector<std::string>& dictionary_item_keys) {
+  std::vector<DictionaryKey> keys;
+  keys.reserve(dictionary_item_keys.size());
+
+  for (auto& dictionary_item_key : dictionary_item_keys) {
+    keys.push_back(FromSeedURef(seed_uref, dictionary_item_key));
+  }
+
+  return keys;
 }
 
 }  // namespace Casper
\ No newline at end of file
@@ -1,6 +1,9 @@
 #pragma once
 
+#include <string_view>
+
 #include "Base.h"
+#include "Types/AccessRights.h"
 #include "Types/PublicKey.h"
 #include "magic_enum/magic_enum.hpp"
 // Crypto
@@ -10,6 +13,8 @@
 #include "nlohmann/json.hpp"
 
 namespace Casper {
+struct URef;
+
 /// <summary>
 /// Keys in the global state store information about different data types.
 /// <see
@@ -63,38 +68,46 @@ enum class KeyIdentifier {
 };
 
 /// <summary>
-/// Base class for the different global state keys.
+/// Base class for the different global state keys. A key is the tag of its
+/// type and its raw bytes, with the access rights of a URef, so the derived
+/// types add no state and a key keeps its value when copied as a
+/// GlobalStateKey.
 /// </summary>
 struct GlobalStateKey {
+  /// The formatted key, like "hash-" and the checksummed hexadecimal bytes.
   std::string key;
-
- public:
-  KeyIdentifier key_identifier;
+  KeyIdentifier key_identifier = KeyIdentifier::Account;
+  /// 32 bytes address, or the little-endian u64 era number of an EraInfo key.
   CBytes raw_bytes;
+  /// Access rights of a URef key, NONE for the other keys.
+  AccessRights access_rights = AccessRights::NONE;
 
- protected:
-  virtual CBytes _GetRawBytesFromKey(std::string key);
-
- public:
   GlobalStateKey();
 
   /// <summary>
-  /// Constructor for the GlobalStateKey class.
+  /// Parses a key of any type, see FromString.
   /// </summary>
-  GlobalStateKey(std::string key_);
+  GlobalStateKey(std::string_view key_);
 
   /// <summary>
-  /// Constructor for the GlobalStateKey class with key prefix.
+  /// Parses a key that must be of the given type.
   /// </summary>
-  GlobalStateKey(std::string key_, std::string key_prefix);
-
-  std::string ToHexString();
+  GlobalStateKey(std::string_view key_, KeyIdentifier key_identifier_);
 
   /// <summary>
-  /// Converts a global state key from string to its specific key object.
+  /// Creates a key from its type and raw bytes, with the access rights for a
+  /// URef.
   /// </summary>
+  GlobalStateKey(KeyIdentifier key_identifier_, const uint8_t* bytes,
+                 size_t size, AccessRights access_rights_ = AccessRights::NONE);
 
-  static GlobalStateKey FromString(std::string value);
+  std::string ToHexString() const;
+
+  /// <summary>
+  /// Converts a global state key from string to its specific key object, in a
+  /// single pass over the text. The contract prefixes are Hash keys.
+  /// </summary>
+  static GlobalStateKey FromString(std::string_view value);
 
   /// <summary>
   /// Converts a global state key from a byte array to its specific key object.
@@ -102,13 +115,18 @@ struct GlobalStateKey {
   /// </summary>
   static GlobalStateKey FromBytes(const CBytes& bytes);
 
-  virtual CBytes GetBytes();
+  static GlobalStateKey FromBytes(const uint8_t* bytes, size_t size);
 
   /// <summary>
-  /// Converts a key object to a string with the right prefix
+  /// Returns the key identifier and the raw bytes, then the access rights for
+  /// a URef.
   /// </summary>
+  CBytes GetBytes() const;
 
-  std::string ToString();
+  /// <summary>
+  /// Converts a key object to a string with the right prefix
+  /// </summary>
+  std::string ToString() const;
 
   bool operator<(const GlobalStateKey& other) const;
 
@@ -163,11 +181,6 @@ struct DeployInfoKey : public GlobalStateKey {
 /// </summary>
 struct EraInfoKey : public GlobalStateKey {
   EraInfoKey(std::string key);
-
-  CBytes GetBytes() override;
-
- protected:
-  CBytes _GetRawBytesFromKey(std::string key) override;
 };
 
 /// <summary>
@@ -208,6 +221,21 @@ struct DictionaryKey : public GlobalStateKey {
   DictionaryKey(std::string key);
 
   DictionaryKey(CBytes key);
+
+  /// <summary>
+  /// Derives the key of a dictionary item locally from the seed URef of the
+  /// dictionary and the item key, as the node does:
+  /// blake2b256(seed URef address || item key bytes).
+  /// </summary>
+  static DictionaryKey FromSeedURef(const URef& seed_uref,
+                                    const std::string& dictionary_item_key);
+
+  /// <summary>
+  /// Derives the keys of several items of the same dictionary.
+  /// </summary>
+  static std::vector<DictionaryKey> ListFromSeedURef(
+      const URef& seed_uref,
+      const std::vector<std::string>& dictionary_item_keys);
 };
 
 /**
@@ -231,8 +259,6 @@ inline void to_json(nlohmann::json& j, const GlobalStateKey& p) {
  * @param p GlobalStateKey object to construct.
  */
 inline void from_json(const nlohmann::json& j, GlobalStateKey& p) {
-  std::string jKey = j.at("key");
-
-  p = GlobalStateKey::FromString(j.at("key").get<std::string>());
+  p = GlobalStateKey::FromString(j.at("key").get_ref<const std::string&>());
 }
 }  // namespace Casper
\ No newline at end of file
@@ -147,7 +147,7 @@ struct KeyPair {
   /// Signs a message and returns the signature.
   /// </summary>
   CBytes Sign(CBytes message) {
-    if (public_key.key_algorithm == KeyAlgo::ED25519) {
+    if (public_key.GetKeyAlgorithm() == KeyAlgo::ED25519) {
       CBytes signature;  // = new byte[Ed25519.SignatureSize];
       // var sk = (Ed25519PrivateKeyParameters)_privateKey;
       // Ed25519.Sign(sk.GetEncoded(), 0, message, 0, message.Length, signature,
@@ -156,7 +156,7 @@ struct KeyPair {
       return signature;
     }
 
-    if (public_key.key_algorithm == KeyAlgo::SECP256K1) {
+    if (public_key.GetKeyAlgorithm() == KeyAlgo::SECP256K1) {
       //   SecureRandom k = new SecureRandom();
       //   ParametersWithRandom param = new ParametersWithRandom(_privateKey,
       //   k);
@@ -1,13 +1,19 @@
 #pragma once
 #include <cctype>
 #include <iostream>
+#include <memory>
 #include <vector>
 
 #include "Types/KeyAlgo.h"
 #include "Utils/CEP57Checksum.h"
 #include "Utils/File.h"
+#include "Utils/Log.h"
 #include "Utils/StringUtil.h"
+#include "Utils/ThreadUtil.h"
+#include "cryptopp/eccrypto.h"
+#include "cryptopp/oids.h"
 #include "cryptopp/pem.h"
+#include "cryptopp/xed25519.h"
 #include "nlohmann/json.hpp"
 
 namespace Casper {
@@ -22,6 +28,67 @@ struct PublicKey {
   CBytes raw_bytes;
   KeyAlgo key_algorithm;
 
+ private:
+  /// <summary>
+  /// Key bytes including the Key algorithm identifier, and the formatted
+  /// account hash ("account-hash-..."), with the key they were derived from.
+  /// </summary>
+  struct DerivedValues {
+    CBytes raw_bytes;
+    KeyAlgo key_algorithm;
+    CBytes bytes;
+    std::string account_hash;
+  };
+
+  /// Computed on first use and shared by the copies of the key. Recomputed
+  /// when the public fields no longer match it. Read and written atomically,
+  /// so that const keys can be used from several threads.
+  mutable std::shared_ptr<const DerivedValues> derived;
+
+  static uint8_t GetAlgorithmIdentifier(KeyAlgo key_algorithm) {
+    if (key_algorithm == KeyAlgo::ED25519) return 0x01;
+    if (key_algorithm == KeyAlgo::SECP256K1) return 0x02;
+    return 0x00;
+  }
+
+  static std::string ComputeAccountHash(const CBytes& raw_bytes,
+                                        KeyAlgo key_algorithm) {
+    // The algorithm name is plain ASCII, hash its characters as they are.
+    std::string algo_str = KeyAlgo::GetName(key_algorithm);
+
+    CryptoPP::BLAKE2b bcBl2bdigest(32u);
+    bcBl2bdigest.Update(reinterpret_cast<const CryptoPP::byte*>(algo_str.data()),
+                        algo_str.size());
+    const CryptoPP::byte separator = 0x00;
+    bcBl2bdigest.Update(&separator, 1);
+    bcBl2bdigest.Update(raw_bytes, raw_bytes.size());
+
+    CBytes hash(bcBl2bdigest.DigestSize());
+    bcBl2bdigest.Final(hash);
+
+    return "account-hash-" + CEP57Checksum::Encode(hash);
+  }
+
+  std::shared_ptr<const DerivedValues> GetDerivedValues() const {
+    std::shared_ptr<const DerivedValues> current = std::atomic_load(&derived);
+    if (current != nullptr && current->key_algorithm == key_algorithm &&
+        current->raw_bytes == raw_bytes) {
+      return current;
+    }
+
+    auto computed = std::make_shared<DerivedValues>();
+    computed->raw_bytes = raw_bytes;
+    computed->key_algorithm = key_algorithm;
+    computed->bytes.New(raw_bytes.size() + 1);
+    computed->bytes[0] = GetAlgorithmIdentifier(key_algorithm);
+    std::copy(raw_bytes.begin(), raw_bytes.end(), computed->bytes.begin() + 1);
+    computed->account_hash = ComputeAccountHash(raw_bytes, key_algorithm);
+
+    current = std::move(computed);
+    std::atomic_store(&derived, current);
+    return current;
+  }
+
  protected:
   PublicKey(CBytes raw_bytes_, KeyAlgo key_algorithm_)
       : raw_bytes(raw_bytes_), key_algorithm(key_algorithm_) {}
@@ -44,7 +111,7 @@ struct PublicKey {
         throw std::invalid_argument("Wrong public algorithm identifier.");
       }
     } catch (std::exception& e) {
-      std::cerr << e.what() << std::endl;
+      CASPER_LOG_WARNING("PublicKey::FromHexString: " << e.what());
     }
     return Casper::PublicKey();
   }
@@ -82,8 +149,8 @@ struct PublicKey {
         return PublicKey(rawBytes, KeyAlgo::ED25519);
       }
     } catch (std::exception& e) {
-      std::cerr << "Unsupported key format or it's not a public key PEM object."
-                << std::endl;
+      CASPER_LOG_ERROR(
+          "Unsupported key format or it's not a public key PEM object.");
     }
   }
 
@@ -132,14 +199,12 @@ struct PublicKey {
     try {
       int expectedPublicKeySize = KeyAlgo::GetKeySizeInBytes(keyAlgo) - 1;
       if (rawBytes.size() != expectedPublicKeySize) {
-        std::cout << "Bytes size: " << rawBytes.size() << std::endl;
-
         throw std::runtime_error(
             "Wrong public key format. Expected length is " +
             std::to_string(expectedPublicKeySize));
       }
     } catch (std::exception& e) {
-      std::cout << e.what() << std::endl;
+      CASPER_LOG_WARNING("PublicKey::FromRawBytes: " << e.what());
     }
     return Casper::PublicKey(rawBytes, keyAlgo);
   }
@@ -188,25 +253,21 @@ struct PublicKey {
   /// Returns the Account Hash associated to this Public Key.
   /// </summary>
   std::string GetAccountHash() const {
-    CBytes sb;
-    std::string algo_str = KeyAlgo::GetName(key_algorithm);
-    CryptoPP::SecByteBlock algo_bytes =
-        hexDecode(StringUtil::getStringBytesWithoutLength(algo_str));
-    CBytes interm_byte(1);
-    interm_byte[0] = 0;
-
-    sb += algo_bytes;
-    sb += interm_byte;
-    sb += raw_bytes;
-
-    CryptoPP::BLAKE2b bcBl2bdigest(32u);
-    bcBl2bdigest.Update(sb, sb.size());
-    // std::cout << "ComputeBodyHash3" << std::endl;
-
-    CBytes hash(bcBl2bdigest.DigestSize());
-    bcBl2bdigest.Final(hash);
+    return GetDerivedValues()->account_hash;
+  }
 
-    return "account-hash-" + CEP57Checksum::Encode(hash);
+  /// <summary>
+  /// Returns the Account Hashes of the given Public Keys, in the same order.
+  /// The keys are split between worker threads, use 0 to pick the number of
+  /// threads from the hardware.
+  /// </summary>
+  static std::vector<std::string> GetAccountHashes(
+      const std::vector<Casper::PublicKey>& keys, unsigned int threads = 0) {
+    std::vector<std::string> hashes(keys.size());
+    ThreadUtil::ParallelFor(keys.size(), threads, [&](size_t i) {
+      hashes[i] = keys[i].GetAccountHash();
+    });
+    return hashes;
   }
 
   /// <summary>
@@ -234,56 +295,56 @@ struct PublicKey {
   /// Returns the bytes of the public key, including the Key algorithm as the
   /// first byte.
   /// </summary>
-  CBytes GetBytes() {
-    CBytes bytes = CBytes(raw_bytes.size() + 1);
-
-    if (key_algorithm == KeyAlgo::ED25519) {
-      bytes[0] = 0x01;
-    } else if (key_algorithm == KeyAlgo::SECP256K1) {
-      bytes[0] = 0x02;
-    } else {
-      bytes[0] = 0x00;
-    }
+  CBytes GetBytes() const { return GetDerivedValues()->bytes; }
 
-    std::copy(raw_bytes.begin(), raw_bytes.end(), bytes.begin() + 1);
+  /// <summary>
+  /// Returns the bytes of the public key, without the Key algorithm.
+  /// </summary>
+  const CBytes& GetRawBytes() const { return raw_bytes; }
 
-    return bytes;
-  }
+  KeyAlgo GetKeyAlgorithm() const { return key_algorithm; }
 
   /// <summary>
   /// Verifies the signature given its value and the original message.
+  /// Secp256k1 signatures are checked as ECDSA over the SHA-256 of the message.
   /// </summary>
-  bool VerifySignature(CBytes message, CBytes signature) {
-    /*
+  bool VerifySignature(const CBytes& message, const CBytes& signature) const {
     if (key_algorithm == KeyAlgo::ED25519) {
-      Ed25519PublicKeyParameters edPk =
-          new Ed25519PublicKeyParameters(RawBytes, 0);
-      return Ed25519.Verify(signature, 0, RawBytes, 0, message, 0,
-                            message.Length);
+      if (raw_bytes.size() != CryptoPP::ed25519PublicKey::PUBLIC_KEYLENGTH ||
+          signature.size() != CryptoPP::ed25519Verifier::SIGNATURE_LENGTH) {
+        return false;
+      }
+
+      CryptoPP::ed25519Verifier verifier(raw_bytes.data());
+      return verifier.VerifyMessage(message.data(), message.size(),
+                                    signature.data(), signature.size());
     }
 
     if (key_algorithm == KeyAlgo::SECP256K1) {
-      var curve = ECNamedCurveTable.GetByName("secp256k1");
-      var domainParams = new ECDomainParameters(curve.Curve, curve.G, curve.N,
-                                                curve.H, curve.GetSeed());
-
-      ECPoint q = curve.Curve.DecodePoint(RawBytes);
-      ECPublicKeyParameters pk = new ECPublicKeyParameters(q, domainParams);
+      CryptoPP::ECDSA<CryptoPP::ECP, CryptoPP::SHA256>::PublicKey public_key;
+      public_key.AccessGroupParameters().Initialize(
+          CryptoPP::ASN1::secp256k1());
+
+      CryptoPP::ECP::Point q;
+      if (!public_key.GetGroupParameters().GetCurve().DecodePoint(
+              q, raw_bytes.data(), raw_bytes.size())) {
+        return false;
+      }
+      public_key.SetPublicElement(q);
 
-      var signer = SignerUtilities.GetSigner("SHA-256withPLAIN-ECDSA");
-      signer.Init(forSigning : false, pk);
-      signer.BlockUpdate(message, 0, message.Length);
-      return signer.VerifySignature(signature);
+      CryptoPP::ECDSA<CryptoPP::ECP, CryptoPP::SHA256>::Verifier verifier(
+          public_key);
+      return verifier.VerifyMessage(message.data(), message.size(),
+                                    signature.data(), signature.size());
     }
-*/
-    throw std::runtime_error("Not implemented VerifySignature()");
+
     throw std::runtime_error("Unsupported key type.");
   }
 
   /// <summary>
   /// Verifies the signature given its value and the original message.
   /// </summary>
-  bool VerifySignature(std::string message, std::string signature) {
+  bool VerifySignature(std::string message, std::string signature) const {
     return VerifySignature(hexDecode(message), hexDecode(signature));
   }
 
@@ -5,6 +5,7 @@
 #include "cryptopp/files.h"
 #include "cryptopp/pem.h"
 #include "Utils/CEP57Checksum.h"
+#include "Utils/Log.h"
 namespace Casper {
 
 Secp256k1Key::Secp256k1Key(std::string pem_file_path) {
@@ -86,13 +87,9 @@ CryptoPP::SecByteBlock Secp256k1Key::sign(
     siglen = signer.SignMessage(prng, (const CryptoPP::byte*)&message[0],
                                 message.size(), sig_bytes);
     sig_bytes.resize(siglen);
-
-    std::cout << "sig bytes while loop\n";
-
   } while ((sig_bytes[32] & 0x80) == 0x80);
 
-  std::cout << "signature size: " << sig_bytes.size() << std::endl;
-  std::cout << "aftter sig decode: " << sig_bytes.size() << std::endl;
+  CASPER_LOG_DEBUG("SECP256K1 signature size: " << sig_bytes.size());
   return sig_bytes;
 }
 
@@ -106,11 +103,8 @@ bool Secp256k1Key::verify(std::string message, std::string signature) {
       (const CryptoPP::byte*)&message[0], message.size(),
       (const CryptoPP::byte*)&signature[0], signature.size());
 
-  if (result) {
-    std::cout << "SECP256K1 signature is successfully verified" << std::endl;
-  } else {
-    std::cout << "Failed to verify SECP256K1 Signature" << std::endl;
-  }
+  CASPER_LOG_DEBUG("SECP256K1 signature verification: " << std::boolalpha
+                                                         << result);
 
   return result;
 }
@@ -4,6 +4,7 @@
 #include "Types/KeyAlgo.h"
 #include "Utils/CEP57Checksum.h"
 #include "Utils/CryptoUtil.h"
+#include "Utils/Log.h"
 #include "cryptopp/hex.h"
 #include "cryptopp/secblock.h"
 
@@ -44,7 +45,7 @@ struct Signature {
         throw std::invalid_argument("Invalid key algorithm identifier.");
       }
     } catch (const std::exception& e) {
-      std::cout << "FromHexString() Exception: " << e.what() << '\n';
+      CASPER_LOG_WARNING("Signature::FromHexString: " << e.what());
     }
     return Signature();
   }
@@ -83,7 +84,7 @@ struct Signature {
   /// Returns the bytes of the signature, including the Key algorithm as the
   /// first byte.
   /// </summary>
-  CBytes GetBytes() {
+  CBytes GetBytes() const {
     CBytes bytes = CBytes(raw_bytes.size() + 1);
     if (key_algorithm == KeyAlgo::ED25519) {
       bytes[0] = 0x01;
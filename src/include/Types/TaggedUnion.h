@@ -0,0 +1,102 @@
+#pragma once
+
+#include <array>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <variant>
+
+#include "nlohmann/json.hpp"
+
+namespace Casper {
+/// <summary>
+/// Maps a std::variant to the JSON of the enums of the node, tagged with the
+/// name of their variant: {"Transfer": {...}}, or just "Identity" for a variant
+/// without a value, held as std::monostate. The names are in the order of the
+/// alternatives, and the alternatives are selected by index so several of
+/// them may have the same type.
+/// </summary>
+struct TaggedUnion {
+  template <typename Variant, size_t N>
+  static void ToJson(nlohmann::json& j, const Variant& value,
+                     const std::string_view (&names)[N]) {
+    static_assert(N == std::variant_size_v<Variant>,
+                  "one name for each alternative");
+    static constexpr auto WRITERS =
+        MakeWriters<Variant>(std::make_index_sequence<N>());
+    WRITERS[value.index()](j, names[value.index()], value);
+  }
+
+  /// <summary>
+  /// Reads the first member of the object, or the string, that names an
+  /// alternative. Throws std::runtime_error if there is none.
+  /// </summary>
+  template <typename Variant, size_t N>
+  static void FromJson(const nlohmann::json& j, Variant& value,
+                       const std::string_view (&names)[N]) {
+    static_assert(N == std::variant_size_v<Variant>,
+                  "one name for each alternative");
+    static constexpr auto READERS =
+        MakeReaders<Variant>(std::make_index_sequence<N>());
+
+    if (j.is_string()) {
+      const std::string& name = j.get_ref<const std::string&>();
+      size_t index = Find(names, name);
+      if (index != N) return READERS[index](j, value);
+      throw std::runtime_error("Unknown variant " + name);
+    }
+
+    for (auto it = j.begin(); j.is_object() && it != j.end(); ++it) {
+      size_t index = Find(names, it.key());
+      if (index != N) return READERS[index](it.value(), value);
+    }
+    throw std::runtime_error("Unknown variant in " + j.dump());
+  }
+
+ private:
+  template <size_t N>
+  static size_t Find(const std::string_view (&names)[N],
+                     std::string_view name) {
+    for (size_t i = 0; i < N; i++) {
+      if (names[i] == name) return i;
+    }
+    return N;
+  }
+
+  template <typename Variant, size_t I>
+  static void Write(nlohmann::json& j, std::string_view name,
+                    const Variant& value) {
+    if constexpr (std::is_same_v<std::variant_alternative_t<I, Variant>,
+                                 std::monostate>) {
+      j = name;
+    } else {
+      j = nlohmann::json::object();
+      j[std::string(name)] = std::get<I>(value);
+    }
+  }
+
+  template <typename Variant, size_t I>
+  static void Read(const nlohmann::json& j, Variant& value) {
+    if constexpr (std::is_same_v<std::variant_alternative_t<I, Variant>,
+                                 std::monostate>) {
+      value.template emplace<I>();
+    } else {
+      j.get_to(value.template emplace<I>());
+    }
+  }
+
+  template <typename Variant, size_t... I>
+  static constexpr auto MakeWriters(std::index_sequence<I...>) {
+    using Writer = void (*)(nlohmann::json&, std::string_view, const Variant&);
+    return std::array<Writer, sizeof...(I)>{&Write<Variant, I>...};
+  }
+
+  template <typename Variant, size_t... I>
+  static constexpr auto MakeReaders(std::index_sequence<I...>) {
+    using Reader = void (*)(const nlohmann::json&, Variant&);
+    return std::array<Reader, sizeof...(I)>{&Read<Variant, I>...};
+  }
+};
+
+}  // namespace Casper
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "nlohmann/json.hpp"
+
+namespace Casper {
+/// <summary>
+/// Time in milliseconds since the Unix epoch, like the timestamp of a deploy.
+/// Its text is in the RFC 3339 format of the node, like
+/// "2021-12-13T12:00:00.000Z".
+/// </summary>
+struct Timestamp {
+  uint64_t milliseconds = 0;
+
+  /// Length of the text written by Write.
+  static constexpr size_t TEXT_SIZE = 24;
+
+  Timestamp() {}
+
+  explicit Timestamp(uint64_t milliseconds_) : milliseconds(milliseconds_) {}
+
+  /// <summary>
+  /// Returns the current time.
+  /// </summary>
+  static Timestamp Now() {
+    return Timestamp(std::chrono::duration_cast<std::chrono::milliseconds>(
+                         std::chrono::system_clock::now().time_since_epoch())
+                         .count());
+  }
+
+  /// <summary>
+  /// Parses a UTC time like "2021-12-13T12:00:00.000Z". The fraction of a
+  /// second is optional and truncated to milliseconds. Returns false if the
+  /// text is not such a time.
+  /// </summary>
+  static bool TryParse(std::string_view text, Timestamp& timestamp) {
+    // YYYY-MM-DDTHH:MM:SS, then an optional fraction and Z
+    if (text.size() < 20 || text[4] != '-' || text[7] != '-' ||
+        (text[10] != 'T' && text[10] != 't' && text[10] != ' ') ||
+        text[13] != ':' || text[16] != ':') {
+      return false;
+    }
+    int64_t year, month, day, hour, minute, second;
+    if (!ReadDigits(text, 0, 4, year) || !ReadDigits(text, 5, 2, month) ||
+        !ReadDigits(text, 8, 2, day) || !ReadDigits(text, 11, 2, hour) ||
+        !ReadDigits(text, 14, 2, minute) ||
+        !ReadDigits(text, 17, 2, second)) {
+      return false;
+    }
+    if (year < 1970 || month < 1 || month > 12 || day < 1 ||
+        day > DaysInMonth(year, month) || hour > 23 || minute > 59 ||
+        second > 60) {
+      return false;
+    }
+
+    size_t position = 19;
+    uint64_t fraction = 0;
+    if (text[position] == '.') {
+      size_t digits = 0;
+      for (position++; position < text.size() && text[position] >= '0' &&
+                       text[position] <= '9';
+           position++, digits++) {
+        if (digits < 3) fraction = fraction * 10 + (text[position] - '0');
+      }
+      if (digits == 0) return false;
+      for (; digits < 3; digits++) fraction *= 10;
+    }
+    if (position + 1 != text.size() ||
+        (text[position] != 'Z' && text[position] != 'z')) {
+      return false;
+    }
+
+    int64_t days = DaysFromCivil(year, month, day);
+    timestamp.milliseconds =
+        uint64_t(((days * 24 + hour) * 60 + minute) * 60 + second) * 1000 +
+        fraction;
+    return true;
+  }
+
+  /// <summary>
+  /// Parses a UTC time, see TryParse. Throws std::invalid_argument if the
+  /// text is not such a time.
+  /// </summary>
+  static Timestamp Parse(std::string_view text) {
+    Timestamp timestamp;
+    if (!TryParse(text, timestamp)) {
+      throw std::invalid_argument("Invalid timestamp: " + std::string(text));
+    }
+    return timestamp;
+  }
+
+  /// <summary>
+  /// Writes the time like "2021-12-13T12:00:00.000Z" to a buffer of at least
+  /// TEXT_SIZE characters, without a terminating zero. Returns TEXT_SIZE.
+  /// </summary>
+  size_t Write(char* buffer) const {
+    uint64_t seconds = milliseconds / 1000;
+    int64_t year, month, day;
+    CivilFromDays(int64_t(seconds / 86400), year, month, day);
+
+    WriteDigits(buffer, year, 4);
+    buffer[4] = '-';
+    WriteDigits(buffer + 5, month, 2);
+    buffer[7] = '-';
+    WriteDigits(buffer + 8, day, 2);
+    buffer[10] = 'T';
+    WriteDigits(buffer + 11, seconds % 86400 / 3600, 2);
+    buffer[13] = ':';
+    WriteDigits(buffer + 14, seconds % 3600 / 60, 2);
+    buffer[16] = ':';
+    WriteDigits(buffer + 17, seconds % 60, 2);
+    buffer[19] = '.';
+    WriteDigits(buffer + 20, milliseconds % 1000, 3);
+    buffer[23] = 'Z';
+    return TEXT_SIZE;
+  }
+
+  std::string ToString() const {
+    char buffer[TEXT_SIZE];
+    return std::string(buffer, Write(buffer));
+  }
+
+  bool operator==(const Timestamp& other) const {
+    return milliseconds == other.milliseconds;
+  }
+
+  bool operator!=(const Timestamp& other) const { return !(*this == other); }
+
+  bool operator<(const Timestamp& other) const {
+    return milliseconds < other.milliseconds;
+  }
+
+ private:
+  static bool ReadDigits(std::string_view text, size_t position, size_t count,
+                         int64_t& value) {
+    value = 0;
+    for (size_t i = position; i < position + count; i++) {
+      if (text[i] < '0' || text[i] > '9') return false;
+      value = value * 10 + (text[i] - '0');
+    }
+    return true;
+  }
+
+  static void WriteDigits(char* buffer, uint64_t value, size_t count) {
+    for (size_t i = count; i-- > 0;) {
+      buffer[i] = char('0' + value % 10);
+      value /= 10;
+    }
+  }
+
+  static int64_t DaysInMonth(int64_t year, int64_t month) {
+    static constexpr int64_t DAYS[] = {31, 28, 31, 30, 31, 30,
+                                       31, 31, 30, 31, 30, 31};
+    bool leap = (year % 4 == 0 && year % 100 != 0) || year % 400 == 0;
+    return month == 2 && leap ? 29 : DAYS[month - 1];
+  }
+
+  /// Days since 1970-01-01 of a date of the proleptic Gregorian calendar,
+  /// from Howard Hinnant's chrono-compatible algorithms.
+  static int64_t DaysFromCivil(int64_t year, int64_t month, int64_t day) {
+    year -= month <= 2;
+    int64_t era = (year >= 0 ? year : year - 399) / 400;
+    int64_t year_of_era = year - era * 400;
+    int64_t day_of_year = (153 * (month + (month > 2 ? -3 : 9)) + 2) / 5 +
+                          day - 1;
+    int64_t day_of_era = year_of_era * 365 + year_of_era / 4 -
+                         year_of_era / 100 + day_of_year;
+    return era * 146097 + day_of_era - 719468;
+  }
+
+  static void CivilFromDays(int64_t days, int64_t& year, int64_t& month,
+                            int64_t& day) {
+    days += 719468;
+    int64_t era = (days >= 0 ? days : days - 146096) / 146097;
+    int64_t day_of_era = days - era * 146097;
+    int64_t year_of_era = (day_of_era - day_of_era / 1460 +
+                           day_of_era / 36524 - day_of_era / 146096) /
+                          365;
+    int64_t day_of_year = day_of_era - (365 * year_of_era + year_of_era / 4 -
+                                        year_of_era / 100);
+    int64_t month_index = (5 * day_of_year + 2) / 153;
+    day = day_of_year - (153 * month_index + 2) / 5 + 1;
+    month = month_index < 10 ? month_index + 3 : month_index - 9;
+    year = year_of_era + era * 400 + (month <= 2);
+  }
+};
+
+inline void to_json(nlohmann::json& j, const Timestamp& p) {
+  j = p.ToString();
+}
+
+inline void from_json(const nlohmann::json& j, Timestamp& p) {
+  p = Timestamp::Parse(j.get_ref<const std::string&>());
+}
+
+}  // namespace Casper
@@ -25,7 +25,6 @@ struct TransferDeployItem {
     // std::cout << "after target" << std::endl;
 
     if (!has_id) {
-      std::cout << "id == -1" << std::endl;
       args.push_back(
           NamedArg("id", CLValue::OptionNone(CLType(CLTypeEnum::U64))));
 
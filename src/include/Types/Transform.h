@@ -1,7 +1,8 @@
 #pragma once
 
 #include "Base.h"
-#include <optional>
+#include <string_view>
+#include <variant>
 
 #include "nlohmann/json.hpp"
 
@@ -11,190 +12,131 @@
 #include "Types/DeployInfo.h"
 #include "Types/EraInfo.h"
 #include "Types/NamedKey.h"
+#include "Types/TaggedUnion.h"
 #include "Types/Transfer.h"
 #include "Types/UnbondingPurse.h"
 
 namespace Casper {
-/// The actual transformation performed while executing a deploy.
-struct Transform {
+/// Type of a Transform, the index of its alternative.
+enum class TransformType {
   /// A transform having no effect.
-  std::optional<std::string> Identity = std::nullopt;
+  Identity = 0,
   /// Writes the given CLValue to global state.
-  std::optional<CLValue> WriteCLValue = std::nullopt;
+  WriteCLValue = 1,
   /// Writes the given Account to global state.
-  std::optional<std::string> WriteAccount = std::nullopt;
+  WriteAccount = 2,
   /// Writes a smart contract as Wasm to global state.
-  std::optional<std::string> WriteContractWasm = std::nullopt;
+  WriteContractWasm = 3,
   /// Writes a smart contract to global state.
-  std::optional<std::string> WriteContract = std::nullopt;
+  WriteContract = 4,
   /// Writes a smart contract package to global state.
-  std::optional<std::string> WriteContractPackage = std::nullopt;
+  WriteContractPackage = 5,
   /// Writes the given DeployInfo to global state.
-  std::optional<DeployInfo> WriteDeployInfo = std::nullopt;
+  WriteDeployInfo = 6,
   /// Writes the given EraInfo to global state.
-  std::optional<EraInfo> WriteEraInfo = std::nullopt;
+  WriteEraInfo = 7,
   /// Writes the given Transfer to global state.
-  std::optional<Transfer> WriteTransfer = std::nullopt;
+  WriteTransfer = 8,
   /// Writes the given Bid to global state.
-  std::optional<Bid> WriteBid = std::nullopt;
+  WriteBid = 9,
   /// Writes the given Withdraw to global state.
-  std::optional<std::vector<UnbondingPurse>> WriteWithdraw = std::nullopt;
+  WriteWithdraw = 10,
   /// Adds the given `i32`.
-  std::optional<int32_t> AddInt32 = std::nullopt;
+  AddInt32 = 11,
   /// Adds the given `u64`.
-  std::optional<uint64_t> AddUInt64 = std::nullopt;
+  AddUInt64 = 12,
   /// Adds the given `U128`.
-  std::optional<uint128_t> AddUInt128 = std::nullopt;
+  AddUInt128 = 13,
   /// Adds the given `U256`.
-  std::optional<uint256_t> AddUInt256 = std::nullopt;
+  AddUInt256 = 14,
   /// Adds the given `U512`.
-  std::optional<uint512_t> AddUInt512 = std::nullopt;
+  AddUInt512 = 15,
   /// Adds the given collection of named keys.
-  std::optional<std::vector<NamedKey>> AddKeys = std::nullopt;
+  AddKeys = 16,
   /// A failed transformation, containing an error message.
-  std::optional<std::string> Failure = std::nullopt;
+  Failure = 17
 };
 
-// to_json of Transform
-inline void to_json(nlohmann::json& j, const Transform& p) {
-  if (p.WriteCLValue.has_value()) {
-    j["WriteCLValue"] = p.WriteCLValue.value();
-  }
-
-  if (p.WriteAccount.has_value()) {
-    j["WriteAccount"] = p.WriteAccount.value();
-  }
-
-  if (p.WriteContractWasm.has_value()) {
-    j["WriteContractWasm"] = p.WriteContractWasm.value();
-  }
-
-  if (p.WriteContract.has_value()) {
-    j["WriteContract"] = p.WriteContract.value();
-  }
-
-  if (p.WriteContractPackage.has_value()) {
-    j["WriteContractPackage"] = p.WriteContractPackage.value();
-  }
-
-  if (p.WriteDeployInfo.has_value()) {
-    j["WriteDeployInfo"] = p.WriteDeployInfo.value();
-  }
-
-  if (p.WriteEraInfo.has_value()) {
-    j["WriteEraInfo"] = p.WriteEraInfo.value();
-  }
-
-  if (p.WriteTransfer.has_value()) {
-    j["WriteTransfer"] = p.WriteTransfer.value();
-  }
-
-  if (p.WriteBid.has_value()) {
-    j["WriteBid"] = p.WriteBid.value();
-  }
-
-  if (p.WriteWithdraw.has_value()) {
-    j["WriteWithdraw"] = p.WriteWithdraw.value();
-  }
-
-  if (p.AddInt32.has_value()) {
-    j["AddInt32"] = p.AddInt32.value();
-  }
-
-  if (p.AddUInt64.has_value()) {
-    j["AddUInt64"] = p.AddUInt64.value();
-  }
-
-  if (p.AddUInt128.has_value()) {
-    j["AddUInt128"] = u128ToDec(p.AddUInt128.value());
-  }
-
-  if (p.AddUInt256.has_value()) {
-    j["AddUInt256"] = u256ToDec(p.AddUInt256.value());
-  }
-
-  if (p.AddUInt512.has_value()) {
-    j["AddUInt512"] = u512ToDec(p.AddUInt512.value());
-  }
-
-  if (p.AddKeys.has_value()) {
-    j["AddKeys"] = p.AddKeys.value();
+/// The actual transformation performed while executing a deploy. It holds the
+/// value of one TransformType, Identity by default.
+struct Transform {
+  std::variant<std::monostate, CLValue, std::string, std::string, std::string,
+               std::string, DeployInfo, EraInfo, Transfer, Bid,
+               std::vector<UnbondingPurse>, int32_t, uint64_t, uint128_t,
+               uint256_t, uint512_t, std::vector<NamedKey>, std::string>
+      value;
+
+  /// JSON names of the types, in the order of TransformType.
+  static constexpr std::string_view NAMES[] = {"Identity",
+                                               "WriteCLValue",
+                                               "WriteAccount",
+                                               "WriteContractWasm",
+                                               "WriteContract",
+                                               "WriteContractPackage",
+                                               "WriteDeployInfo",
+                                               "WriteEraInfo",
+                                               "WriteTransfer",
+                                               "WriteBid",
+                                               "WriteWithdraw",
+                                               "AddInt32",
+                                               "AddUInt64",
+                                               "AddUInt128",
+                                               "AddUInt256",
+                                               "AddUInt512",
+                                               "AddKeys",
+                                               "Failure"};
+
+  Transform() {}
+
+  /// <summary>
+  /// Creates a transform of the type, like
+  /// Transform::Make<TransformType::AddUInt512>(amount).
+  /// </summary>
+  template <TransformType T, typename... Args>
+  static Transform Make(Args&&... args) {
+    Transform transform;
+    transform.value.emplace<size_t(T)>(std::forward<Args>(args)...);
+    return transform;
+  }
+
+  TransformType GetType() const { return TransformType(value.index()); }
+
+  /// <summary>
+  /// Returns the value of the type, like Get<TransformType::AddUInt512>().
+  /// Throws std::bad_variant_access if it is of another type.
+  /// </summary>
+  template <TransformType T>
+  auto& Get() {
+    return std::get<size_t(T)>(value);
+  }
+
+  template <TransformType T>
+  const auto& Get() const {
+    return std::get<size_t(T)>(value);
+  }
+
+  /// <summary>
+  /// Returns the value of the type, or nullptr if it is of another type.
+  /// </summary>
+  template <TransformType T>
+  auto* GetIf() {
+    return std::get_if<size_t(T)>(&value);
+  }
+
+  template <TransformType T>
+  const auto* GetIf() const {
+    return std::get_if<size_t(T)>(&value);
   }
+};
 
-  if (p.Failure.has_value()) {
-    j["Failure"] = p.Failure.value();
-  }
+// to_json of Transform
+inline void to_json(nlohmann::json& j, const Transform& p) {
+  TaggedUnion::ToJson(j, p.value, Transform::NAMES);
 }
 
 // from_json of Transform
 inline void from_json(const nlohmann::json& j, Transform& p) {
-  if (j.find("WriteCLValue") != j.end()) {
-    p.WriteCLValue = j["WriteCLValue"].get<CLValue>();
-  }
-
-  if (j.find("WriteAccount") != j.end()) {
-    p.WriteAccount = j.at("WriteAccount").get<std::string>();
-  }
-
-  if (j.find("WriteContractWasm") != j.end()) {
-    p.WriteContractWasm = j.at("WriteContractWasm").get<std::string>();
-  }
-
-  if (j.find("WriteContract") != j.end()) {
-    p.WriteContract = j.at("WriteContract").get<std::string>();
-  }
-
-  if (j.find("WriteContractPackage") != j.end()) {
-    p.WriteContractPackage = j.at("WriteContractPackage").get<std::string>();
-  }
-
-  if (j.find("WriteDeployInfo") != j.end()) {
-    p.WriteDeployInfo = j.at("WriteDeployInfo").get<DeployInfo>();
-  }
-
-  if (j.find("WriteEraInfo") != j.end()) {
-    p.WriteEraInfo = j.at("WriteEraInfo").get<EraInfo>();
-  }
-
-  if (j.find("WriteTransfer") != j.end()) {
-    p.WriteTransfer = j.at("WriteTransfer").get<Transfer>();
-  }
-
-  if (j.find("WriteBid") != j.end()) {
-    p.WriteBid = j.at("WriteBid").get<Bid>();
-  }
-
-  if (j.find("WriteWithdraw") != j.end()) {
-    p.WriteWithdraw = j.at("WriteWithdraw").get<std::vector<UnbondingPurse>>();
-  }
-
-  if (j.find("AddInt32") != j.end()) {
-    p.AddInt32 = j.at("AddInt32").get<int32_t>();
-  }
-
-  if (j.find("AddUInt64") != j.end()) {
-    p.AddUInt64 = j.at("AddUInt64").get<uint64_t>();
-  }
-
-  if (j.find("AddUInt128") != j.end()) {
-    p.AddUInt128 = u128FromDec(j.at("AddUInt128").get<std::string>());
-  }
-
-  if (j.find("AddUInt256") != j.end()) {
-    p.AddUInt256 = u256FromDec(j.at("AddUInt256").get<std::string>());
-  }
-
-  if (j.find("AddUInt512") != j.end()) {
-    p.AddUInt512 = u512FromDec(j.at("AddUInt512").get<std::string>());
-  }
-
-  if (j.find("AddKeys") != j.end()) {
-    p.AddKeys = j.at("AddKeys").get<std::vector<NamedKey>>();
-  }
-
-  if (j.find("Failure") != j.end()) {
-    p.Failure = j.at("Failure").get<std::string>();
-  }
+  TaggedUnion::FromJson(j, p.value, Transform::NAMES);
 }
 
 }  // namespace Casper
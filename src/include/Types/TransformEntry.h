@@ -22,23 +22,13 @@ struct TransformEntry {
 inline void to_json(nlohmann::json& j, const TransformEntry& p) {
   j = nlohmann::json{};
   j["key"] = p.key;
-
-  if (p.transform.Identity.has_value()) {
-    j["transform"] = p.transform.Identity.value();
-  } else {
-    j["transform"] = p.transform;
-  }
+  j["transform"] = p.transform;
 }
 
 // from_json of TransformEntry
 inline void from_json(const nlohmann::json& j, TransformEntry& p) {
   j.at("key").get_to(p.key);
-  if (j.at("transform").is_string() &&
-      j.at("transform").get<std::string>() == "Identity") {
-    p.transform.Identity = "Identity";
-  } else {
-    j.at("transform").get_to(p.transform);
-  }
+  j.at("transform").get_to(p.transform);
 }
 
 }  // namespace Casper
@@ -0,0 +1,313 @@
+#include "Types/TrieMerkleProof.h"
+
+#include <array>
+#include <cstring>
+
+#include "cryptopp/blake2.h"
+
+namespace Casper {
+namespace {
+constexpr const size_t DIGEST_LENGTH = 32;
+constexpr const size_t RADIX = 256;
+
+/// Trie node tags.
+constexpr const uint8_t TRIE_LEAF = 0;
+constexpr const uint8_t TRIE_NODE = 1;
+constexpr const uint8_t TRIE_EXTENSION = 2;
+
+/// Pointer tags.
+constexpr const uint8_t LEAF_POINTER = 0;
+constexpr const uint8_t NODE_POINTER = 1;
+
+/// Proof step tags.
+constexpr const uint8_t STEP_NODE = 0;
+constexpr const uint8_t STEP_EXTENSION = 1;
+
+/// Serialized length of a pointer: tag and digest.
+constexpr const size_t POINTER_LENGTH = 1 + DIGEST_LENGTH;
+
+/// Deepest CLType nesting accepted in a proven value, so that a hostile
+/// proof cannot exhaust the stack.
+constexpr const int MAX_CL_TYPE_DEPTH = 64;
+
+/// Reads the proof bytes in place, without copying them.
+struct ProofReader {
+  const CryptoPP::byte* data;
+  size_t size;
+  size_t pos = 0;
+
+  const CryptoPP::byte* Take(size_t count) {
+    if (count > size - pos) {
+      throw std::runtime_error("Merkle proof: unexpected end of data.");
+    }
+    const CryptoPP::byte* taken = data + pos;
+    pos += count;
+    return taken;
+  }
+
+  uint8_t ReadU8() { return *Take(1); }
+
+  uint32_t ReadU32() {
+    const CryptoPP::byte* b = Take(4);
+    return uint32_t(b[0]) | uint32_t(b[1]) << 8 | uint32_t(b[2]) << 16 |
+           uint32_t(b[3]) << 24;
+  }
+
+  void SkipBytes() { Take(ReadU32()); }
+
+  void SkipBigInteger() { Take(ReadU8()); }
+
+  void SkipKey() {
+    switch (ReadU8()) {
+      case 0x02:  // URef: address and access rights
+        Take(DIGEST_LENGTH + 1);
+        break;
+      case 0x05:  // EraInfo: u64 era id
+        Take(8);
+        break;
+      default:
+        Take(DIGEST_LENGTH);
+        break;
+    }
+  }
+
+  void SkipCLType(int depth = 0) {
+    if (depth >= MAX_CL_TYPE_DEPTH) {
+      throw std::invalid_argument("Merkle proof: CLType nested too deeply.");
+    }
+    switch (ReadU8()) {
+      case 13:  // Option
+      case 14:  // List
+        SkipCLType(depth + 1);
+        break;
+      case 15:  // ByteArray
+        Take(4);
+        break;
+      case 16:  // Result
+      case 17:  // Map
+      case 19:  // Tuple2
+        SkipCLType(depth + 1);
+        SkipCLType(depth + 1);
+        break;
+      case 18:  // Tuple1
+        SkipCLType(depth + 1);
+        break;
+      case 20:  // Tuple3
+        SkipCLType(depth + 1);
+        SkipCLType(depth + 1);
+        SkipCLType(depth + 1);
+        break;
+      default:
+        break;
+    }
+  }
+
+  template <typename Func>
+  void SkipList(Func skip_item) {
+    uint32_t count = ReadU32();
+    for (uint32_t i = 0; i < count; i++) skip_item();
+  }
+
+  void SkipNamedKeys() {
+    SkipList([this] {
+      SkipBytes();
+      SkipKey();
+    });
+  }
+
+  void SkipStoredValue() {
+    uint8_t tag = ReadU8();
+    switch (tag) {
+      case 0:  // CLValue
+        SkipBytes();
+        SkipCLType();
+        break;
+      case 1:  // Account
+        Take(DIGEST_LENGTH);
+        SkipNamedKeys();
+        Take(DIGEST_LENGTH + 1);
+        SkipList([this] { Take(DIGEST_LENGTH + 1); });
+        Take(2);
+        break;
+      case 2:  // ContractWasm
+        SkipBytes();
+        break;
+      case 3:  // Contract
+        Take(2 * DIGEST_LENGTH);
+        SkipNamedKeys();
+        SkipList([this] {
+          SkipBytes();
+          // entry point: name, args, return type, access, type
+          SkipBytes();
+          SkipList([this] {
+            SkipBytes();
+            SkipCLType();
+          });
+          SkipCLType();
+          if (ReadU8() == 1) SkipList([this] { SkipBytes(); });
+          Take(1);
+        });
+        Take(12);
+        break;
+      case 5:  // Transfer
+        Take(2 * DIGEST_LENGTH);
+        if (ReadU8() == 1) Take(DIGEST_LENGTH);
+        Take(2 * (DIGEST_LENGTH + 1));
+        SkipBigInteger();
+        SkipBigInteger();
+        if (ReadU8() == 1) Take(8);
+        break;
+      case 6:  // DeployInfo
+        Take(DIGEST_LENGTH);
+        SkipList([this] { Take(DIGEST_LENGTH); });
+        Take(DIGEST_LENGTH);
+        Take(DIGEST_LENGTH + 1);
+        SkipBigInteger();
+        break;
+      default:
+        throw std::invalid_argument(
+            "Merkle proof: unsupported stored value tag " +
+            std::to_string(tag) + ".");
+    }
+  }
+
+  /// Reads one proof and hashes it up to the state root hash.
+  TrieMerkleProof ReadProof() {
+    TrieMerkleProof proof;
+    CryptoPP::BLAKE2b hasher(32u);
+
+    // leaf: the key and the value are hashed as they are in the proof
+    size_t key_start = pos;
+    SkipKey();
+    size_t value_start = pos;
+    SkipStoredValue();
+
+    proof.key_bytes.Assign(data + key_start, value_start - key_start);
+    proof.value_bytes.Assign(data + value_start, pos - value_start);
+
+    std::array<CryptoPP::byte, DIGEST_LENGTH> hash;
+    hasher.Update(&TRIE_LEAF, 1);
+    hasher.Update(data + key_start, pos - key_start);
+    hasher.Final(hash.data());
+
+    // steps: the pointer to the hash so far fills the hole in each parent
+    std::array<CryptoPP::byte, POINTER_LENGTH> hole_pointer;
+    std::array<const CryptoPP::byte*, RADIX> node_pointers;
+
+    uint32_t step_count = ReadU32();
+    for (uint32_t step = 0; step < step_count; step++) {
+      hole_pointer[0] = step == 0 ? LEAF_POINTER : NODE_POINTER;
+      std::copy(hash.begin(), hash.end(), hole_pointer.begin() + 1);
+
+      uint8_t step_tag = ReadU8();
+      if (step_tag == STEP_NODE) {
+        node_pointers.fill(nullptr);
+        node_pointers[ReadU8()] = hole_pointer.data();
+
+        uint32_t pointer_count = ReadU32();
+        for (uint32_t i = 0; i < pointer_count; i++) {
+          uint8_t index = ReadU8();
+          node_pointers[index] = Take(POINTER_LENGTH);
+        }
+
+        // the node is serialized as a block of RADIX optional pointers
+        std::array<CryptoPP::byte, 1 + RADIX * (1 + POINTER_LENGTH)> node;
+        size_t length = 0;
+        node[length++] = TRIE_NODE;
+        for (auto pointer : node_pointers) {
+          if (pointer == nullptr) {
+            node[length++] = 0;
+          } else {
+            node[length++] = 1;
+            std::copy(pointer, pointer + POINTER_LENGTH,
+                      node.begin() + length);
+            length += POINTER_LENGTH;
+          }
+        }
+        hasher.Update(node.data(), length);
+      } else if (step_tag == STEP_EXTENSION) {
+        size_t affix_start = pos;
+        SkipBytes();
+
+        hasher.Update(&TRIE_EXTENSION, 1);
+        hasher.Update(data + affix_start, pos - affix_start);
+        hasher.Update(hole_pointer.data(), hole_pointer.size());
+      } else {
+        throw std::invalid_argument("Merkle proof: unknown proof step tag " +
+                                    std::to_string(step_tag) + ".");
+      }
+      hasher.Final(hash.data());
+    }
+
+    proof.state_root_hash.Assign(hash.data(), hash.size());
+    return proof;
+  }
+};
+}  // namespace
+
+TrieMerkleProof TrieMerkleProof::FromHex(const std::string& hex) {
+  CBytes bytes = hexDecode(hex);
+  ProofReader reader{bytes.data(), bytes.size()};
+
+  TrieMerkleProof proof = reader.ReadProof();
+  if (reader.pos != bytes.size()) {
+    throw std::runtime_error("Merkle proof: unexpected trailing data.");
+  }
+  return proof;
+}
+
+std::vector<TrieMerkleProof> TrieMerkleProof::ListFromHex(
+    const std::string& hex) {
+  CBytes bytes = hexDecode(hex);
+  ProofReader reader{bytes.data(), bytes.size()};
+
+  std::vector<TrieMerkleProof> proofs;
+  uint32_t proof_count = reader.ReadU32();
+  for (uint32_t i = 0; i < proof_count; i++) {
+    proofs.push_back(reader.ReadProof());
+  }
+  if (reader.pos != bytes.size()) {
+    throw std::runtime_error("Merkle proof: unexpected trailing data.");
+  }
+  return proofs;
+}
+
+GlobalStateKey TrieMerkleProof::GetKey() const {
+  return GlobalStateKey::FromBytes(key_bytes);
+}
+
+bool TrieMerkleProof::FindNamedKey(const std::string& name,
+                                   CBytes& named_key_bytes) const {
+  ProofReader reader{value_bytes.data(), value_bytes.size()};
+  switch (reader.ReadU8()) {
+    case 1:  // Account: account hash, then the named keys
+      reader.Take(DIGEST_LENGTH);
+      break;
+    case 3:  // Contract: package and wasm hashes, then the named keys
+      reader.Take(2 * DIGEST_LENGTH);
+      break;
+    default:
+      return false;
+  }
+
+  uint32_t count = reader.ReadU32();
+  for (uint32_t i = 0; i < count; i++) {
+    uint32_t name_length = reader.ReadU32();
+    const CryptoPP::byte* name_bytes = reader.Take(name_length);
+    size_t key_start = reader.pos;
+    reader.SkipKey();
+    if (name_length == name.size() &&
+        std::memcmp(name_bytes, name.data(), name_length) == 0) {
+      named_key_bytes.Assign(value_bytes.data() + key_start,
+                             reader.pos - key_start);
+      return true;
+    }
+  }
+  return false;
+}
+
+bool TrieMerkleProof::Verify(const std::string& expected_state_root_hash) const {
+  return hexDecode(expected_state_root_hash) == state_root_hash;
+}
+
+}  // namespace Casper
@@ -0,0 +1,62 @@
+#pragma once
+
+#include "Base.h"
+#include "Types/GlobalStateKey.h"
+
+namespace Casper {
+/// <summary>
+/// Merkle proof of a single global state entry, decoded from the
+/// "merkle_proof" hex string returned by the node. Only the entry and the
+/// state root hash it resolves to are kept, the proof steps are hashed while
+/// decoding.
+/// <see
+/// cref="https://docs.casperlabs.io/design/serialization-standard/"/>
+/// </summary>
+struct TrieMerkleProof {
+  /// <summary>
+  /// Serialized global state key of the entry, starting with the key tag.
+  /// </summary>
+  CBytes key_bytes;
+
+  /// <summary>
+  /// Serialized stored value of the entry, starting with the value tag.
+  /// </summary>
+  CBytes value_bytes;
+
+  /// <summary>
+  /// State root hash computed by hashing the entry up the trie.
+  /// </summary>
+  CBytes state_root_hash;
+
+  TrieMerkleProof() {}
+
+  /// <summary>
+  /// Decodes a single proof, as returned by "state_get_balance".
+  /// </summary>
+  static TrieMerkleProof FromHex(const std::string& hex);
+
+  /// <summary>
+  /// Decodes a list of proofs, as returned by "state_get_item" and
+  /// "state_get_dictionary_item".
+  /// </summary>
+  static std::vector<TrieMerkleProof> ListFromHex(const std::string& hex);
+
+  /// <summary>
+  /// Returns the global state key of the entry.
+  /// </summary>
+  GlobalStateKey GetKey() const;
+
+  /// <summary>
+  /// Finds the serialized key stored under the name in the named keys of the
+  /// proven Account or Contract. Returns false if the value has no such named
+  /// key.
+  /// </summary>
+  bool FindNamedKey(const std::string& name, CBytes& named_key_bytes) const;
+
+  /// <summary>
+  /// Returns true if the proof resolves to the given state root hash.
+  /// </summary>
+  bool Verify(const std::string& expected_state_root_hash) const;
+};
+
+}  // namespace Casper
@@ -0,0 +1,186 @@
+#include "Utils/BlockVerifier.h"
+
+#include <algorithm>
+#include <set>
+
+#include "ByteSerializers/BlockByteSerializer.h"
+#include "Utils/ThreadUtil.h"
+#include "cryptopp/blake2.h"
+
+namespace Casper {
+namespace {
+CBytes ComputeHash(const CBytes& bytes) {
+  CryptoPP::BLAKE2b hasher(32u);
+  hasher.Update(bytes, bytes.size());
+
+  CBytes hash(hasher.DigestSize());
+  hasher.Final(hash);
+  return hash;
+}
+}  // namespace
+
+CBytes BlockVerifier::ComputeHeaderHash(const BlockHeader& header) {
+  BlockByteSerializer serializer;
+  return ComputeHash(serializer.ToBytes(header));
+}
+
+CBytes BlockVerifier::ComputeBodyHash(const BlockBody& body) {
+  BlockByteSerializer serializer;
+  return ComputeHash(serializer.ToBytes(body));
+}
+
+bool BlockVerifier::VerifyHashes(const Block& block, std::string& message) {
+  message = "";
+
+  try {
+    CBytes computed_hash = ComputeBodyHash(block.body);
+    if (hexDecode(block.header.body_hash) != computed_hash) {
+      message =
+          "Computed Body Hash does not match value in block header. "
+          "Expected: " +
+          block.header.body_hash +
+          " Computed: " + CEP57Checksum::Encode(computed_hash);
+      return false;
+    }
+
+    computed_hash = ComputeHeaderHash(block.header);
+    if (hexDecode(block.hash) != computed_hash) {
+      message =
+          "Computed Hash does not match value in block. Expected: " +
+          block.hash + " Computed: " + CEP57Checksum::Encode(computed_hash);
+      return false;
+    }
+  } catch (std::exception& e) {
+    message = "Error serializing block " + block.hash + ": " + e.what();
+    return false;
+  }
+
+  return true;
+}
+
+bool BlockVerifier::VerifyProofs(const Block& block, std::string& message) {
+  message = "";
+
+  if (block.proofs.empty()) {
+    message = "Block " + block.hash + " has no finality signatures";
+    return false;
+  }
+
+  // finality signatures sign the block hash followed by the era id
+  CBytes signed_bytes = hexDecode(block.hash);
+  signed_bytes += hexDecode(u64Encode(block.header.era_id));
+
+  for (auto& proof : block.proofs) {
+    bool verified = false;
+    try {
+      verified = proof.public_key.VerifySignature(signed_bytes,
+                                                  proof.signature.raw_bytes);
+    } catch (std::exception& e) {
+      verified = false;
+    }
+
+    if (!verified) {
+      message = "Error verifying signature of block " + block.hash +
+                " with signer " + proof.public_key.ToString();
+      return false;
+    }
+  }
+
+  return true;
+}
+
+bool BlockVerifier::VerifyFinality(
+    const Block& block, const std::vector<ValidatorWeight>& validator_weights,
+    std::string& message) {
+  if (!VerifyProofs(block, message)) return false;
+
+  uint512_t total_weight = 0;
+  for (auto& validator : validator_weights) total_weight += validator.weight;
+
+  // each validator counts once, however many proofs it signed
+  uint512_t signed_weight = 0;
+  std::set<std::string> signers;
+  for (auto& proof : block.proofs) {
+    std::string signer = proof.public_key.GetAccountHash();
+    auto validator = std::find_if(
+        validator_weights.begin(), validator_weights.end(),
+        [&](const ValidatorWeight& weight) {
+          return weight.public_key.GetAccountHash() == signer;
+        });
+    if (validator == validator_weights.end()) {
+      message = "Block " + block.hash + " is signed by " +
+                proof.public_key.ToString() +
+                " which is not a validator of era " +
+                std::to_string(block.header.era_id);
+      return false;
+    }
+    if (signers.insert(signer).second) signed_weight += validator->weight;
+  }
+
+  if (signed_weight * 3 <= total_weight) {
+    message = "Block " + block.hash +
+              " is signed by a third or less of the validator weight of era " +
+              std::to_string(block.header.era_id);
+    return false;
+  }
+
+  return true;
+}
+
+bool BlockVerifier::Verify(
+    const Block& block, const std::vector<ValidatorWeight>& validator_weights,
+    std::string& message) {
+  return VerifyHashes(block, message) &&
+         VerifyFinality(block, validator_weights, message);
+}
+
+bool BlockVerifier::VerifyRange(
+    const std::vector<Block>& blocks,
+    const std::vector<ValidatorWeight>& validator_weights,
+    std::string& message, unsigned int threads) {
+  message = "";
+
+  // the validators of each block: the trusted ones for the first era, then
+  // those of the switch blocks, which are verified with their own era
+  std::vector<const std::vector<ValidatorWeight>*> block_validators(
+      blocks.size());
+  const std::vector<ValidatorWeight>* era_validators = &validator_weights;
+  for (size_t i = 0; i < blocks.size(); i++) {
+    if (i > 0 && blocks[i].header.era_id != blocks[i - 1].header.era_id) {
+      const std::optional<EraEnd>& era_end = blocks[i - 1].header.era_end;
+      if (!era_end.has_value() ||
+          blocks[i].header.era_id != blocks[i - 1].header.era_id + 1) {
+        message = "Block " + blocks[i].hash + " starts era " +
+                  std::to_string(blocks[i].header.era_id) +
+                  " without the switch block of the previous era";
+        return false;
+      }
+      era_validators = &era_end->next_era_validator_weights;
+    }
+    block_validators[i] = era_validators;
+  }
+
+  std::vector<std::string> messages(blocks.size());
+  ThreadUtil::ParallelFor(blocks.size(), threads, [&](size_t i) {
+    if (!Verify(blocks[i], *block_validators[i], messages[i])) return;
+
+    if (i > 0 && (blocks[i].header.height != blocks[i - 1].header.height + 1 ||
+                  hexDecode(blocks[i].header.parent_hash) !=
+                      hexDecode(blocks[i - 1].hash))) {
+      messages[i] = "Block " + blocks[i].hash + " at height " +
+                    std::to_string(blocks[i].header.height) +
+                    " is not a child of block " + blocks[i - 1].hash;
+    }
+  });
+
+  for (auto& block_message : messages) {
+    if (!block_message.empty()) {
+      message = block_message;
+      return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace Casper
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Base.h"
+#include "Types/Block.h"
+
+namespace Casper {
+/// <summary>
+/// Verifies blocks read from an untrusted node locally: the hashes are
+/// recomputed from the binary serialization of the block, the finality
+/// signatures are checked against the block hash and the validators of its
+/// era, and consecutive blocks must be linked by their parent hash.
+/// </summary>
+struct BlockVerifier {
+  /// <summary>
+  /// Computes the hash of the binary serialization of a block header.
+  /// </summary>
+  static CBytes ComputeHeaderHash(const BlockHeader& header);
+
+  /// <summary>
+  /// Computes the hash of the binary serialization of a block body.
+  /// </summary>
+  static CBytes ComputeBodyHash(const BlockBody& body);
+
+  /// <summary>
+  /// Checks the body hash in the header and the block hash.
+  /// </summary>
+  /// <param name="message">an output string with the hash that could not be
+  /// verified. empty if verification succeeds.</param>
+  static bool VerifyHashes(const Block& block, std::string& message);
+
+  /// <summary>
+  /// Checks that the block has proofs and that every proof is a valid
+  /// signature of the block hash and era id by its public key. The signers
+  /// are not checked against the validators, see VerifyFinality.
+  /// </summary>
+  /// <param name="message">an output string with the signer which signature
+  /// could not be verified. empty if verification succeeds.</param>
+  static bool VerifyProofs(const Block& block, std::string& message);
+
+  /// <summary>
+  /// Checks the proofs of a block, that every signer is a validator of the
+  /// era of the block and that the signers hold more than a third of the
+  /// total weight of the validators.
+  /// </summary>
+  /// <param name="validator_weights">trusted weights of the validators of
+  /// the era of the block, the next era weights of the switch block of the
+  /// previous era.</param>
+  /// <param name="message">an output string with the error. empty if
+  /// verification succeeds.</param>
+  static bool VerifyFinality(
+      const Block& block, const std::vector<ValidatorWeight>& validator_weights,
+      std::string& message);
+
+  /// <summary>
+  /// Checks the hashes and the finality of a block.
+  /// </summary>
+  static bool Verify(const Block& block,
+                     const std::vector<ValidatorWeight>& validator_weights,
+                     std::string& message);
+
+  /// <summary>
+  /// Verifies a range of blocks ordered by height on worker threads, and
+  /// checks that each block is the parent of the next one. The validators of
+  /// the later eras are those of the switch blocks of the range. Use 0
+  /// threads to pick the number of threads from the hardware.
+  /// </summary>
+  /// <param name="validator_weights">trusted weights of the validators of
+  /// the era of the first block.</param>
+  /// <param name="message">an output string with the error of the lowest
+  /// block that could not be verified. empty if verification
+  /// succeeds.</param>
+  static bool VerifyRange(const std::vector<Block>& blocks,
+                          const std::vector<ValidatorWeight>& validator_weights,
+                          std::string& message, unsigned int threads = 0);
+};
+
+}  // namespace Casper
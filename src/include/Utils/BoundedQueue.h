@@ -0,0 +1,99 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+namespace Casper {
+/// <summary>
+/// A blocking first-in first-out queue with a fixed capacity, shared between
+/// producer and consumer threads. Producers wait while the queue is full, so a
+/// slow consumer slows down the producer instead of growing the queue.
+/// </summary>
+template <typename T>
+class BoundedQueue {
+ public:
+  explicit BoundedQueue(size_t capacity) : mCapacity(capacity ? capacity : 1) {}
+
+  /// <summary>
+  /// Adds an item, waiting while the queue is full. Returns false if the
+  /// queue is closed.
+  /// </summary>
+  bool Push(T item) {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mNotFull.wait(lock, [this] { return mClosed || mItems.size() < mCapacity; });
+    if (mClosed) return false;
+
+    mItems.push_back(std::move(item));
+    mNotEmpty.notify_one();
+    return true;
+  }
+
+  /// <summary>
+  /// Removes the oldest item, waiting while the queue is empty. Returns false
+  /// once the queue is closed and drained.
+  /// </summary>
+  bool Pop(T& item) {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mNotEmpty.wait(lock, [this] { return mClosed || !mItems.empty(); });
+    return PopLocked(item);
+  }
+
+  /// <summary>
+  /// Removes the oldest item, waiting at most the given time for one. Returns
+  /// false if no item is available.
+  /// </summary>
+  template <typename Rep, typename Period>
+  bool TryPop(T& item, const std::chrono::duration<Rep, Period>& timeout) {
+    std::unique_lock<std::mutex> lock(mMutex);
+    mNotEmpty.wait_for(lock, timeout,
+                       [this] { return mClosed || !mItems.empty(); });
+    return PopLocked(item);
+  }
+
+  /// <summary>
+  /// Wakes up every waiting thread. Pushes fail from now on, the remaining
+  /// items can still be popped.
+  /// </summary>
+  void Close() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mClosed = true;
+    mNotEmpty.notify_all();
+    mNotFull.notify_all();
+  }
+
+  /// <summary>
+  /// Accepts pushes again after Close().
+  /// </summary>
+  void Open() {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mClosed = false;
+  }
+
+  size_t Size() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mItems.size();
+  }
+
+  size_t Capacity() const { return mCapacity; }
+
+ private:
+  bool PopLocked(T& item) {
+    if (mItems.empty()) return false;
+
+    item = std::move(mItems.front());
+    mItems.pop_front();
+    mNotFull.notify_one();
+    return true;
+  }
+
+  const size_t mCapacity;
+  std::deque<T> mItems;
+  bool mClosed = false;
+  mutable std::mutex mMutex;
+  std::condition_variable mNotEmpty;
+  std::condition_variable mNotFull;
+};
+
+}  // namespace Casper
@@ -5,24 +5,6 @@ constexpr const int SMALL_BYTES_COUNT = 75;
 constexpr const char HexChars[]{'0', '1', '2', '3', '4', '5', '6', '7',
                                 '8', '9', 'a', 'b', 'c', 'd', 'e', 'f'};
 
-CBytes CEP57Checksum::_bytes_to_nibbles(CBytes bytes) {
-  CBytes nibbles(bytes.size() * 2);
-  for (int i = 0; i < bytes.size(); i++) {
-    nibbles[i * 2] = (bytes.data()[i] & 0xF0) >> 4;
-    nibbles[i * 2 + 1] = bytes.data()[i] & 0x0F;
-  }
-  return nibbles;
-}
-
-std::vector<bool> CEP57Checksum::_bytes_to_bits_cycle(CBytes bytes) {
-  size_t bit_size = bytes.size() * 8;
-  std::vector<bool> bits(bit_size);
-  for (int i = 0, k = 0; i < bytes.size(); i++)
-    for (int j = 0; j < 8; j++)
-      bits[k++] = ((bytes.data()[i] >> j) & 0x01) == 0x01;
-  return bits;
-}
-
 bool CEP57Checksum::HasChecksum(std::string hex) {
   int mix = 0;
   for (auto& c : hex) {
@@ -38,39 +20,40 @@ bool CEP57Checksum::HasChecksum(std::string hex) {
   return mix > 2;
 }
 
-std::string CEP57Checksum::Encode(CBytes decoded) {
-  if (decoded.size() > SMALL_BYTES_COUNT) {
-    std::string encoded;
+std::string CEP57Checksum::Encode(const CBytes& decoded) {
+  return Encode(decoded.data(), decoded.size());
+}
 
-    CStringSource ss(decoded, decoded.size(), true,
-                    new CHexEncoder(new CStringSink(encoded))  // HexEncoder
-    );                                                       // StringSource
-    return encoded;
+std::string CEP57Checksum::Encode(const uint8_t* decoded, size_t size) {
+  std::string encoded(size * 2, '0');
+  for (size_t i = 0; i < size; i++) {
+    encoded[i * 2] = HexChars[decoded[i] >> 4];
+    encoded[i * 2 + 1] = HexChars[decoded[i] & 0x0F];
   }
 
-  CBytes nibbles = _bytes_to_nibbles(decoded);
+  if (size > SMALL_BYTES_COUNT) {
+    for (auto& c : encoded) {
+      if (c >= 'a' && c <= 'f') c = (char)(c - ('a' - 'A'));
+    }
+    return encoded;
+  }
 
+  // the letters are upper case where the bit of the hash cycling with them is
+  // set, there are at most 150 nibbles for the 256 bits of the hash
   CryptoPP::BLAKE2b hash(32u);
-  hash.Update(decoded.data(), decoded.size());
-  CBytes digest_bytes(hash.DigestSize());
-  hash.Final(digest_bytes.data());
-
-  std::vector<bool> hashBits = _bytes_to_bits_cycle(digest_bytes);
+  hash.Update(decoded, size);
+  uint8_t digest[32];
+  hash.Final(digest);
 
-  std::string encoded_bytes(nibbles.size(), '0');
-
-  int k = 0;
-  int i = 0;
-
-  for (auto& n : nibbles) {
-    char c = HexChars[n];
-    if ((c >= 'a' && c <= 'f') && hashBits[k++])
-      encoded_bytes[i++] = (char)(c - ('a' - 'A'));
-    else
-      encoded_bytes[i++] = c;
+  size_t k = 0;
+  for (auto& c : encoded) {
+    if (c >= 'a' && c <= 'f') {
+      if ((digest[k / 8] >> (k % 8)) & 0x01) c = (char)(c - ('a' - 'A'));
+      k++;
+    }
   }
 
-  return encoded_bytes;
+  return encoded;
 }
 
 CBytes CEP57Checksum::Decode(std::string encoded) {
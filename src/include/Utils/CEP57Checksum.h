@@ -18,15 +18,15 @@
 
 namespace Casper {
 class CEP57Checksum {
- private:
-  static CBytes _bytes_to_nibbles(CBytes bytes);
-
-  static std::vector<bool> _bytes_to_bits_cycle(CBytes bytes);
-
  public:
   static bool HasChecksum(std::string hex);
 
-  static std::string Encode(CBytes decoded);
+  static std::string Encode(const CBytes& decoded);
+
+  /// <summary>
+  /// Encodes bytes without copying them, like Encode.
+  /// </summary>
+  static std::string Encode(const uint8_t* decoded, size_t size);
 
   static CBytes Decode(std::string encoded);
 };
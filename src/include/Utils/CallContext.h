@@ -0,0 +1,251 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+
+#include "jsonrpccxx/common.hpp"
+
+namespace Casper {
+/// Error code of the calls that ran past their deadline.
+constexpr const int CALL_DEADLINE_EXCEEDED = -32004;
+/// Error code of the cancelled calls.
+constexpr const int CALL_CANCELLED = -32005;
+
+/// <summary>
+/// Priority class of the calls waiting for the rate limit of a node. The
+/// waiting calls are sent by priority, then in the order they were made.
+/// </summary>
+enum class CallPriority {
+  /// Latency sensitive calls, like sending deploys.
+  Interactive = 0,
+  Normal = 1,
+  /// Background calls, like backfilling blocks.
+  Bulk = 2
+};
+
+/// <summary>
+/// A flag shared between the caller and the calls it may cancel. Copies of a
+/// token share the same flag.
+/// </summary>
+class CancellationToken {
+ public:
+  CancellationToken() : mState(std::make_shared<State>()) {}
+
+  /// <summary>
+  /// Cancels the calls using the token and runs the registered callbacks.
+  /// </summary>
+  void Cancel() {
+    std::unique_lock<std::mutex> lock(mState->mutex);
+    if (mState->cancelled) return;
+    mState->cancelled = true;
+
+    // run one at a time outside the lock, so that Unregister can wait for
+    // the running one
+    while (!mState->callbacks.empty()) {
+      auto first = mState->callbacks.begin();
+      std::function<void()> callback = std::move(first->second);
+      mState->running_id = first->first;
+      mState->running_thread = std::this_thread::get_id();
+      mState->callbacks.erase(first);
+
+      lock.unlock();
+      callback();
+      lock.lock();
+
+      mState->running_id = 0;
+      mState->callback_done.notify_all();
+    }
+  }
+
+  bool IsCancelled() const {
+    std::lock_guard<std::mutex> lock(mState->mutex);
+    return mState->cancelled;
+  }
+
+  /// <summary>
+  /// Registers a callback run on cancellation, or right away if the token is
+  /// already cancelled. Returns an id to unregister it.
+  /// </summary>
+  size_t Register(std::function<void()> callback) const {
+    {
+      std::lock_guard<std::mutex> lock(mState->mutex);
+      if (!mState->cancelled) {
+        mState->callbacks[mState->next_id] = std::move(callback);
+        return mState->next_id++;
+      }
+    }
+    callback();
+    return 0;
+  }
+
+  /// <summary>
+  /// Unregisters a callback. Waits for the callback if a cancellation is
+  /// running it, so that it never runs after Unregister returns.
+  /// </summary>
+  void Unregister(size_t id) const {
+    std::unique_lock<std::mutex> lock(mState->mutex);
+    mState->callbacks.erase(id);
+    if (mState->running_thread != std::this_thread::get_id()) {
+      mState->callback_done.wait(
+          lock, [this, id] { return mState->running_id != id; });
+    }
+  }
+
+ private:
+  struct State {
+    std::mutex mutex;
+    std::condition_variable callback_done;
+    bool cancelled = false;
+    std::map<size_t, std::function<void()>> callbacks;
+    size_t next_id = 1;
+    /// Id and thread of the callback run by Cancel, 0 if none.
+    size_t running_id = 0;
+    std::thread::id running_thread;
+  };
+
+  std::shared_ptr<State> mState;
+};
+
+/// <summary>
+/// Deadline, cancellation token and priority of the calls made in a
+/// CallScope.
+/// </summary>
+struct CallOptions {
+  std::optional<std::chrono::steady_clock::time_point> deadline = std::nullopt;
+
+  std::optional<CancellationToken> cancellation = std::nullopt;
+
+  std::optional<CallPriority> priority = std::nullopt;
+
+  CallOptions() {}
+
+  /// <summary>
+  /// Returns options with a deadline the given time from now.
+  /// </summary>
+  static CallOptions WithTimeout(std::chrono::milliseconds timeout) {
+    CallOptions options;
+    options.deadline = std::chrono::steady_clock::now() + timeout;
+    return options;
+  }
+
+  /// <summary>
+  /// Returns options with a cancellation token.
+  /// </summary>
+  static CallOptions WithCancellation(const CancellationToken& token) {
+    CallOptions options;
+    options.cancellation = token;
+    return options;
+  }
+
+  /// <summary>
+  /// Returns options with a priority.
+  /// </summary>
+  static CallOptions WithPriority(CallPriority priority) {
+    CallOptions options;
+    options.priority = priority;
+    return options;
+  }
+};
+
+/// <summary>
+/// Applies call options to every call made by the current thread while the
+/// scope is alive, down to the connection timeouts and the retried and hedged
+/// calls. Nested scopes keep the earliest deadline, and inherit the token and
+/// the priority they do not set.
+/// <example>
+/// Casper::CallScope scope(Casper::CallOptions::WithTimeout(500ms));
+/// client.GetBlock(height);
+/// </example>
+/// </summary>
+class CallScope {
+ public:
+  explicit CallScope(const CallOptions& options) : mPrevious(tCurrent) {
+    mOptions = options;
+    if (mPrevious != nullptr) {
+      if (mPrevious->deadline.has_value()) {
+        mOptions.deadline =
+            mOptions.deadline.has_value()
+                ? std::min(mOptions.deadline.value(),
+                           mPrevious->deadline.value())
+                : mPrevious->deadline;
+      }
+      if (!mOptions.cancellation.has_value()) {
+        mOptions.cancellation = mPrevious->cancellation;
+      }
+      if (!mOptions.priority.has_value()) {
+        mOptions.priority = mPrevious->priority;
+      }
+    }
+    tCurrent = &mOptions;
+  }
+
+  ~CallScope() { tCurrent = mPrevious; }
+
+  CallScope(const CallScope&) = delete;
+  CallScope& operator=(const CallScope&) = delete;
+
+  /// <summary>
+  /// Returns the options of the innermost scope of the current thread, or
+  /// nullptr outside any scope.
+  /// </summary>
+  static const CallOptions* Current() { return tCurrent; }
+
+  /// <summary>
+  /// Returns the time left before the deadline of the current scope, or
+  /// std::nullopt without deadline.
+  /// </summary>
+  static std::optional<std::chrono::milliseconds> GetRemainingTime() {
+    if (tCurrent == nullptr || !tCurrent->deadline.has_value()) {
+      return std::nullopt;
+    }
+    // rounded up, so that a timeout of the remaining time ends past the
+    // deadline
+    return std::max(std::chrono::milliseconds(0),
+                    std::chrono::ceil<std::chrono::milliseconds>(
+                        tCurrent->deadline.value() -
+                        std::chrono::steady_clock::now()));
+  }
+
+  /// <summary>
+  /// Returns the priority of the current scope, Normal by default.
+  /// </summary>
+  static CallPriority GetPriority() {
+    if (tCurrent == nullptr || !tCurrent->priority.has_value()) {
+      return CallPriority::Normal;
+    }
+    return tCurrent->priority.value();
+  }
+
+  /// <summary>
+  /// Throws a JsonRpcException if the current scope is cancelled or past its
+  /// deadline.
+  /// </summary>
+  static void ThrowIfDone() {
+    if (tCurrent == nullptr) return;
+
+    if (tCurrent->cancellation.has_value() &&
+        tCurrent->cancellation->IsCancelled()) {
+      throw jsonrpccxx::JsonRpcException(CALL_CANCELLED, "call cancelled");
+    }
+    if (tCurrent->deadline.has_value() &&
+        std::chrono::steady_clock::now() >= tCurrent->deadline.value()) {
+      throw jsonrpccxx::JsonRpcException(CALL_DEADLINE_EXCEEDED,
+                                         "call deadline exceeded");
+    }
+  }
+
+ private:
+  CallOptions mOptions;
+  const CallOptions* mPrevious;
+
+  static inline thread_local const CallOptions* tCurrent = nullptr;
+};
+
+}  // namespace Casper
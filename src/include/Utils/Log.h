@@ -0,0 +1,142 @@
+#pragma once
+
+#include <atomic>
+#include <mutex>
+#include <ostream>
+#include <sstream>
+#include <string_view>
+
+/// Lowest level of the log statements compiled in, from 0 (Trace) to 5 (Off).
+/// The statements below it are removed at compile time, their message is not
+/// even formatted. Set by the CASPER_LOG_LEVEL CMake option.
+#ifndef CASPER_LOG_MIN_LEVEL
+#define CASPER_LOG_MIN_LEVEL 0
+#endif
+
+namespace Casper {
+/// <summary>
+/// Severity of a log message.
+/// </summary>
+enum class LogLevel {
+  /// Details of the encoding and decoding steps.
+  Trace = 0,
+  /// Intermediate values, like signatures and sizes.
+  Debug = 1,
+  Info = 2,
+  /// Unexpected input handled by the SDK.
+  Warning = 3,
+  /// Failures, like a key file that cannot be read.
+  Error = 4,
+  Off = 5
+};
+
+/// <summary>
+/// Receives the log messages of the SDK. Called on the thread logging, from
+/// many threads at once, and must not throw.
+/// </summary>
+class LogSink {
+ public:
+  virtual ~LogSink() = default;
+
+  virtual void Write(LogLevel level, std::string_view message) = 0;
+};
+
+struct Logging {
+  /// <summary>
+  /// Installs the sink receiving the messages of every thread, or removes it
+  /// with nullptr. The sink is not owned and must outlive its use. Without a
+  /// sink nothing is logged and a log statement costs two relaxed atomic
+  /// loads.
+  /// </summary>
+  static void SetSink(LogSink* sink) {
+    sSink.store(sink, std::memory_order_release);
+  }
+
+  static LogSink* GetSink() { return sSink.load(std::memory_order_acquire); }
+
+  /// <summary>
+  /// Sets the lowest level written to the sink, Info by default.
+  /// </summary>
+  static void SetLevel(LogLevel level) {
+    sLevel.store(level, std::memory_order_relaxed);
+  }
+
+  static LogLevel GetLevel() { return sLevel.load(std::memory_order_relaxed); }
+
+  /// <summary>
+  /// Returns true if messages of the level reach a sink.
+  /// </summary>
+  static bool IsEnabled(LogLevel level) {
+    return level >= GetLevel() &&
+           sSink.load(std::memory_order_relaxed) != nullptr;
+  }
+
+  static void Write(LogLevel level, std::string_view message) {
+    LogSink* sink = GetSink();
+    if (sink != nullptr) sink->Write(level, message);
+  }
+
+  static const char* GetLevelName(LogLevel level) {
+    switch (level) {
+      case LogLevel::Trace:
+        return "trace";
+      case LogLevel::Debug:
+        return "debug";
+      case LogLevel::Info:
+        return "info";
+      case LogLevel::Warning:
+        return "warning";
+      case LogLevel::Error:
+        return "error";
+      default:
+        return "off";
+    }
+  }
+
+ private:
+  inline static std::atomic<LogSink*> sSink = nullptr;
+  inline static std::atomic<LogLevel> sLevel = LogLevel::Info;
+};
+
+/// <summary>
+/// Writes the log messages to a stream like std::cerr, one
+/// "[level] message" line each.
+/// </summary>
+class StreamLogSink : public LogSink {
+ public:
+  explicit StreamLogSink(std::ostream& stream) : mStream(stream) {}
+
+  void Write(LogLevel level, std::string_view message) override {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mStream << '[' << Logging::GetLevelName(level) << "] " << message << '\n';
+  }
+
+ private:
+  std::mutex mMutex;
+  std::ostream& mStream;
+};
+
+}  // namespace Casper
+
+/// Logs the streamed message, like CASPER_LOG_DEBUG("size: " << size), if its
+/// level is compiled in and enabled.
+#define CASPER_LOG(level, message)                                   \
+  do {                                                               \
+    if constexpr (static_cast<int>(level) >= CASPER_LOG_MIN_LEVEL) { \
+      if (::Casper::Logging::IsEnabled(level)) {                     \
+        std::ostringstream casper_log_stream;                        \
+        casper_log_stream << message;                                \
+        ::Casper::Logging::Write(level, casper_log_stream.str());    \
+      }                                                              \
+    }                                                                \
+  } while (false)
+
+#define CASPER_LOG_TRACE(message) \
+  CASPER_LOG(::Casper::LogLevel::Trace, message)
+#define CASPER_LOG_DEBUG(message) \
+  CASPER_LOG(::Casper::LogLevel::Debug, message)
+#define CASPER_LOG_INFO(message) CASPER_LOG(::Casper::LogLevel::Info, message)
+#define CASPER_LOG_WARNING(message) \
+  CASPER_LOG(::Casper::LogLevel::Warning, message)
+#define CASPER_LOG_ERROR(message) \
+  CASPER_LOG(::Casper::LogLevel::Error, message)
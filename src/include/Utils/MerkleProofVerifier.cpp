@@ -0,0 +1,164 @@
+#include "Utils/MerkleProofVerifier.h"
+
+#include "ByteSerializers/CLValueByteSerializer.h"
+#include "ByteSerializers/GlobalStateKeyByteSerializer.h"
+#include "Types/TrieMerkleProof.h"
+#include "Types/URef.h"
+#include "Utils/ThreadUtil.h"
+
+namespace Casper {
+namespace {
+/// Serialized length of the StoredValue and CLValue headers: value tag and
+/// bytes length.
+constexpr const size_t CL_VALUE_HEADER_LENGTH = 1 + 4;
+
+/// Returns the bytes of a proven StoredValue::CLValue, or false if the value
+/// is of another kind.
+bool GetCLValueBytes(const CBytes& value_bytes, CBytes& cl_value_bytes) {
+  if (value_bytes.size() < CL_VALUE_HEADER_LENGTH || value_bytes[0] != 0) {
+    return false;
+  }
+
+  uint32_t length = uint32_t(value_bytes[1]) | uint32_t(value_bytes[2]) << 8 |
+                    uint32_t(value_bytes[3]) << 16 |
+                    uint32_t(value_bytes[4]) << 24;
+  if (length > value_bytes.size() - CL_VALUE_HEADER_LENGTH) {
+    return false;
+  }
+
+  cl_value_bytes.Assign(value_bytes.data() + CL_VALUE_HEADER_LENGTH, length);
+  return true;
+}
+}  // namespace
+
+bool MerkleProofVerifier::VerifyBalance(const GetBalanceResult& result,
+                                        const std::string& state_root_hash,
+                                        const std::string& purse_uref) {
+  try {
+    TrieMerkleProof proof = TrieMerkleProof::FromHex(result.merkle_proof);
+    if (!proof.Verify(state_root_hash)) {
+      return false;
+    }
+
+    // balances are stored under the balance key of the purse address
+    URef purse(purse_uref);
+    CBytes balance_key(1 + purse.raw_bytes.size());
+    balance_key[0] = static_cast<uint8_t>(KeyIdentifier::Balance);
+    std::copy(purse.raw_bytes.begin(), purse.raw_bytes.end(),
+              balance_key.begin() + 1);
+    if (proof.key_bytes != balance_key) {
+      return false;
+    }
+
+    // the value must be a U512: length byte and little-endian bytes, then the
+    // U512 type tag
+    CBytes cl_value_bytes;
+    if (!GetCLValueBytes(proof.value_bytes, cl_value_bytes) ||
+        cl_value_bytes.empty() ||
+        proof.value_bytes.size() !=
+            CL_VALUE_HEADER_LENGTH + cl_value_bytes.size() + 1 ||
+        proof.value_bytes[proof.value_bytes.size() - 1] != 8 ||
+        cl_value_bytes[0] != cl_value_bytes.size() - 1) {
+      return false;
+    }
+
+    uint512_t balance = 0;
+    for (size_t i = cl_value_bytes.size() - 1; i > 0; i--) {
+      balance = (balance << 8) | cl_value_bytes[i];
+    }
+
+    return balance == result.balance_value;
+  } catch (std::exception& e) {
+    return false;
+  }
+}
+
+bool MerkleProofVerifier::VerifyItem(const GetItemResult& result,
+                                     const std::string& state_root_hash,
+                                     const std::string& key,
+                                     const std::vector<std::string>& path) {
+  try {
+    // one proof for the queried key and one for each hop of the path, an
+    // extra proof could prove a value stored under any other key
+    std::vector<TrieMerkleProof> proofs =
+        TrieMerkleProof::ListFromHex(result.merkle_proof);
+    if (proofs.size() != path.size() + 1) {
+      return false;
+    }
+
+    for (auto& proof : proofs) {
+      if (!proof.Verify(state_root_hash)) {
+        return false;
+      }
+    }
+
+    GlobalStateKey global_state_key = GlobalStateKey::FromString(key);
+    GlobalStateKeyByteSerializer key_serializer;
+    if (proofs.front().key_bytes != key_serializer.ToBytes(global_state_key)) {
+      return false;
+    }
+
+    // each hop is the key named by the path in the previous Account or
+    // Contract
+    for (size_t i = 0; i < path.size(); i++) {
+      CBytes named_key_bytes;
+      if (!proofs[i].FindNamedKey(path[i], named_key_bytes) ||
+          proofs[i + 1].key_bytes != named_key_bytes) {
+        return false;
+      }
+    }
+
+    // only the values that can be serialized are compared with the proven
+    // value, a value that is not compared is not verified
+    const CLValue* cl_value =
+        result.stored_value.GetIf<StoredValueType::CLValue>();
+    if (cl_value == nullptr) {
+      return false;
+    }
+
+    // the StoredValue tag, then the bytes and the type of the CLValue
+    CBytes stored_value_bytes(1);
+    stored_value_bytes[0] = static_cast<uint8_t>(StoredValueType::CLValue);
+    stored_value_bytes += CLValueByteSerializer().ToBytes(*cl_value);
+    return proofs.back().value_bytes == stored_value_bytes;
+  } catch (std::exception& e) {
+    return false;
+  }
+}
+
+std::vector<bool> MerkleProofVerifier::VerifyBalances(
+    const std::vector<GetBalanceResult>& results,
+    const std::string& state_root_hash,
+    const std::vector<std::string>& purse_urefs, unsigned int threads) {
+  if (results.size() != purse_urefs.size()) {
+    throw std::invalid_argument(
+        "VerifyBalances: every result needs its purse URef.");
+  }
+
+  // std::vector<bool> packs bits, write to separate bytes from the workers
+  std::vector<uint8_t> verified(results.size());
+  ThreadUtil::ParallelFor(results.size(), threads, [&](size_t i) {
+    verified[i] = VerifyBalance(results[i], state_root_hash, purse_urefs[i]);
+  });
+
+  return std::vector<bool>(verified.begin(), verified.end());
+}
+
+std::vector<bool> MerkleProofVerifier::VerifyItems(
+    const std::vector<GetItemResult>& results,
+    const std::string& state_root_hash, const std::vector<std::string>& keys,
+    unsigned int threads) {
+  if (results.size() != keys.size()) {
+    throw std::invalid_argument("VerifyItems: every result needs its key.");
+  }
+
+  // std::vector<bool> packs bits, write to separate bytes from the workers
+  std::vector<uint8_t> verified(results.size());
+  ThreadUtil::ParallelFor(results.size(), threads, [&](size_t i) {
+    verified[i] = VerifyItem(results[i], state_root_hash, keys[i]);
+  });
+
+  return std::vector<bool>(verified.begin(), verified.end());
+}
+
+}  // namespace Casper
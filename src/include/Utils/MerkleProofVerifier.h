@@ -0,0 +1,55 @@
+#pragma once
+
+#include "Base.h"
+#include "JsonRpc/ResultTypes/GetBalanceResult.h"
+#include "JsonRpc/ResultTypes/GetItemResult.h"
+
+namespace Casper {
+/// <summary>
+/// Verifies the merkle proofs of query results against a trusted state root
+/// hash, so that results read from an untrusted node can be checked locally.
+/// Malformed proofs are reported as failed verifications.
+/// </summary>
+struct MerkleProofVerifier {
+  /// <summary>
+  /// Checks that the proof of a "state_get_balance" result resolves to the
+  /// state root hash, is for the balance of the purse and proves the returned
+  /// balance value.
+  /// </summary>
+  static bool VerifyBalance(const GetBalanceResult& result,
+                            const std::string& state_root_hash,
+                            const std::string& purse_uref);
+
+  /// <summary>
+  /// Checks that every proof of a "state_get_item" result resolves to the
+  /// state root hash, that the first one is for the queried key, that each
+  /// next one is for the key named by the path in the previous value and that
+  /// the last one proves the returned CLValue, its bytes and its type. There
+  /// must be exactly one proof for the key and one for each name of the path.
+  /// Results of other stored values are not verified.
+  /// </summary>
+  static bool VerifyItem(const GetItemResult& result,
+                         const std::string& state_root_hash,
+                         const std::string& key,
+                         const std::vector<std::string>& path = {});
+
+  /// <summary>
+  /// Verifies several balance results on worker threads. Use 0 threads to
+  /// pick the number of threads from the hardware.
+  /// </summary>
+  static std::vector<bool> VerifyBalances(
+      const std::vector<GetBalanceResult>& results,
+      const std::string& state_root_hash,
+      const std::vector<std::string>& purse_urefs, unsigned int threads = 0);
+
+  /// <summary>
+  /// Verifies several item results of queries without a path on worker
+  /// threads. Use 0 threads to pick the number of threads from the hardware.
+  /// </summary>
+  static std::vector<bool> VerifyItems(const std::vector<GetItemResult>& results,
+                                       const std::string& state_root_hash,
+                                       const std::vector<std::string>& keys,
+                                       unsigned int threads = 0);
+};
+
+}  // namespace Casper
@@ -0,0 +1,247 @@
+#include "Utils/Metrics.h"
+
+#include <algorithm>
+#include <sstream>
+
+namespace Casper {
+
+namespace {
+/// Upper bounds of the buckets of the exported histograms, in seconds. Each
+/// one is moved up to the end of the latency bucket that holds it.
+const std::vector<double> EXPORTED_BUCKET_BOUNDS = {
+    0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+    0.1,    0.25,    0.5,    1,     2.5,    5,     10,   30,    60};
+
+/// Writes a whole number of microseconds in seconds, without trailing zeros.
+std::string FormatSeconds(uint64_t microseconds) {
+  std::string text = std::to_string(microseconds / 1000000);
+  uint64_t fraction = microseconds % 1000000;
+  if (fraction == 0) return text;
+
+  std::string digits = std::to_string(fraction);
+  digits.insert(0, 6 - digits.size(), '0');
+  digits.erase(digits.find_last_not_of('0') + 1);
+  return text + "." + digits;
+}
+
+void WriteHistogram(std::ostringstream& out, const std::string& method,
+                    const std::string& phase,
+                    const HistogramSnapshot& histogram) {
+  std::string labels = "method=\"" + method + "\",phase=\"" + phase + "\"";
+
+  // the latencies are recorded in whole microseconds, a bucket up to U holds
+  // the latencies below U + 1. The exported bounds are rounded up to these
+  // ends so that each line counts whole buckets and no latency is left out of
+  // a line it belongs to.
+  uint64_t cumulative = 0;
+  size_t bucket = 0;
+  for (double bound : EXPORTED_BUCKET_BOUNDS) {
+    uint64_t bound_us = static_cast<uint64_t>(bound * 1e6);
+    size_t last = LatencyHistogram::GetBucketIndex(bound_us - 1);
+    if (last < bucket) continue;
+    while (bucket <= last && bucket < histogram.buckets.size()) {
+      cumulative += histogram.buckets[bucket++];
+    }
+    out << "casper_rpc_duration_seconds_bucket{" << labels << ",le=\""
+        << FormatSeconds(LatencyHistogram::GetBucketUpperBound(last) + 1)
+        << "\"} " << cumulative << "\n";
+  }
+  out << "casper_rpc_duration_seconds_bucket{" << labels << ",le=\"+Inf\"} "
+      << histogram.count << "\n";
+  out << "casper_rpc_duration_seconds_sum{" << labels << "} "
+      << histogram.sum / 1e6 << "\n";
+  out << "casper_rpc_duration_seconds_count{" << labels << "} "
+      << histogram.count << "\n";
+}
+}  // namespace
+
+/// HistogramSnapshot
+
+uint64_t HistogramSnapshot::GetPercentile(double quantile) const {
+  if (count == 0) return 0;
+
+  uint64_t rank = static_cast<uint64_t>(quantile * count);
+  if (rank >= count) rank = count - 1;
+
+  uint64_t seen = 0;
+  for (size_t i = 0; i < buckets.size(); i++) {
+    seen += buckets[i];
+    if (seen > rank) {
+      return std::min(max, LatencyHistogram::GetBucketUpperBound(i));
+    }
+  }
+  return max;
+}
+
+/// LatencyHistogram
+
+void LatencyHistogram::Record(std::chrono::nanoseconds latency) {
+  Record(static_cast<uint64_t>(std::max<int64_t>(
+      0, std::chrono::duration_cast<std::chrono::microseconds>(latency)
+             .count())));
+}
+
+void LatencyHistogram::Record(uint64_t microseconds) {
+  mBuckets[GetBucketIndex(microseconds)].fetch_add(1,
+                                                   std::memory_order_relaxed);
+  mSum.fetch_add(microseconds, std::memory_order_relaxed);
+
+  uint64_t min = mMin.load(std::memory_order_relaxed);
+  while (microseconds < min &&
+         !mMin.compare_exchange_weak(min, microseconds,
+                                     std::memory_order_relaxed)) {
+  }
+  uint64_t max = mMax.load(std::memory_order_relaxed);
+  while (microseconds > max &&
+         !mMax.compare_exchange_weak(max, microseconds,
+                                     std::memory_order_relaxed)) {
+  }
+}
+
+HistogramSnapshot LatencyHistogram::GetSnapshot() const {
+  HistogramSnapshot snapshot;
+  snapshot.buckets.resize(BUCKET_COUNT);
+  for (size_t i = 0; i < BUCKET_COUNT; i++) {
+    snapshot.buckets[i] = mBuckets[i].load(std::memory_order_relaxed);
+    snapshot.count += snapshot.buckets[i];
+  }
+  snapshot.sum = mSum.load(std::memory_order_relaxed);
+  snapshot.max = mMax.load(std::memory_order_relaxed);
+  snapshot.min =
+      snapshot.count == 0 ? 0 : mMin.load(std::memory_order_relaxed);
+  return snapshot;
+}
+
+size_t LatencyHistogram::GetBucketIndex(uint64_t microseconds) {
+  if (microseconds < SUB_BUCKET_COUNT) return microseconds;
+
+#if defined(__GNUC__)
+  size_t exponent = 63 - __builtin_clzll(microseconds);
+#else
+  size_t exponent = 0;
+  while ((microseconds >> (exponent + 1)) != 0) exponent++;
+#endif
+  if (exponent >= MAX_EXPONENT) return BUCKET_COUNT - 1;
+
+  size_t sub_bucket = (microseconds >> (exponent - 4)) & (SUB_BUCKET_COUNT - 1);
+  return (exponent - 3) * SUB_BUCKET_COUNT + sub_bucket;
+}
+
+uint64_t LatencyHistogram::GetBucketUpperBound(size_t index) {
+  if (index < SUB_BUCKET_COUNT) return index;
+
+  size_t exponent = index / SUB_BUCKET_COUNT + 3;
+  uint64_t sub_bucket = index % SUB_BUCKET_COUNT;
+  uint64_t lower = (SUB_BUCKET_COUNT + sub_bucket) << (exponent - 4);
+  return lower + (uint64_t(1) << (exponent - 4)) - 1;
+}
+
+/// MetricsRegistry
+
+void MetricsRegistry::Record(const std::string& method,
+                             const CallMeasure& measure) {
+  MethodMetrics& metrics = GetMethodMetrics(method);
+
+  metrics.call_count.fetch_add(1, std::memory_order_relaxed);
+  metrics.request_bytes.fetch_add(measure.request_bytes,
+                                  std::memory_order_relaxed);
+  metrics.response_bytes.fetch_add(measure.response_bytes,
+                                   std::memory_order_relaxed);
+  if (measure.error_code != 0) {
+    std::lock_guard<std::mutex> lock(metrics.error_mutex);
+    metrics.error_codes[measure.error_code]++;
+  }
+
+  metrics.queue.Record(measure.queue);
+  metrics.network.Record(measure.network);
+  metrics.parse.Record(measure.parse);
+  metrics.from_json.Record(measure.from_json);
+  metrics.total.Record(measure.queue + measure.network + measure.parse +
+                       measure.from_json);
+}
+
+std::map<std::string, MethodMetricsSnapshot> MetricsRegistry::GetSnapshot()
+    const {
+  std::map<std::string, MethodMetricsSnapshot> snapshot;
+
+  std::lock_guard<std::mutex> lock(mMutex);
+  for (auto& [method, metrics] : mMethods) {
+    MethodMetricsSnapshot& method_snapshot = snapshot[method];
+    method_snapshot.call_count = metrics->call_count;
+    method_snapshot.request_bytes = metrics->request_bytes;
+    method_snapshot.response_bytes = metrics->response_bytes;
+    {
+      std::lock_guard<std::mutex> error_lock(metrics->error_mutex);
+      method_snapshot.error_codes = metrics->error_codes;
+    }
+    for (auto& error_code : method_snapshot.error_codes) {
+      method_snapshot.error_count += error_code.second;
+    }
+
+    method_snapshot.queue = metrics->queue.GetSnapshot();
+    method_snapshot.network = metrics->network.GetSnapshot();
+    method_snapshot.parse = metrics->parse.GetSnapshot();
+    method_snapshot.from_json = metrics->from_json.GetSnapshot();
+    method_snapshot.total = metrics->total.GetSnapshot();
+  }
+  return snapshot;
+}
+
+std::string MetricsRegistry::ToPrometheusText(
+    const std::map<std::string, MethodMetricsSnapshot>& snapshot) {
+  std::ostringstream out;
+  out.precision(12);
+
+  out << "# HELP casper_rpc_calls_total RPC calls sent to the nodes.\n"
+      << "# TYPE casper_rpc_calls_total counter\n";
+  for (auto& [method, metrics] : snapshot) {
+    out << "casper_rpc_calls_total{method=\"" << method << "\"} "
+        << metrics.call_count << "\n";
+  }
+
+  out << "# HELP casper_rpc_errors_total Failed RPC calls by error code.\n"
+      << "# TYPE casper_rpc_errors_total counter\n";
+  for (auto& [method, metrics] : snapshot) {
+    for (auto& [code, count] : metrics.error_codes) {
+      out << "casper_rpc_errors_total{method=\"" << method << "\",code=\""
+          << code << "\"} " << count << "\n";
+    }
+  }
+
+  out << "# HELP casper_rpc_request_bytes_total Bytes of the requests.\n"
+      << "# TYPE casper_rpc_request_bytes_total counter\n";
+  for (auto& [method, metrics] : snapshot) {
+    out << "casper_rpc_request_bytes_total{method=\"" << method << "\"} "
+        << metrics.request_bytes << "\n";
+  }
+
+  out << "# HELP casper_rpc_response_bytes_total Bytes of the responses.\n"
+      << "# TYPE casper_rpc_response_bytes_total counter\n";
+  for (auto& [method, metrics] : snapshot) {
+    out << "casper_rpc_response_bytes_total{method=\"" << method << "\"} "
+        << metrics.response_bytes << "\n";
+  }
+
+  out << "# HELP casper_rpc_duration_seconds Duration of the phases of the "
+         "RPC calls.\n"
+      << "# TYPE casper_rpc_duration_seconds histogram\n";
+  for (auto& [method, metrics] : snapshot) {
+    WriteHistogram(out, method, "queue", metrics.queue);
+    WriteHistogram(out, method, "network", metrics.network);
+    WriteHistogram(out, method, "parse", metrics.parse);
+    WriteHistogram(out, method, "from_json", metrics.from_json);
+    WriteHistogram(out, method, "total", metrics.total);
+  }
+
+  return out.str();
+}
+
+MetricsRegistry::MethodMetrics& MetricsRegistry::GetMethodMetrics(
+    const std::string& method) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  std::unique_ptr<MethodMetrics>& metrics = mMethods[method];
+  if (metrics == nullptr) metrics = std::make_unique<MethodMetrics>();
+  return *metrics;
+}
+
+}  // namespace Casper
@@ -0,0 +1,163 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace Casper {
+/// <summary>
+/// Copy of a latency histogram at a point in time. The latencies are in
+/// microseconds.
+/// </summary>
+struct HistogramSnapshot {
+  uint64_t count = 0;
+  uint64_t sum = 0;
+  uint64_t min = 0;
+  uint64_t max = 0;
+
+  /// Number of latencies per bucket, see
+  /// LatencyHistogram::GetBucketUpperBound.
+  std::vector<uint64_t> buckets;
+
+  /// <summary>
+  /// Returns the latency at the given quantile, from 0 to 1, as the upper
+  /// bound of its bucket.
+  /// </summary>
+  uint64_t GetPercentile(double quantile) const;
+
+  double GetMean() const { return count == 0 ? 0 : double(sum) / count; }
+};
+
+/// <summary>
+/// Latency histogram with logarithmic buckets, each power of two split in 16
+/// linear sub-buckets, like HDR histograms: the bucket of a latency is within
+/// about 6% of it from 1 microsecond to hours. Recording is lock-free.
+/// </summary>
+class LatencyHistogram {
+ public:
+  /// Number of linear sub-buckets per power of two.
+  static constexpr const size_t SUB_BUCKET_COUNT = 16;
+  /// Latencies from 2^36 microseconds on share the last bucket.
+  static constexpr const size_t MAX_EXPONENT = 36;
+  static constexpr const size_t BUCKET_COUNT =
+      (MAX_EXPONENT - 3) * SUB_BUCKET_COUNT;
+
+  LatencyHistogram() {
+    for (auto& bucket : mBuckets) bucket = 0;
+  }
+
+  void Record(std::chrono::nanoseconds latency);
+
+  void Record(uint64_t microseconds);
+
+  HistogramSnapshot GetSnapshot() const;
+
+  /// <summary>
+  /// Returns the index of the bucket of a latency in microseconds.
+  /// </summary>
+  static size_t GetBucketIndex(uint64_t microseconds);
+
+  /// <summary>
+  /// Returns the largest latency in microseconds of a bucket.
+  /// </summary>
+  static uint64_t GetBucketUpperBound(size_t index);
+
+ private:
+  std::array<std::atomic<uint64_t>, BUCKET_COUNT> mBuckets;
+  std::atomic<uint64_t> mSum = 0;
+  std::atomic<uint64_t> mMin = UINT64_MAX;
+  std::atomic<uint64_t> mMax = 0;
+};
+
+/// <summary>
+/// Measures of one RPC call.
+/// </summary>
+struct CallMeasure {
+  /// Time waiting for the rate limit of the nodes.
+  std::chrono::nanoseconds queue{0};
+  /// Time sending the request and receiving the response.
+  std::chrono::nanoseconds network{0};
+  /// Time parsing the response JSON.
+  std::chrono::nanoseconds parse{0};
+  /// Time mapping the JSON to the result type.
+  std::chrono::nanoseconds from_json{0};
+
+  size_t request_bytes = 0;
+  size_t response_bytes = 0;
+
+  /// JSON-RPC error code of a failed call, 0 on success.
+  int error_code = 0;
+};
+
+/// <summary>
+/// Copy of the metrics of a method at a point in time.
+/// </summary>
+struct MethodMetricsSnapshot {
+  uint64_t call_count = 0;
+  uint64_t error_count = 0;
+  /// Number of errors per JSON-RPC error code.
+  std::map<int, uint64_t> error_codes;
+
+  uint64_t request_bytes = 0;
+  uint64_t response_bytes = 0;
+
+  HistogramSnapshot queue;
+  HistogramSnapshot network;
+  HistogramSnapshot parse;
+  HistogramSnapshot from_json;
+  HistogramSnapshot total;
+};
+
+/// <summary>
+/// Metrics of the RPC calls, per method: call and error counts, byte counts
+/// and latency histograms of the queueing, network, JSON parse and from_json
+/// phases of the calls.
+/// </summary>
+class MetricsRegistry {
+ public:
+  /// <summary>
+  /// Adds the measures of a call of the method.
+  /// </summary>
+  void Record(const std::string& method, const CallMeasure& measure);
+
+  /// <summary>
+  /// Returns a copy of the metrics of every method.
+  /// </summary>
+  std::map<std::string, MethodMetricsSnapshot> GetSnapshot() const;
+
+  /// <summary>
+  /// Returns the metrics in the Prometheus text exposition format, with the
+  /// latencies in seconds. The bounds of the histogram buckets are those of
+  /// the latency buckets, like 0.000256 for 250 microseconds.
+  /// </summary>
+  static std::string ToPrometheusText(
+      const std::map<std::string, MethodMetricsSnapshot>& snapshot);
+
+ private:
+  struct MethodMetrics {
+    std::atomic<uint64_t> call_count = 0;
+    std::atomic<uint64_t> request_bytes = 0;
+    std::atomic<uint64_t> response_bytes = 0;
+
+    std::mutex error_mutex;
+    std::map<int, uint64_t> error_codes;
+
+    LatencyHistogram queue;
+    LatencyHistogram network;
+    LatencyHistogram parse;
+    LatencyHistogram from_json;
+    LatencyHistogram total;
+  };
+
+  MethodMetrics& GetMethodMetrics(const std::string& method);
+
+  mutable std::mutex mMutex;
+  std::map<std::string, std::unique_ptr<MethodMetrics>> mMethods;
+};
+
+}  // namespace Casper
@@ -0,0 +1,134 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <condition_variable>
+#include <mutex>
+#include <set>
+#include <utility>
+
+#include "Utils/CallContext.h"
+
+namespace Casper {
+/// <summary>
+/// Token bucket limiting the rate of the calls to a node. The bucket fills at
+/// the given rate up to the burst size, and each call takes a token. The calls
+/// waiting for a token get it by priority, then in the order they came, so
+/// interactive calls overtake the waiting bulk calls. Unlimited by default.
+/// </summary>
+class RateLimiter {
+ public:
+  RateLimiter() {}
+
+  /// <summary>
+  /// Sets the rate of the calls, and the number of calls that can be sent at
+  /// once after an idle period. A rate of 0 removes the limit.
+  /// </summary>
+  void SetRate(double calls_per_second, double burst = 1) {
+    std::lock_guard<std::mutex> lock(mMutex);
+    Refill(std::chrono::steady_clock::now());
+    mRate = std::max(0.0, calls_per_second);
+    mBurst = std::max(1.0, burst);
+    mTokens = std::min(mTokens, mBurst);
+    mTokenAvailable.notify_all();
+  }
+
+  double GetRate() const {
+    std::lock_guard<std::mutex> lock(mMutex);
+    return mRate;
+  }
+
+  /// <summary>
+  /// Waits for a token. The deadline and the cancellation token of the
+  /// current CallScope bound the wait, and its priority orders the waiting
+  /// calls.
+  /// </summary>
+  void Acquire() {
+    const CallOptions* options = CallScope::Current();
+    CallPriority priority = CallScope::GetPriority();
+
+    // registered before locking, the callback runs right away if the token
+    // is already cancelled, and is unregistered after unlocking since
+    // Unregister waits for a callback in progress
+    size_t registration = 0;
+    if (options != nullptr && options->cancellation.has_value()) {
+      registration = options->cancellation->Register([this] {
+        std::lock_guard<std::mutex> lock(mMutex);
+        mTokenAvailable.notify_all();
+      });
+    }
+    struct Unregister {
+      const CallOptions* options;
+      size_t registration;
+      ~Unregister() {
+        if (registration != 0) options->cancellation->Unregister(registration);
+      }
+    } unregister{options, registration};
+
+    std::unique_lock<std::mutex> lock(mMutex);
+    if (mRate == 0) return;
+
+    const Waiter waiter{static_cast<int>(priority), mNextWaiter++};
+    mWaiters.insert(waiter);
+    while (true) {
+      auto now = std::chrono::steady_clock::now();
+      Refill(now);
+      if (mRate == 0 || (*mWaiters.begin() == waiter && mTokens >= 1)) {
+        if (mRate != 0) mTokens -= 1;
+        mWaiters.erase(waiter);
+        mTokenAvailable.notify_all();
+        return;
+      }
+
+      try {
+        CallScope::ThrowIfDone();
+      } catch (...) {
+        mWaiters.erase(waiter);
+        mTokenAvailable.notify_all();
+        throw;
+      }
+
+      // the first waiter sleeps until its token, the others until they are
+      // first
+      auto wake_up = std::chrono::steady_clock::time_point::max();
+      if (*mWaiters.begin() == waiter) {
+        wake_up = now + std::chrono::ceil<std::chrono::steady_clock::duration>(
+                            std::chrono::duration<double>((1 - mTokens) /
+                                                          mRate));
+      }
+      if (options != nullptr && options->deadline.has_value()) {
+        wake_up = std::min(wake_up, options->deadline.value());
+      }
+
+      if (wake_up == std::chrono::steady_clock::time_point::max()) {
+        mTokenAvailable.wait(lock);
+      } else {
+        mTokenAvailable.wait_until(lock, wake_up);
+      }
+    }
+  }
+
+ private:
+  /// Priority and arrival order of a waiting call.
+  using Waiter = std::pair<int, uint64_t>;
+
+  void Refill(std::chrono::steady_clock::time_point now) {
+    double elapsed = std::chrono::duration<double>(now - mLastRefill).count();
+    mLastRefill = now;
+    mTokens = std::min(mBurst, mTokens + elapsed * mRate);
+  }
+
+  mutable std::mutex mMutex;
+  std::condition_variable mTokenAvailable;
+
+  double mRate = 0;
+  double mBurst = 1;
+  double mTokens = 1;
+  std::chrono::steady_clock::time_point mLastRefill =
+      std::chrono::steady_clock::now();
+
+  std::set<Waiter> mWaiters;
+  uint64_t mNextWaiter = 0;
+};
+
+}  // namespace Casper
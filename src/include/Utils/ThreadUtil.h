@@ -0,0 +1,49 @@
+#pragma once
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+#include <vector>
+
+namespace Casper {
+struct ThreadUtil {
+  /// <summary>
+  /// Calls func(i) for every i in [0, count), split in contiguous chunks
+  /// between worker threads. The calling thread works on the first chunk. Use
+  /// 0 threads to pick the number of threads from the hardware. The first
+  /// exception thrown by a worker is rethrown after all workers are joined.
+  /// </summary>
+  template <typename Func>
+  static void ParallelFor(size_t count, unsigned int threads, Func func) {
+    if (count == 0) return;
+
+    if (threads == 0) threads = std::thread::hardware_concurrency();
+    if (threads == 0) threads = 1;
+    size_t worker_count = std::min<size_t>(threads, count);
+    size_t chunk_size = (count + worker_count - 1) / worker_count;
+
+    std::vector<std::exception_ptr> errors(worker_count);
+    auto work = [&](size_t worker) {
+      try {
+        size_t end = std::min(count, (worker + 1) * chunk_size);
+        for (size_t i = worker * chunk_size; i < end; i++) {
+          func(i);
+        }
+      } catch (...) {
+        errors[worker] = std::current_exception();
+      }
+    };
+
+    std::vector<std::thread> workers;
+    for (size_t worker = 1; worker < worker_count; worker++) {
+      workers.emplace_back(work, worker);
+    }
+    work(0);
+    for (auto& worker : workers) worker.join();
+
+    for (auto& error : errors) {
+      if (error) std::rethrow_exception(error);
+    }
+  }
+};
+}  // namespace Casper
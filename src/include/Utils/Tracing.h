@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <exception>
+
+namespace Casper {
+/// <summary>
+/// Kind of the work measured by a span.
+/// </summary>
+enum class SpanKind {
+  /// A JSON-RPC call of the Client, named by its method.
+  Rpc,
+  /// The JSON decode of the result of a call, named by its method.
+  Decode,
+  /// A binary serialization.
+  Serialize,
+  /// A hash computation.
+  Hash,
+  /// A signature.
+  Sign
+};
+
+/// <summary>
+/// Receives the begin and end of the spans of the SDK, like a call or the
+/// signature of a deploy. The spans of a thread are nested: a span ends before
+/// the span it was begun in. The hooks are called on the thread doing the
+/// work, from many threads at once, and must not throw.
+/// </summary>
+class Tracer {
+ public:
+  virtual ~Tracer() = default;
+
+  /// <summary>
+  /// Called when a span begins. The name is a string literal or the method of
+  /// a call, valid for the lifetime of the program. Returns a value given
+  /// back to EndSpan, like the id of the span in the tracer.
+  /// </summary>
+  virtual uint64_t BeginSpan(SpanKind kind, const char* name) = 0;
+
+  /// <summary>
+  /// Called when a span ends, failed if it is left by an exception.
+  /// </summary>
+  virtual void EndSpan(SpanKind kind, const char* name, uint64_t span,
+                       bool failed) = 0;
+};
+
+struct Tracing {
+  /// <summary>
+  /// Installs the tracer receiving the spans of every thread, or removes it
+  /// with nullptr. The tracer is not owned and must outlive the spans begun
+  /// while it is installed. Without a tracer, a span costs an atomic load.
+  /// </summary>
+  static void SetTracer(Tracer* tracer) {
+    sTracer.store(tracer, std::memory_order_release);
+  }
+
+  static Tracer* GetTracer() {
+    return sTracer.load(std::memory_order_acquire);
+  }
+
+ private:
+  inline static std::atomic<Tracer*> sTracer = nullptr;
+};
+
+/// <summary>
+/// Reports a span to the installed tracer from its construction to its
+/// destruction. Does nothing when no tracer is installed.
+/// </summary>
+class TraceSpan {
+ public:
+  TraceSpan(SpanKind kind, const char* name)
+      : mTracer(Tracing::GetTracer()) {
+    if (mTracer != nullptr) {
+      mKind = kind;
+      mName = name;
+      mExceptions = std::uncaught_exceptions();
+      mSpan = mTracer->BeginSpan(kind, name);
+    }
+  }
+
+  ~TraceSpan() {
+    if (mTracer != nullptr) {
+      mTracer->EndSpan(mKind, mName, mSpan,
+                       std::uncaught_exceptions() > mExceptions);
+    }
+  }
+
+  TraceSpan(const TraceSpan&) = delete;
+  TraceSpan& operator=(const TraceSpan&) = delete;
+
+ private:
+  Tracer* mTracer;
+  SpanKind mKind = SpanKind::Rpc;
+  const char* mName = nullptr;
+  int mExceptions = 0;
+  uint64_t mSpan = 0;
+};
+
+}  // namespace Casper
@@ -19,6 +19,11 @@
 #include "RpcTest.hpp"
 #include "CLValueByteSerializerTest.hpp"
 #include "DeployItemByteSerializerTest.hpp"
+#include "TypesTest.hpp"
+#include "VerificationTest.hpp"
+#include "EventStreamTest.hpp"
+#include "ConnectionTest.hpp"
+#include "ObservabilityTest.hpp"
 
 // Test Library
 #include "acutest.h"
@@ -65,6 +70,54 @@ void publicKey_getAccountHashTest() {
   TEST_ASSERT(iequals(lower_case_account_hash, expected_account_hash));
 }
 
+/// <summary>
+/// Check the cached and the bulk account hash derivation
+/// </summary>
+void publicKey_getAccountHashesTest() {
+  std::vector<Casper::PublicKey> keys{
+      Casper::PublicKey::FromHexString(
+          "01cd807fb41345d8dd5a61da7991e1468173acbee53920e4dfe0d28cb8825ac664"),
+      Casper::PublicKey::FromHexString(
+          "0202a6e2d25621758e2c92900f842ff367bbb5e4b6a849cacb43c3eaebf371b24b8"
+          "5")};
+
+  std::string expected_account_hash =
+      "account-hash-"
+      "998c5fd4e7b568bedd78e05555c83c61893dc5d8546ce0bec8b30e1c570f21aa";
+
+  TEST_ASSERT(iequals(keys[0].GetAccountHash(), expected_account_hash));
+  TEST_ASSERT(keys[0].GetBytes().size() == 33);
+  TEST_ASSERT(keys[0].GetBytes()[0] == 0x01);
+
+  // the copies share the computed values, which follow the key fields
+  Casper::PublicKey copied_key = keys[1];
+  TEST_ASSERT(copied_key.GetAccountHash() == keys[1].GetAccountHash());
+  TEST_ASSERT(copied_key.GetBytes().size() == 34);
+  TEST_ASSERT(copied_key.GetRawBytes() == keys[1].GetRawBytes());
+
+  copied_key.raw_bytes = keys[0].raw_bytes;
+  copied_key.key_algorithm = keys[0].key_algorithm;
+  TEST_ASSERT(copied_key.GetAccountHash() == keys[0].GetAccountHash());
+  TEST_ASSERT(copied_key.GetBytes() == keys[0].GetBytes());
+
+  // a moved-from key is still usable
+  Casper::PublicKey moved_key = std::move(copied_key);
+  TEST_ASSERT(moved_key.GetAccountHash() == keys[0].GetAccountHash());
+  TEST_ASSERT(copied_key.GetBytes().size() ==
+              copied_key.raw_bytes.size() + 1);
+
+  // the bulk API keeps the order of the input keys
+  std::vector<Casper::PublicKey> many_keys;
+  for (int i = 0; i < 64; i++) many_keys.push_back(keys[i % 2]);
+
+  std::vector<std::string> hashes =
+      Casper::PublicKey::GetAccountHashes(many_keys, 4);
+  TEST_ASSERT(hashes.size() == many_keys.size());
+  for (size_t i = 0; i < hashes.size(); i++) {
+    TEST_ASSERT(hashes[i] == keys[i % 2].GetAccountHash());
+  }
+}
+
 // to store list inside map map["List"]: list_inner_type
 CLTypeRVA createContainerMap(std::string key, CLTypeRVA value) {
   std::map<std::string, CLTypeRVA> cl_map_type;
@@ -426,9 +479,7 @@ void globalStateKey_serializer_test() {
   EraInfoKey era_info_key("era-2685");
 
   std::string expected_era_bytes_str = "057d0a000000000000";
-  // TODO:
-  // globalStateKey_serialize<EraInfoKey>(era_info_key,
-  // expected_era_bytes_str);
+  globalStateKey_serialize<EraInfoKey>(era_info_key, expected_era_bytes_str);
 }
 
 // Executable Deploy Item Byte Serializer Tests //
@@ -521,8 +572,34 @@ TEST_LIST = {
     {"PublicKey Load fromFile", publicKey_load_fromFileTest},
     {"getAccountHash checks internal PublicKey to AccountHash converter",
      publicKey_getAccountHashTest},
+    {"getAccountHashes checks cached and bulk account hashes",
+     publicKey_getAccountHashesTest},
     {"toLower checks internal lower case converter", stringUtil_toLowerTest},
     {"gsk test", globalStateKey_serializer_test},
+    {"DictionaryKey derived from a seed URef", dictionaryKey_fromSeedURefTest},
+    {"GlobalStateKey parsing", globalStateKey_parseTest},
+    {"Wide integer conversions", wideInteger_conversionsTest},
+    {"Timestamp and duration", timestampAndDuration_parseTest},
+    {"StoredValue and Transform JSON", storedValueAndTransform_jsonTest},
+    {"Merkle proof of a balance", merkleProof_balanceTest},
+    {"Merkle proof of an item", merkleProof_itemTest},
+    {"Merkle proof of a deeply nested type", merkleProof_nestedTypeTest},
+    {"Block hashes, proofs and parent linkage", blockVerifier_rangeTest},
+    {"Event stream decoding and resuming", eventStreamClient_resumeTest},
+    {"Multi node client failover and health", multiNodeClient_failoverTest},
+    {"Hedged read calls", multiNodeClient_hedgingTest},
+    {"Call deadlines and cancellation", client_deadlineAndCancellationTest},
+    {"Compressed responses", client_compressionTest},
+    {"Pre-rendered request templates", requestTemplate_renderTest},
+    {"Event loop and loopback transports", transport_implementationsTest},
+    {"Pipelined requests matched in order", eventLoopConnector_pipeliningTest},
+    {"Rate limit and call priorities", client_rateLimitAndPriorityTest},
+    {"RPC metrics", client_metricsTest},
+    {"Tracing spans", tracing_spansTest},
+    {"Logging sink", logging_sinkTest},
+    {"Mock node", mockNode_clientTest},
+    {"Batched dictionary items", client_dictionaryItemsBatchTest},
+    {"Record and replay connectors", recordReplay_connectorTest},
 
 #if RPC_TEST == 1
     {"infoGetPeers checks node list size", infoGetPeers_Test},
@@ -0,0 +1,708 @@
+#define TEST_NO_MAIN 1
+#include "ConnectionTest.hpp"
+#include "acutest.h"
+
+namespace Casper {
+
+void multiNodeClient_failoverTest() {
+  TestServer failing_server, lagging_server, server;
+  failing_server.StartRpc(
+      [](const nlohmann::json&) { return nlohmann::json(); });
+  lagging_server.StartRpc(
+      [](const nlohmann::json& request) { return nodeResult(request, 10); });
+  server.StartRpc(
+      [](const nlohmann::json& request) { return nodeResult(request, 100); });
+
+  Client client({failing_server.GetAddress(), lagging_server.GetAddress(),
+                 server.GetAddress()});
+
+  // every call fails over from the failing node until it is avoided
+  for (int i = 0; i < 10; i++) {
+    TEST_ASSERT(client.GetStateRootHash(uint64_t(1)).state_root_hash ==
+                "abcd");
+  }
+
+  std::vector<NodeStats> stats = client.GetNodeStats();
+  TEST_ASSERT(stats.size() == 3);
+  TEST_ASSERT(stats[0].error_count > 0 && stats[0].error_count < 10);
+  TEST_ASSERT(!stats[0].healthy);
+  TEST_ASSERT(stats[1].call_count + stats[2].call_count == 10);
+
+  // the lagging node is avoided once the tip heights are known
+  client.RefreshNodeStatus();
+  stats = client.GetNodeStats();
+  TEST_ASSERT(stats[1].tip_height == 10u && !stats[1].healthy);
+  TEST_ASSERT(stats[2].tip_height == 100u && stats[2].healthy);
+
+  uint64_t lagging_calls = stats[1].call_count;
+  client.GetStateRootHash(uint64_t(1));
+  TEST_ASSERT(client.GetNodeStats()[1].call_count == lagging_calls);
+
+  // the failing node is tried again once its error rate decayed
+  uint64_t failed_calls = client.GetNodeStats()[0].error_count;
+  client.SetErrorRateHalfLife(std::chrono::milliseconds(10));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  client.GetStateRootHash(uint64_t(1));
+  TEST_ASSERT(client.GetNodeStats()[0].error_count == failed_calls + 1);
+}
+
+void multiNodeClient_hedgingTest() {
+  TestServer slow_server, server;
+  slow_server.StartRpc([](const nlohmann::json& request) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(500));
+    return nodeResult(request, 100);
+  });
+  server.StartRpc(
+      [](const nlohmann::json& request) { return nodeResult(request, 100); });
+  std::vector<std::string> addresses{slow_server.GetAddress(),
+                                     server.GetAddress()};
+
+  HedgingPolicy policy;
+  policy.enabled = true;
+  policy.delay = std::chrono::milliseconds(20);
+  policy.budget = 1.0;
+
+  // the duplicates need a transport completing the calls in the background
+  auto event_loop = [](const std::string& address) {
+    return std::make_unique<EventLoopConnector>(address);
+  };
+
+  {
+    // the slow node is tried first, the duplicate answers first
+    Client client(addresses, event_loop);
+    client.SetHedgingPolicy(policy);
+
+    auto start = std::chrono::steady_clock::now();
+    TEST_ASSERT(client.GetStateRootHash(uint64_t(1)).state_root_hash ==
+                "abcd");
+    TEST_ASSERT(std::chrono::steady_clock::now() - start <
+                std::chrono::milliseconds(400));
+    TEST_ASSERT(client.GetHedgedCallCount() == 1);
+  }
+
+  {
+    // no duplicates without budget
+    policy.budget = 0;
+    Client client(addresses, event_loop);
+    client.SetHedgingPolicy(policy);
+
+    auto start = std::chrono::steady_clock::now();
+    client.GetStateRootHash(uint64_t(1));
+    TEST_ASSERT(std::chrono::steady_clock::now() - start >=
+                std::chrono::milliseconds(500));
+    TEST_ASSERT(client.GetHedgedCallCount() == 0);
+  }
+}
+
+void client_deadlineAndCancellationTest() {
+  std::mutex received_mutex;
+  std::condition_variable received_cv;
+  int received = 0;
+  TestServer slow_server;
+  slow_server.StartRpc([&](const nlohmann::json& request) {
+    {
+      std::lock_guard<std::mutex> lock(received_mutex);
+      received++;
+    }
+    received_cv.notify_all();
+    std::this_thread::sleep_for(std::chrono::milliseconds(1000));
+    return nodeResult(request, 100);
+  });
+
+  Client client(slow_server.GetAddress());
+
+  auto start = std::chrono::steady_clock::now();
+  int code = 0;
+  try {
+    CallScope scope(CallOptions::WithTimeout(std::chrono::milliseconds(100)));
+    client.GetStateRootHash(uint64_t(1));
+  } catch (jsonrpccxx::JsonRpcException& e) {
+    code = e.Code();
+  }
+  TEST_ASSERT(code == CALL_DEADLINE_EXCEEDED);
+  TEST_ASSERT(std::chrono::steady_clock::now() - start <
+              std::chrono::milliseconds(800));
+
+  // cancelled once the node received the call
+  CancellationToken token;
+  std::thread canceller([&, token]() mutable {
+    std::unique_lock<std::mutex> lock(received_mutex);
+    received_cv.wait(lock, [&] { return received == 2; });
+    token.Cancel();
+  });
+
+  start = std::chrono::steady_clock::now();
+  code = 0;
+  try {
+    CallScope scope(CallOptions::WithCancellation(token));
+    client.GetStateRootHash(uint64_t(1));
+  } catch (jsonrpccxx::JsonRpcException& e) {
+    code = e.Code();
+  }
+  canceller.join();
+  TEST_ASSERT(code == CALL_CANCELLED);
+  TEST_ASSERT(std::chrono::steady_clock::now() - start <
+              std::chrono::milliseconds(800));
+
+  // Unregister waits for the callback that a cancellation is running
+  CancellationToken stopping_token;
+  std::atomic<bool> callback_started(false);
+  std::atomic<bool> callback_done(false);
+  size_t registration = stopping_token.Register([&] {
+    callback_started = true;
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    callback_done = true;
+  });
+  std::thread stopper([stopping_token]() mutable { stopping_token.Cancel(); });
+  while (!callback_started) std::this_thread::yield();
+  stopping_token.Unregister(registration);
+  TEST_ASSERT(callback_done);
+  stopper.join();
+
+  // calls stopped by the caller are not node errors
+  TEST_ASSERT(client.GetNodeStats()[0].error_count == 0);
+  slow_server.Stop();
+}
+
+void client_compressionTest() {
+  std::string padding(100000, 'a');
+  std::mutex accept_encodings_mutex;
+  std::vector<std::string> accept_encodings;
+
+  TestServer server;
+  server.server.set_pre_routing_handler(
+      [&](const httplib::Request& req, httplib::Response&) {
+        std::lock_guard<std::mutex> lock(accept_encodings_mutex);
+        accept_encodings.push_back(req.get_header_value("Accept-Encoding"));
+        return httplib::Server::HandlerResponse::Unhandled;
+      });
+  server.StartRpc([&](const nlohmann::json& request) {
+    nlohmann::json result = nodeResult(request, 100);
+    result["padding"] = padding;
+    return result;
+  });
+
+  // the server compresses the response when asked to
+  httplib::Client raw_client(server.GetAddress());
+  raw_client.set_decompress(false);
+  auto raw_response = raw_client.Post(
+      "/rpc", httplib::Headers{{"Accept-Encoding", "gzip, deflate"}},
+      "{\"jsonrpc\":\"2.0\",\"id\":1,\"method\":\"chain_get_state_root_hash\"}",
+      "application/json");
+  TEST_ASSERT(raw_response &&
+              raw_response->get_header_value("Content-Encoding") == "gzip");
+  TEST_ASSERT(raw_response->body.size() < padding.size() / 10);
+
+  Client client(server.GetAddress());
+  TEST_ASSERT(client.GetStateRootHash(uint64_t(1)).state_root_hash == "abcd");
+  client.SetCompression(true);
+  TEST_ASSERT(client.GetStateRootHash(uint64_t(1)).state_root_hash == "abcd");
+
+  // the event loop transport inflates the responses too
+  Client event_loop_client(std::vector<std::string>{server.GetAddress()},
+                           [](const std::string& address) {
+                             return std::make_unique<EventLoopConnector>(
+                                 address);
+                           });
+  event_loop_client.SetCompression(true);
+  TEST_ASSERT(event_loop_client.GetStateRootHash(uint64_t(1))
+                  .state_root_hash == "abcd");
+
+  {
+    std::lock_guard<std::mutex> lock(accept_encodings_mutex);
+    TEST_ASSERT(accept_encodings.size() == 4);
+    TEST_ASSERT(accept_encodings[1].empty());
+    TEST_ASSERT(accept_encodings[2] == "gzip, deflate");
+    TEST_ASSERT(accept_encodings[3] == "gzip, deflate");
+  }
+}
+
+void transport_implementationsTest() {
+  TestServer server;
+  server.StartRpc([](const nlohmann::json& request) {
+    if (request["method"] == "slow") {
+      std::this_thread::sleep_for(std::chrono::milliseconds(300));
+    } else if (request["method"] == "fail") {
+      return nlohmann::json();
+    }
+    return nodeResult(request, 100);
+  });
+
+  // many requests in flight over a few connections
+  EventLoopConnector event_loop(server.GetAddress(), 4);
+  std::mutex mutex;
+  std::condition_variable done_cv;
+  size_t done = 0, succeeded = 0;
+  for (int i = 0; i < 32; i++) {
+    event_loop.SendAsync(
+        R"({"id":1,"jsonrpc":"2.0","method":"chain_get_state_root_hash"})",
+        [&](std::string&& response, std::exception_ptr error) {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!error && nlohmann::json::parse(response)["result"]
+                                                      ["state_root_hash"] ==
+                            "abcd") {
+            succeeded++;
+          }
+          done++;
+          done_cv.notify_all();
+        });
+  }
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    TEST_ASSERT(done_cv.wait_for(lock, std::chrono::seconds(10),
+                                 [&] { return done == 32; }));
+    TEST_ASSERT(succeeded == 32);
+  }
+  TEST_ASSERT(event_loop.GetConnectionCount() <= 4);
+
+  int code = 0;
+  try {
+    event_loop.Send(R"({"id":1,"jsonrpc":"2.0","method":"fail"})");
+  } catch (jsonrpccxx::JsonRpcException& e) {
+    code = e.Code();
+  }
+  TEST_ASSERT(code == TRANSPORT_ERROR);
+
+  code = 0;
+  try {
+    CallScope scope(CallOptions::WithTimeout(std::chrono::milliseconds(50)));
+    event_loop.Send(R"({"id":1,"jsonrpc":"2.0","method":"slow"})");
+  } catch (jsonrpccxx::JsonRpcException& e) {
+    code = e.Code();
+  }
+  TEST_ASSERT(code == CALL_DEADLINE_EXCEEDED);
+
+  // the client is unchanged over another transport
+  Client client(std::vector<std::string>{server.GetAddress()},
+                [](const std::string& address) {
+                  return std::make_unique<EventLoopConnector>(address);
+                });
+  TEST_ASSERT(client.GetStateRootHash(uint64_t(1)).state_root_hash == "abcd");
+
+  size_t loopback_calls = 0;
+  Client loopback_client(
+      std::vector<std::string>{"loopback"}, [&](const std::string&) {
+        return std::make_unique<LoopbackConnector>(
+            [&](const std::string& request) {
+              loopback_calls++;
+              nlohmann::json response{
+                  {"jsonrpc", "2.0"},
+                  {"id", 1},
+                  {"result",
+                   nodeResult(nlohmann::json::parse(request), 100)}};
+              return response.dump();
+            });
+      });
+  TEST_ASSERT(loopback_client.GetStateRootHash("").state_root_hash == "abcd");
+  TEST_ASSERT(loopback_calls == 1);
+}
+
+/// Answers the given number of JSON-RPC requests on a single connection with
+/// their ids, reading the pipelined requests from the same buffer. Listens on
+/// a free port, set in the address, before returning.
+std::thread servePipelined(int count, std::string& url) {
+  int listener = socket(AF_INET, SOCK_STREAM, 0);
+  sockaddr_in address{};
+  address.sin_family = AF_INET;
+  address.sin_port = 0;
+  address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+  bind(listener, reinterpret_cast<sockaddr*>(&address), sizeof(address));
+  listen(listener, 1);
+
+  socklen_t length = sizeof(address);
+  getsockname(listener, reinterpret_cast<sockaddr*>(&address), &length);
+  url = "http://127.0.0.1:" + std::to_string(ntohs(address.sin_port));
+
+  return std::thread([listener, count] {
+    int fd = accept(listener, nullptr, nullptr);
+    std::string input;
+    char buffer[4096];
+    for (int answered = 0; answered < count;) {
+      size_t head_end = input.find("\r\n\r\n");
+      size_t length_pos = input.find("Content-Length: ");
+      if (head_end != std::string::npos && length_pos < head_end) {
+        size_t length = std::stoul(input.substr(length_pos + 16));
+        if (input.size() >= head_end + 4 + length) {
+          nlohmann::json request =
+              nlohmann::json::parse(input.substr(head_end + 4, length));
+          input.erase(0, head_end + 4 + length);
+
+          nlohmann::json result{{"echo", request["id"]}};
+          std::string body = nlohmann::json{{"jsonrpc", "2.0"},
+                                            {"id", request["id"]},
+                                            {"result", result}}
+                                 .dump();
+          std::string response =
+              "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\n"
+              "Content-Length: " +
+              std::to_string(body.size()) + "\r\n\r\n" + body;
+          send(fd, response.data(), response.size(), 0);
+          answered++;
+          continue;
+        }
+      }
+
+      ssize_t n = recv(fd, buffer, sizeof(buffer), 0);
+      if (n <= 0) break;
+      input.append(buffer, n);
+    }
+    close(fd);
+    close(listener);
+  });
+}
+
+/// Sends "echo" calls with the ids from 1 to count and returns the number of
+/// responses with the id of their request.
+size_t sendEchoCalls(EventLoopConnector& connector, int count) {
+  std::mutex mutex;
+  std::condition_variable done_cv;
+  int done = 0;
+  size_t matched = 0;
+  for (int i = 1; i <= count; i++) {
+    connector.SendAsync(
+        RequestTemplate("echo").Render(static_cast<uint64_t>(i)),
+        [&, i](std::string&& response, std::exception_ptr error) {
+          std::lock_guard<std::mutex> lock(mutex);
+          if (!error &&
+              nlohmann::json::parse(response)["result"]["echo"] == i) {
+            matched++;
+          }
+          done++;
+          done_cv.notify_all();
+        });
+  }
+
+  std::unique_lock<std::mutex> lock(mutex);
+  done_cv.wait_for(lock, std::chrono::seconds(10),
+                   [&] { return done == count; });
+  return matched;
+}
+
+void eventLoopConnector_pipeliningTest() {
+  // the requests are written back to back on one connection
+  std::string pipelined_url;
+  std::thread pipelined_thread = servePipelined(64, pipelined_url);
+  {
+    EventLoopConnector event_loop(pipelined_url, 1, 8);
+    TEST_ASSERT(sendEchoCalls(event_loop, 64) == 64);
+    TEST_ASSERT(event_loop.GetPipelineDepth() == 8);
+  }
+  pipelined_thread.join();
+
+  // httplib drops the pipelined requests, pipelining is turned off and the
+  // requests in flight fail
+  TestServer server;
+  server.StartRpc([](const nlohmann::json& request) {
+    return nlohmann::json{{"echo", request["id"]}};
+  });
+  {
+    EventLoopConnector event_loop(server.GetAddress(), 1, 8);
+    TEST_ASSERT(sendEchoCalls(event_loop, 64) < 64);
+    TEST_ASSERT(event_loop.GetPipelineDepth() == 1);
+    TEST_ASSERT(sendEchoCalls(event_loop, 64) == 64);
+  }
+}
+
+void client_rateLimitAndPriorityTest() {
+  std::mutex mutex;
+  std::vector<std::string> identifiers;
+  Client client(std::vector<std::string>{"loopback"}, [&](const std::string&) {
+    return std::make_unique<LoopbackConnector>([&](const std::string& request) {
+      nlohmann::json json = nlohmann::json::parse(request);
+      {
+        std::lock_guard<std::mutex> lock(mutex);
+        identifiers.push_back(
+            json["params"]["block_identifier"].begin().key());
+      }
+      return nlohmann::json{{"jsonrpc", "2.0"},
+                            {"id", json["id"]},
+                            {"result", nodeResult(json, 100)}}
+          .dump();
+    });
+  });
+  client.SetRateLimit(20);
+
+  auto start = std::chrono::steady_clock::now();
+  std::vector<std::thread> bulk_threads;
+  for (int i = 0; i < 6; i++) {
+    bulk_threads.emplace_back([&client] {
+      CallScope scope(CallOptions::WithPriority(CallPriority::Bulk));
+      client.GetStateRootHash(uint64_t(1));
+    });
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(60));
+
+  // overtakes the waiting bulk calls
+  {
+    CallScope scope(CallOptions::WithPriority(CallPriority::Interactive));
+    client.GetStateRootHash("");
+  }
+
+  // gives up waiting at the deadline
+  int code = 0;
+  try {
+    CallScope scope(CallOptions::WithTimeout(std::chrono::milliseconds(10)));
+    client.GetStateRootHash(uint64_t(1));
+  } catch (jsonrpccxx::JsonRpcException& e) {
+    code = e.Code();
+  }
+  TEST_ASSERT(code == CALL_DEADLINE_EXCEEDED);
+
+  for (auto& thread : bulk_threads) thread.join();
+  auto elapsed = std::chrono::steady_clock::now() - start;
+
+  std::lock_guard<std::mutex> lock(mutex);
+  TEST_ASSERT(identifiers.size() == 7);
+  size_t interactive =
+      std::find(identifiers.begin(), identifiers.end(), "Hash") -
+      identifiers.begin();
+  TEST_ASSERT(interactive < 4);
+  // 7 calls at 20 per second, the first one without waiting
+  TEST_ASSERT(elapsed >= std::chrono::milliseconds(280));
+}
+
+void mockNode_clientTest() {
+  MockNodeOptions options;
+  options.result_size = 5;
+  MockNode node(options);
+  node.Start();
+  Client client(node.GetAddress());
+
+  // every method of the client gets a synthetic result
+  TEST_ASSERT(client.GetNodePeers().peers.size() == 5);
+  TEST_ASSERT(client.GetStateRootHash(uint64_t(10)).state_root_hash.size() ==
+              64);
+  TEST_ASSERT(client.GetStatusInfo().last_added_block_info->height == 1000u);
+  GetBlockResult block = client.GetBlock(uint64_t(42));
+  TEST_ASSERT(block.block->header.height == 42u);
+  TEST_ASSERT(block.block->body.deploy_hashes.size() == 5);
+  TEST_ASSERT(block.block->proofs.size() == 5);
+  TEST_ASSERT(client.GetBlockTransfers(uint64_t(42)).transfers->size() == 5);
+  TEST_ASSERT(client.GetEraInfoBySwitchBlock(uint64_t(4200))
+                  .era_summary->stored_value.GetType() ==
+              StoredValueType::EraInfo);
+  std::string deploy_hash =
+      "bba5fb89a48f71e6d00077a56854df3bbafb7ad4c1332f3956f1c2f2f97257fe";
+  TEST_ASSERT(client.GetDeployInfo(deploy_hash).execution_results.size() ==
+              1);
+  TEST_ASSERT(client.GetItem("abcd", "hash-abcd", {})
+                  .stored_value.GetType() == StoredValueType::CLValue);
+  std::string uref =
+      "uref-0000000000000000000000000000000000000000000000000000000000000000"
+      "-007";
+  TEST_ASSERT(client.GetDictionaryItemByURef("abcd", uref, "key")
+                  .stored_value.GetType() == StoredValueType::CLValue);
+  TEST_ASSERT(client.GetDictionaryItemsByURef("abcd", uref, {"a", "b"})
+                  .size() == 2);
+  TEST_ASSERT(client.GetAccountBalance(uref, "abcd").balance_value ==
+              u512FromDec("2500000000000"));
+  TEST_ASSERT(client.GetAuctionInfo(uint64_t(42)).auction_state.bids.size() ==
+              5);
+  TEST_ASSERT(node.GetCallCount("chain_get_block") == 1);
+
+  // recorded results replace the synthetic ones
+  std::string file_path = __FILE__;
+  std::string dir_path = file_path.substr(0, file_path.rfind("/"));
+  TEST_ASSERT(node.LoadResults(dir_path + "/data/Rpc") == 2);
+  TEST_ASSERT(client.GetBlock(uint64_t(42)).block->header.height ==
+              738295u);
+
+  options.latency = std::chrono::milliseconds(20);
+  options.error_rate = 1;
+  options.error_code = -32001;
+  node.SetOptions(options);
+  auto start = std::chrono::steady_clock::now();
+  int code = 0;
+  try {
+    client.GetStateRootHash(uint64_t(10));
+  } catch (jsonrpccxx::JsonRpcException& e) {
+    code = e.Code();
+  }
+  TEST_ASSERT(code == -32001);
+  TEST_ASSERT(std::chrono::steady_clock::now() - start >=
+              std::chrono::milliseconds(20));
+}
+
+/// <summary>
+/// Dictionary items are fetched in one batch, and one by one only once the
+/// node rejects the batch itself. Transport and item errors are thrown.
+/// </summary>
+void client_dictionaryItemsBatchTest() {
+  MockNode node;
+  int batches = 0;
+  int calls = 0;
+  bool transport_error = false;
+  bool item_error = false;
+  bool batch_rejected = false;
+  Client client(std::vector<std::string>{"loopback"}, [&](const std::string&) {
+    return std::make_unique<LoopbackConnector>([&](const std::string& request) {
+      if (transport_error) {
+        throw jsonrpccxx::JsonRpcException(TRANSPORT_ERROR, "unreachable");
+      }
+      if (request.front() != '[') {
+        calls++;
+        return node.HandleRequest(request);
+      }
+
+      batches++;
+      if (batch_rejected) {
+        return nlohmann::json{{"jsonrpc", "2.0"},
+                              {"id", nullptr},
+                              {"error",
+                               {{"code", jsonrpccxx::method_not_found},
+                                {"message", "Method not found"}}}}
+            .dump();
+      }
+      nlohmann::json response =
+          nlohmann::json::parse(node.HandleRequest(request));
+      if (item_error) {
+        response[0].erase("result");
+        response[0]["error"] = {{"code", -32001}, {"message", "no item"}};
+      }
+      return response.dump();
+    });
+  });
+
+  std::string uref =
+      "uref-0000000000000000000000000000000000000000000000000000000000000000"
+      "-007";
+  std::vector<std::string> keys{"a", "b"};
+
+  transport_error = true;
+  TEST_EXCEPTION(client.GetDictionaryItemsByURef("abcd", uref, keys),
+                 jsonrpccxx::JsonRpcException);
+  transport_error = false;
+
+  item_error = true;
+  TEST_EXCEPTION(client.GetDictionaryItemsByURef("abcd", uref, keys),
+                 jsonrpccxx::JsonRpcException);
+  item_error = false;
+
+  // the batch is still used after the errors
+  TEST_ASSERT(client.GetDictionaryItemsByURef("abcd", uref, keys).size() == 2);
+  TEST_ASSERT(batches == 2 && calls == 0);
+
+  // a rejected batch is sent again one call at a time, then never again
+  client.ClearDictionaryItemCache();
+  batch_rejected = true;
+  TEST_ASSERT(client.GetDictionaryItemsByURef("abcd", uref, keys).size() == 2);
+  TEST_ASSERT(batches == 3 && calls == 2);
+  client.ClearDictionaryItemCache();
+  TEST_ASSERT(client.GetDictionaryItemsByURef("abcd", uref, keys).size() == 2);
+  TEST_ASSERT(batches == 3 && calls == 4);
+
+  // the batches are measured like the single calls, with their errors
+  MethodMetricsSnapshot metrics =
+      client.GetMetrics().at("state_get_dictionary_item");
+  TEST_ASSERT(metrics.call_count == 8);
+  TEST_ASSERT(metrics.error_count == 2);
+  TEST_ASSERT(metrics.error_codes[TRANSPORT_ERROR] == 1);
+  TEST_ASSERT(metrics.error_codes[-32001] == 1);
+}
+
+void recordReplay_connectorTest() {
+  std::string path = "/tmp/casper_sdk_replay_test.log";
+  MockNode node;
+  node.Start();
+  GetBlockResult block;
+  {
+    auto log = std::make_shared<RpcLogWriter>(path);
+    Client client(
+        std::vector<std::string>{node.GetAddress()},
+        RecordingConnector::Wrap(MultiNodeConnector::DefaultTransportFactory,
+                                 log));
+    block = client.GetBlock(uint64_t(42));
+    client.GetStateRootHash(uint64_t(42));
+    nlohmann::json status = MockNode::MakeResult("info_get_status", {}, 1);
+    status["uptime"] = "1s";
+    node.SetResult("info_get_status", status);
+    client.GetStatusInfo();
+    status["uptime"] = "2s";
+    node.SetResult("info_get_status", status);
+    client.GetStatusInfo();
+    TEST_ASSERT(log->GetRecordCount() == 4);
+  }
+  node.Stop();
+
+  // served without the node, with the ids of the new requests
+  Client client(std::vector<std::string>{"replay"}, [&](const std::string&) {
+    return std::make_unique<ReplayConnector>(path);
+  });
+  client.GetStateRootHash(uint64_t(42));
+  TEST_ASSERT(client.GetBlock(uint64_t(42)).block->hash == block.block->hash);
+  TEST_ASSERT(client.GetStatusInfo().uptime == "1s");
+  TEST_ASSERT(client.GetStatusInfo().uptime == "2s");
+  TEST_ASSERT(client.GetStatusInfo().uptime == "1s");
+
+  int code = 0;
+  try {
+    client.GetBlock(uint64_t(43));
+  } catch (jsonrpccxx::JsonRpcException& e) {
+    code = e.Code();
+  }
+  TEST_ASSERT(code == TRANSPORT_ERROR);
+  std::remove(path.c_str());
+
+  // write errors are reported, and the log takes no more pairs after them
+  RpcLogWriter full_log("/dev/full");
+  full_log.Append("{}", "{}");
+  TEST_EXCEPTION(full_log.Flush(), std::runtime_error);
+  TEST_EXCEPTION(full_log.Append("{}", "{}"), std::runtime_error);
+}
+
+void requestTemplate_renderTest() {
+  // same text as the requests of jsonrpccxx
+  RequestTemplate get_item("state_get_item",
+                           R"({"key":$,"path":$,"state_root_hash":$})");
+  std::vector<std::string> path{"a\"b", "c\\d\n"};
+  nlohmann::json expected{
+      {"jsonrpc", "2.0"},
+      {"id", 7},
+      {"method", "state_get_item"},
+      {"params",
+       {{"state_root_hash", "abcd"}, {"key", "hash-01"}, {"path", path}}}};
+  TEST_ASSERT(get_item.Render(7, std::string("hash-01"), path,
+                              std::string("abcd")) == expected.dump());
+
+  RequestTemplate get_block("chain_get_block",
+                            R"({"block_identifier":{"Height":$}})");
+  std::string request;
+  get_block.RenderTo(request, 1, uint64_t(18446744073709551615u));
+  TEST_ASSERT(nlohmann::json::parse(request)["params"]["block_identifier"]
+                                              ["Height"]
+                                                  .get<uint64_t>() ==
+              18446744073709551615u);
+
+  RequestTemplate get_status("info_get_status");
+  TEST_ASSERT(get_status.GetSlotCount() == 0);
+  TEST_ASSERT(get_status.Render(1) ==
+              R"({"id":1,"jsonrpc":"2.0","method":"info_get_status"})");
+
+  TEST_EXCEPTION(get_block.Render(1), std::invalid_argument);
+
+  // the client checks the id of each response against its request
+  uint64_t response_id = 1;
+  Client client(std::vector<std::string>{"loopback"}, [&](const std::string&) {
+    return std::make_unique<LoopbackConnector>([&](const std::string& request) {
+      nlohmann::json response{
+          {"jsonrpc", "2.0"},
+          {"id", response_id},
+          {"result", nodeResult(nlohmann::json::parse(request), 100)}};
+      return response.dump();
+    });
+  });
+  TEST_ASSERT(client.GetStateRootHash("").state_root_hash == "abcd");
+
+  int code = 0;
+  try {
+    client.GetStateRootHash("");
+  } catch (jsonrpccxx::JsonRpcException& e) {
+    code = e.Code();
+  }
+  TEST_ASSERT(code == jsonrpccxx::internal_error);
+
+  response_id = 3;
+  TEST_ASSERT(client.GetStateRootHash("").state_root_hash == "abcd");
+}
+
+}  // namespace Casper
@@ -0,0 +1,31 @@
+#pragma once
+
+#include "CasperClient.h"
+#include "MockNode.h"
+#include "TestServer.hpp"
+
+namespace Casper {
+
+void multiNodeClient_failoverTest(void);
+
+void multiNodeClient_hedgingTest(void);
+
+void client_deadlineAndCancellationTest(void);
+
+void client_compressionTest(void);
+
+void transport_implementationsTest(void);
+
+void eventLoopConnector_pipeliningTest(void);
+
+void client_rateLimitAndPriorityTest(void);
+
+void mockNode_clientTest(void);
+
+void client_dictionaryItemsBatchTest(void);
+
+void recordReplay_connectorTest(void);
+
+void requestTemplate_renderTest(void);
+
+}  // namespace Casper
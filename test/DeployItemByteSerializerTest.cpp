@@ -136,6 +136,16 @@ void DeployItem_ByteSer_Transfer_Test() {
 
   std::cout << "transfer item: " << actual_transfer_bytes << std::endl;
   TEST_ASSERT(expected_transfer_item_str == actual_transfer_bytes);
+
+  // the item keeps its type through JSON
+  nlohmann::json j = ExecutableDeployItem(transfer_item);
+  TEST_ASSERT(j.contains("Transfer"));
+  ExecutableDeployItem item = j.get<ExecutableDeployItem>();
+  TEST_ASSERT(item.GetType() == ExecutableDeployItemType::Transfer);
+  TEST_ASSERT(item.GetIf<ExecutableDeployItemType::ModuleBytes>() == nullptr);
+  TEST_ASSERT(
+      item.Get<ExecutableDeployItemType::Transfer>().args.size() == 3);
+  TEST_ASSERT(hexEncode(ser.ToBytes(item)) == expected_transfer_item_str);
 }
 
 }  // namespace Casper
\ No newline at end of file
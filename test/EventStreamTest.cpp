@@ -0,0 +1,121 @@
+#define TEST_NO_MAIN 1
+#include "EventStreamTest.hpp"
+#include "acutest.h"
+
+namespace Casper {
+
+/// Serves a BlockAdded, a Step, a DeployProcessed and a FinalitySignature
+/// event, from the requested "start_from" id. The "start_from" ids are
+/// added to start_froms, with a notification.
+void serveEvents(httplib::Server& server, std::vector<uint64_t>& start_froms,
+                 std::mutex& start_froms_mutex,
+                 std::condition_variable& start_froms_cv) {
+  nlohmann::json blocks = nlohmann::json::parse(linked_blocks_json);
+  nlohmann::json block = blocks[1];
+  nlohmann::json proof = block["proofs"][0];
+
+  std::vector<nlohmann::json> events = {
+      {{"BlockAdded", {{"block_hash", block["hash"]}, {"block", block}}}},
+      {{"Step", {{"era_id", 4}}}},
+      {{"DeployProcessed",
+        {{"deploy_hash", block["body"]["deploy_hashes"][0]},
+         {"account", proof["public_key"]},
+         {"timestamp", "2022-03-08T16:10:58.304Z"},
+         {"ttl", "30m"},
+         {"dependencies", nlohmann::json::array()},
+         {"block_hash", block["hash"]},
+         {"execution_result",
+          {{"Success",
+            {{"effect",
+              {{"operations", nlohmann::json::array()},
+               {"transforms", nlohmann::json::array()}}},
+             {"transfers", nlohmann::json::array()},
+             {"cost", "100"}}}}}}}},
+      {{"FinalitySignature",
+        {{"block_hash", block["hash"]},
+         {"era_id", block["header"]["era_id"]},
+         {"signature", proof["signature"]},
+         {"public_key", proof["public_key"]}}}}};
+
+  server.Get("/events/main", [&, events](const httplib::Request& req,
+                                         httplib::Response& res) {
+    uint64_t start_from = 0;
+    if (req.has_param("start_from")) {
+      start_from = std::stoull(req.get_param_value("start_from"));
+    }
+    {
+      std::lock_guard<std::mutex> lock(start_froms_mutex);
+      start_froms.push_back(start_from);
+    }
+    start_froms_cv.notify_all();
+
+    std::string body = "data:{\"ApiVersion\":\"1.4.5\"}\n\n:keep-alive\n\n";
+    for (uint64_t id = start_from; id < events.size(); id++) {
+      body += "data:" + events[id].dump() + "\nid:" + std::to_string(id) +
+              "\n\n";
+    }
+
+    res.set_chunked_content_provider(
+        "text/event-stream", [body](size_t, httplib::DataSink& sink) {
+          // split the stream in the middle of a message
+          size_t half = body.size() / 2;
+          sink.write(body.data(), half);
+          sink.write(body.data() + half, body.size() - half);
+          sink.done();
+          return true;
+        });
+  });
+}
+
+void eventStreamClient_resumeTest() {
+  std::vector<uint64_t> start_froms;
+  std::mutex start_froms_mutex;
+  std::condition_variable start_froms_cv;
+  TestServer server;
+  serveEvents(server.server, start_froms, start_froms_mutex, start_froms_cv);
+  server.Start();
+
+  // a single slot queue makes the reader wait for the consumer
+  EventStreamClient client(server.GetAddress(), EVENTS_MAIN_PATH, 1);
+  client.SetReconnectDelay(std::chrono::milliseconds(10));
+  client.Start(1);
+
+  Event event;
+  TEST_ASSERT(client.TryPop(event, std::chrono::seconds(5)));
+  TEST_ASSERT(event.id == 2u);
+  TEST_ASSERT(event.deploy_processed.has_value());
+  TEST_ASSERT(
+      event.deploy_processed.value().execution_result.success.has_value());
+
+  TEST_ASSERT(client.TryPop(event, std::chrono::seconds(5)));
+  TEST_ASSERT(event.id == 3u);
+  TEST_ASSERT(event.finality_signature.has_value());
+  TEST_ASSERT(event.finality_signature.value().era_id == 4u);
+
+  // the stream is resumed after the last event once the connection drops
+  {
+    std::unique_lock<std::mutex> lock(start_froms_mutex);
+    TEST_ASSERT(start_froms_cv.wait_for(lock, std::chrono::seconds(5), [&] {
+      return std::find(start_froms.begin(), start_froms.end(), 4u) !=
+             start_froms.end();
+    }));
+  }
+  TEST_ASSERT(client.GetLastEventId() == 3u);
+  TEST_ASSERT(client.GetApiVersion() == "1.4.5");
+
+  client.Stop();
+  TEST_ASSERT(!client.Pop(event));
+
+  // from the start of the stream, the Step event is skipped
+  client.Start(0);
+  TEST_ASSERT(client.TryPop(event, std::chrono::seconds(5)));
+  TEST_ASSERT(event.id == 0u);
+  TEST_ASSERT(event.block_added.has_value());
+  TEST_ASSERT(event.block_added.value().block.header.height == 11u);
+  TEST_ASSERT(client.TryPop(event, std::chrono::seconds(5)));
+  TEST_ASSERT(event.id == 2u);
+  client.Stop();
+  server.Stop();
+}
+
+}  // namespace Casper
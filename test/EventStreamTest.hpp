@@ -0,0 +1,11 @@
+#pragma once
+
+#include "EventStreamClient.h"
+#include "TestServer.hpp"
+#include "VerificationTest.hpp"
+
+namespace Casper {
+
+void eventStreamClient_resumeTest(void);
+
+}  // namespace Casper
@@ -0,0 +1,509 @@
+#include "MockNode.h"
+
+#include <fstream>
+
+namespace Casper {
+
+namespace {
+
+const char* API_VERSION = "1.4.5";
+
+/// Returns the given number of pseudo-random bytes in hex, the same for the
+/// same seed.
+std::string Hex(uint64_t seed, size_t bytes) {
+  static const char* DIGITS = "0123456789abcdef";
+  std::string hex;
+  hex.reserve(bytes * 2);
+  uint64_t state = seed * 0x9e3779b97f4a7c15ULL + 1;
+  while (hex.size() < bytes * 2) {
+    // splitmix64
+    state += 0x9e3779b97f4a7c15ULL;
+    uint64_t z = state;
+    z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+    z ^= z >> 31;
+    for (int i = 0; i < 16 && hex.size() < bytes * 2; i++) {
+      hex.push_back(DIGITS[(z >> (i * 4)) & 0xf]);
+    }
+  }
+  return hex;
+}
+
+std::string PublicKeyHex(uint64_t seed) { return "01" + Hex(seed, 32); }
+
+/// A transfer deploy of the testnet.
+const char* TRANSFER_DEPLOY = R"({
+  "hash": "bba5fb89a48f71e6d00077a56854df3bbafb7ad4c1332f3956f1c2f2f97257fe",
+  "header": {
+    "account": "02033d06a3e1f9b96cf353f4086620b6e0529035eb1f02805cb67e8831c372488d4f",
+    "timestamp": "2022-04-23T09:38:21.700Z",
+    "ttl": "30m",
+    "gas_price": 1,
+    "body_hash": "a3f5147282396f8c0bdb7984c62374d9899b6c6cc953a3909c6c1fa1232cd93c",
+    "dependencies": [],
+    "chain_name": "casper-test"
+  },
+  "payment": {
+    "ModuleBytes": {
+      "module_bytes": "",
+      "args": [["amount", {"cl_type": "U512", "bytes": "0400e1f505",
+                           "parsed": "100000000"}]]
+    }
+  },
+  "session": {
+    "Transfer": {
+      "args": [
+        ["amount", {"cl_type": "U512", "bytes": "050026e85a05",
+                    "parsed": "23000000000"}],
+        ["target", {"cl_type": "PublicKey",
+                    "bytes": "0202a6e2d25621758e2c92900f842ff367bbb5e4b6a849cacb43c3eaebf371b24b85",
+                    "parsed": "0202a6e2d25621758e2c92900f842ff367bbb5e4b6a849cacb43c3eaebf371b24b85"}],
+        ["id", {"cl_type": {"Option": "U64"}, "bytes": "01a223c95580010000",
+                "parsed": 1650706686882}]
+      ]
+    }
+  },
+  "approvals": [
+    {
+      "signer": "02033d06a3e1f9b96cf353f4086620b6e0529035eb1f02805cb67e8831c372488d4f",
+      "signature": "02e2118901d6bb3758cff81a996c5a7229671bf62843bfdb3658757436431b6d9869c801113916491c70cc6e151851b7aa9e48d5d75e77bf986d0e2bde0b7fa1df"
+    }
+  ]
+})";
+
+nlohmann::json MakeTransfer(uint64_t seed, const std::string& deploy_hash) {
+  return {{"deploy_hash", deploy_hash},
+          {"from", "account-hash-" + Hex(seed, 32)},
+          {"to", "account-hash-" + Hex(seed + 1, 32)},
+          {"source", "uref-" + Hex(seed + 2, 32) + "-007"},
+          {"target", "uref-" + Hex(seed + 3, 32) + "-004"},
+          {"amount", "23000000000"},
+          {"gas", "0"},
+          {"id", seed}};
+}
+
+/// Returns the height of a block identifier, or the default height.
+uint64_t GetHeight(const nlohmann::json& params) {
+  auto identifier = params.find("block_identifier");
+  if (identifier != params.end() && identifier->is_object() &&
+      identifier->contains("Height")) {
+    return identifier->at("Height").get<uint64_t>();
+  }
+  return 1000;
+}
+
+std::string GetString(const nlohmann::json& params, const char* name,
+                      const std::string& default_value) {
+  auto value = params.find(name);
+  if (value != params.end() && value->is_string()) {
+    return value->get<std::string>();
+  }
+  return default_value;
+}
+
+nlohmann::json MakeError(const nlohmann::json& id, int code,
+                         const std::string& message) {
+  return {{"jsonrpc", "2.0"},
+          {"id", id},
+          {"error", {{"code", code}, {"message", message}}}};
+}
+
+}  // namespace
+
+const std::vector<std::string> MockNode::METHODS{
+    "info_get_peers",
+    "chain_get_state_root_hash",
+    "info_get_deploy",
+    "info_get_status",
+    "chain_get_block_transfers",
+    "chain_get_block",
+    "chain_get_era_info_by_switch_block",
+    "state_get_item",
+    "state_get_dictionary_item",
+    "state_get_balance",
+    "state_get_auction_info",
+    "account_put_deploy"};
+
+MockNode::MockNode(MockNodeOptions options)
+    : mOptions(options), mRandom(options.seed) {
+  mServer.new_task_queue = [this] {
+    return new httplib::ThreadPool(std::max<size_t>(1, mOptions.threads));
+  };
+  mServer.set_keep_alive_max_count(1000000);
+  // the headers and the body are written separately, without TCP_NODELAY
+  // the body waits for the delayed ack of the client
+  mServer.set_tcp_nodelay(true);
+  mServer.Post("/rpc", [this](const httplib::Request& request,
+                              httplib::Response& response) {
+    OnRequest(request, response);
+  });
+}
+
+MockNode::~MockNode() { Stop(); }
+
+int MockNode::Start(const std::string& host, int port) {
+  if (port == 0) {
+    port = mServer.bind_to_any_port(host.c_str());
+  } else if (!mServer.bind_to_port(host.c_str(), port)) {
+    port = -1;
+  }
+  if (port < 0) {
+    throw std::runtime_error("MockNode: cannot listen on " + host);
+  }
+
+  mHost = host;
+  mPort = port;
+  mThread = std::thread([this] { mServer.listen_after_bind(); });
+  while (!mServer.is_running()) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  return port;
+}
+
+void MockNode::Stop() {
+  if (mThread.joinable()) {
+    mServer.stop();
+    mThread.join();
+  }
+}
+
+std::string MockNode::GetAddress() const {
+  return "http://" + mHost + ":" + std::to_string(mPort);
+}
+
+void MockNode::SetResult(const std::string& method, nlohmann::json result) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  mResults[method] = std::move(result);
+}
+
+size_t MockNode::LoadResults(const std::string& directory) {
+  size_t count = 0;
+  for (auto& method : METHODS) {
+    std::ifstream ifs(directory + "/" + method + ".json");
+    if (!ifs) continue;
+    SetResult(method, nlohmann::json::parse(ifs));
+    count++;
+  }
+  return count;
+}
+
+void MockNode::SetOptions(const MockNodeOptions& options) {
+  std::lock_guard<std::mutex> lock(mMutex);
+  size_t threads = mOptions.threads;
+  mOptions = options;
+  // the thread pool is created when the node starts
+  mOptions.threads = threads;
+}
+
+MockNodeOptions MockNode::GetOptions() const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  return mOptions;
+}
+
+uint64_t MockNode::GetCallCount(const std::string& method) const {
+  std::lock_guard<std::mutex> lock(mMutex);
+  if (!method.empty()) {
+    auto it = mCallCounts.find(method);
+    return it == mCallCounts.end() ? 0 : it->second;
+  }
+
+  uint64_t count = 0;
+  for (auto& [name, calls] : mCallCounts) count += calls;
+  return count;
+}
+
+std::string MockNode::HandleRequest(const std::string& request) {
+  nlohmann::json json;
+  try {
+    json = nlohmann::json::parse(request);
+  } catch (nlohmann::json::parse_error& e) {
+    return MakeError(nullptr, -32700, "Parse error").dump();
+  }
+
+  if (!json.is_array()) return HandleCall(json).dump();
+
+  nlohmann::json responses = nlohmann::json::array();
+  for (auto& call : json) responses.push_back(HandleCall(call));
+  return responses.dump();
+}
+
+nlohmann::json MockNode::HandleCall(const nlohmann::json& call) {
+  if (!call.is_object()) return MakeError(nullptr, -32600, "Invalid Request");
+
+  nlohmann::json id = call.value("id", nlohmann::json());
+  if (!call.contains("method") || !call.at("method").is_string()) {
+    return MakeError(id, -32600, "Invalid Request");
+  }
+
+  std::string method = call.at("method").get<std::string>();
+  nlohmann::json params = call.value("params", nlohmann::json::object());
+
+  nlohmann::json result;
+  size_t result_size;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    mCallCounts[method]++;
+    auto recorded = mResults.find(method);
+    if (recorded != mResults.end()) result = recorded->second;
+    result_size = mOptions.result_size;
+  }
+
+  if (result.is_null()) result = MakeResult(method, params, result_size);
+  if (result.is_null()) return MakeError(id, -32601, "Method not found");
+
+  return {{"jsonrpc", "2.0"}, {"id", id}, {"result", std::move(result)}};
+}
+
+void MockNode::OnRequest(const httplib::Request& request,
+                         httplib::Response& response) {
+  std::chrono::microseconds latency;
+  bool http_error, rpc_error;
+  int error_code;
+  std::string error_message;
+  {
+    std::lock_guard<std::mutex> lock(mMutex);
+    latency = mOptions.latency;
+    if (mOptions.latency_jitter.count() > 0) {
+      latency += std::chrono::microseconds(
+          std::uniform_int_distribution<int64_t>(
+              0, mOptions.latency_jitter.count())(mRandom));
+    }
+    std::uniform_real_distribution<double> uniform(0, 1);
+    http_error = uniform(mRandom) < mOptions.http_error_rate;
+    rpc_error = uniform(mRandom) < mOptions.error_rate;
+    error_code = mOptions.error_code;
+    error_message = mOptions.error_message;
+  }
+
+  if (latency.count() > 0) std::this_thread::sleep_for(latency);
+
+  if (http_error) {
+    response.status = 503;
+    return;
+  }
+
+  if (rpc_error) {
+    auto id_of = [](const nlohmann::json& call) {
+      return call.is_object() ? call.value("id", nlohmann::json())
+                              : nlohmann::json();
+    };
+    nlohmann::json json = nlohmann::json::parse(request.body, nullptr, false);
+    nlohmann::json error;
+    if (json.is_array()) {
+      error = nlohmann::json::array();
+      for (auto& call : json) {
+        error.push_back(MakeError(id_of(call), error_code, error_message));
+      }
+    } else {
+      error = MakeError(id_of(json), error_code, error_message);
+    }
+    response.set_content(error.dump(), "application/json");
+    return;
+  }
+
+  response.set_content(HandleRequest(request.body), "application/json");
+}
+
+nlohmann::json MockNode::MakeResult(const std::string& method,
+                                    const nlohmann::json& params,
+                                    size_t result_size) {
+  nlohmann::json result{{"api_version", API_VERSION}};
+
+  if (method == "info_get_peers" || method == "info_get_status") {
+    nlohmann::json peers = nlohmann::json::array();
+    for (size_t i = 0; i < result_size; i++) {
+      peers.push_back({{"node_id", "tls:" + Hex(100 + i, 5)},
+                       {"address", "10.0." + std::to_string(i / 250) + "." +
+                                       std::to_string(i % 250 + 1) +
+                                       ":35000"}});
+    }
+    result["peers"] = peers;
+    if (method == "info_get_peers") return result;
+
+    result["chainspec_name"] = "casper-test";
+    result["starting_state_root_hash"] = Hex(1, 32);
+    result["last_added_block_info"] = {
+        {"hash", Hex(1000, 32)},
+        {"timestamp", "2022-04-23T09:38:48.704Z"},
+        {"era_id", 4213},
+        {"height", 1000},
+        {"state_root_hash", Hex(2, 32)},
+        {"creator", PublicKeyHex(3)}};
+    result["our_public_signing_key"] = PublicKeyHex(4);
+    result["round_length"] = "32s 768ms";
+    result["next_upgrade"] = nullptr;
+    result["build_version"] = "1.4.5-a7f6a648d-casper-mainnet";
+    result["uptime"] = "13days 2h 11m 25s 386ms";
+    return result;
+  }
+
+  if (method == "chain_get_state_root_hash") {
+    result["state_root_hash"] = Hex(GetHeight(params), 32);
+    return result;
+  }
+
+  if (method == "info_get_deploy") {
+    nlohmann::json deploy = nlohmann::json::parse(TRANSFER_DEPLOY);
+    std::string deploy_hash = GetString(params, "deploy_hash", "");
+    if (deploy_hash.size() == 64) deploy["hash"] = deploy_hash;
+    deploy_hash = deploy["hash"];
+
+    nlohmann::json transforms = nlohmann::json::array();
+    for (size_t i = 0; i < result_size; i++) {
+      if (i % 2 == 0) {
+        transforms.push_back(
+            {{"key", "hash-" + Hex(200 + i, 32)}, {"transform", "Identity"}});
+      } else {
+        transforms.push_back({{"key", "balance-" + Hex(200 + i, 32)},
+                              {"transform", {{"AddUInt512", "100000000"}}}});
+      }
+    }
+    std::string transfer = "transfer-" + Hex(5, 32);
+    transforms.push_back(
+        {{"key", transfer},
+         {"transform", {{"WriteTransfer", MakeTransfer(6, deploy_hash)}}}});
+
+    result["deploy"] = deploy;
+    result["execution_results"] = {
+        {{"block_hash", Hex(1000, 32)},
+         {"result",
+          {{"Success",
+            {{"effect",
+              {{"operations", nlohmann::json::array()},
+               {"transforms", transforms}}},
+             {"transfers", {transfer}},
+             {"cost", "100000000"}}}}}}};
+    return result;
+  }
+
+  if (method == "chain_get_block_transfers") {
+    uint64_t height = GetHeight(params);
+    nlohmann::json transfers = nlohmann::json::array();
+    for (size_t i = 0; i < result_size; i++) {
+      transfers.push_back(MakeTransfer(height * 1000 + i, Hex(300 + i, 32)));
+    }
+    result["block_hash"] = Hex(height, 32);
+    result["transfers"] = transfers;
+    return result;
+  }
+
+  if (method == "chain_get_block") {
+    uint64_t height = GetHeight(params);
+    nlohmann::json deploy_hashes = nlohmann::json::array();
+    nlohmann::json proofs = nlohmann::json::array();
+    for (size_t i = 0; i < result_size; i++) {
+      deploy_hashes.push_back(Hex(height * 1000 + i, 32));
+      proofs.push_back({{"public_key", PublicKeyHex(400 + i)},
+                        {"signature", "01" + Hex(height * 1000 + i, 64)}});
+    }
+    result["block"] = {
+        {"hash", Hex(height, 32)},
+        {"header",
+         {{"parent_hash", Hex(height - 1, 32)},
+          {"state_root_hash", Hex(height + 7, 32)},
+          {"body_hash", Hex(height + 11, 32)},
+          {"random_bit", height % 2 == 0},
+          {"accumulated_seed", Hex(height + 13, 32)},
+          {"era_end", nullptr},
+          {"timestamp", "2022-04-23T09:38:48.704Z"},
+          {"era_id", height / 100},
+          {"height", height},
+          {"protocol_version", API_VERSION}}},
+        {"body",
+         {{"proposer", PublicKeyHex(400)},
+          {"deploy_hashes", deploy_hashes},
+          {"transfer_hashes", nlohmann::json::array()}}},
+        {"proofs", proofs}};
+    return result;
+  }
+
+  if (method == "chain_get_era_info_by_switch_block") {
+    uint64_t height = GetHeight(params);
+    nlohmann::json allocations = nlohmann::json::array();
+    for (size_t i = 0; i < result_size; i++) {
+      std::string validator = PublicKeyHex(400 + i);
+      if (i % 2 == 0) {
+        allocations.push_back({{"Validator",
+                                {{"validator_public_key", validator},
+                                 {"amount", "1000000000"}}}});
+      } else {
+        allocations.push_back(
+            {{"Delegator",
+              {{"delegator_public_key", PublicKeyHex(500 + i)},
+               {"validator_public_key", validator},
+               {"amount", "1000000"}}}});
+      }
+    }
+    result["era_summary"] = {
+        {"block_hash", Hex(height, 32)},
+        {"era_id", height / 100},
+        {"stored_value",
+         {{"EraInfo", {{"seigniorage_allocations", allocations}}}}},
+        {"state_root_hash", Hex(height + 7, 32)},
+        {"merkle_proof", Hex(height, 32 * result_size)}};
+    return result;
+  }
+
+  if (method == "state_get_item") {
+    result["stored_value"] = {{"CLValue",
+                               {{"cl_type", "U512"},
+                                {"bytes", "0400ca9a3b"},
+                                {"parsed", "1000000000"}}}};
+    result["merkle_proof"] = Hex(7, 32 * result_size);
+    return result;
+  }
+
+  if (method == "state_get_dictionary_item") {
+    result["dictionary_key"] = "dictionary-" + Hex(8, 32);
+    result["stored_value"] = {{"CLValue",
+                               {{"cl_type", "String"},
+                                {"bytes", "0500000076616c7565"},
+                                {"parsed", "value"}}}};
+    result["merkle_proof"] = Hex(8, 32 * result_size);
+    return result;
+  }
+
+  if (method == "state_get_balance") {
+    result["balance_value"] = "2500000000000";
+    result["merkle_proof"] = Hex(9, 32 * result_size);
+    return result;
+  }
+
+  if (method == "state_get_auction_info") {
+    uint64_t height = GetHeight(params);
+    nlohmann::json weights = nlohmann::json::array();
+    nlohmann::json bids = nlohmann::json::array();
+    for (size_t i = 0; i < result_size; i++) {
+      weights.push_back(
+          {{"public_key", PublicKeyHex(400 + i)}, {"weight", "1000000000000"}});
+      bids.push_back(
+          {{"public_key", PublicKeyHex(400 + i)},
+           {"bid",
+            {{"bonding_purse", "uref-" + Hex(600 + i, 32) + "-007"},
+             {"staked_amount", "1000000000000"},
+             {"delegation_rate", 10},
+             {"vesting_schedule", nullptr},
+             {"delegators", nlohmann::json::array()},
+             {"inactive", false}}}});
+    }
+    result["auction_state"] = {
+        {"state_root_hash", Hex(height + 7, 32)},
+        {"block_height", height},
+        {"era_validators",
+         {{{"era_id", height / 100}, {"validator_weights", weights}}}},
+        {"bids", bids}};
+    return result;
+  }
+
+  if (method == "account_put_deploy") {
+    auto deploy = params.find("deploy");
+    result["deploy_hash"] = deploy != params.end() && deploy->is_object()
+                                ? GetString(*deploy, "hash", Hex(10, 32))
+                                : Hex(10, 32);
+    return result;
+  }
+
+  return nullptr;
+}
+
+}  // namespace Casper
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "JsonRpc/Connection/httplib.h"
+#include "nlohmann/json.hpp"
+
+namespace Casper {
+/// <summary>
+/// Behaviour of a MockNode.
+/// </summary>
+struct MockNodeOptions {
+  /// Time to answer a request, plus a uniform random part up to the jitter.
+  std::chrono::microseconds latency{0};
+  std::chrono::microseconds latency_jitter{0};
+
+  /// Fraction of the requests answered with the JSON-RPC error below.
+  double error_rate = 0;
+  int error_code = -32603;
+  std::string error_message = "mock node error";
+
+  /// Fraction of the requests answered with an HTTP 503 error.
+  double http_error_rate = 0;
+
+  /// Number of items of the list results, like the deploy hashes and proofs
+  /// of a block or the transfers of a block, to set the response sizes.
+  size_t result_size = 10;
+
+  /// Seed of the random latencies and errors, for reproducible runs.
+  uint64_t seed = 1;
+
+  /// Number of threads answering the requests.
+  size_t threads = 32;
+};
+
+/// <summary>
+/// Local stand-in for a Casper node, answering every JSON-RPC method of the
+/// Client with a recorded result or a synthetic one, to load test the client
+/// offline. The latency, the errors and the response sizes are set by the
+/// options. Batches are answered call by call.
+/// </summary>
+class MockNode {
+ public:
+  explicit MockNode(MockNodeOptions options = MockNodeOptions());
+
+  /// <summary>
+  /// Stops the node.
+  /// </summary>
+  ~MockNode();
+
+  MockNode(const MockNode&) = delete;
+  MockNode& operator=(const MockNode&) = delete;
+
+  /// <summary>
+  /// Starts answering "/rpc" on the given address, in the background. Port 0
+  /// picks a free port. Returns the port.
+  /// </summary>
+  int Start(const std::string& host = "127.0.0.1", int port = 0);
+
+  /// <summary>
+  /// Stops answering and waits for the requests in progress.
+  /// </summary>
+  void Stop();
+
+  /// <summary>
+  /// Returns the URL of the node like 'http://127.0.0.1:7777'.
+  /// </summary>
+  std::string GetAddress() const;
+
+  /// <summary>
+  /// Answers the method with the given result instead of a synthetic one.
+  /// </summary>
+  void SetResult(const std::string& method, nlohmann::json result);
+
+  /// <summary>
+  /// Loads the recorded results of the directory, one '<method>.json' file
+  /// per method holding the result of the call. Returns the number of
+  /// results loaded.
+  /// </summary>
+  size_t LoadResults(const std::string& directory);
+
+  void SetOptions(const MockNodeOptions& options);
+
+  MockNodeOptions GetOptions() const;
+
+  /// <summary>
+  /// Returns the JSON-RPC response to a request or a batch, without the
+  /// latency and the errors of the options.
+  /// </summary>
+  std::string HandleRequest(const std::string& request);
+
+  /// <summary>
+  /// Returns the number of calls of a method, or of every method.
+  /// </summary>
+  uint64_t GetCallCount(const std::string& method = "") const;
+
+  /// <summary>
+  /// Returns the synthetic result of a call.
+  /// </summary>
+  static nlohmann::json MakeResult(const std::string& method,
+                                   const nlohmann::json& params,
+                                   size_t result_size);
+
+  /// Names of the methods of the Client.
+  static const std::vector<std::string> METHODS;
+
+ private:
+  nlohmann::json HandleCall(const nlohmann::json& call);
+
+  void OnRequest(const httplib::Request& request,
+                 httplib::Response& response);
+
+  mutable std::mutex mMutex;
+  MockNodeOptions mOptions;
+  std::mt19937_64 mRandom;
+  std::map<std::string, nlohmann::json> mResults;
+  std::map<std::string, uint64_t> mCallCounts;
+
+  httplib::Server mServer;
+  std::thread mThread;
+  std::string mHost;
+  int mPort = 0;
+};
+
+}  // namespace Casper
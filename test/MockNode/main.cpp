@@ -0,0 +1,94 @@
+#include <signal.h>
+
+#include <iostream>
+#include <string>
+
+#include "MockNode.h"
+
+/// Runs a MockNode until interrupted:
+///
+///   casper-mock-node [--host <host>] [--port <port>] [--data <directory>]
+///                    [--latency-us <us>] [--jitter-us <us>]
+///                    [--error-rate <fraction>] [--http-error-rate <fraction>]
+///                    [--result-size <count>] [--threads <count>]
+///                    [--seed <seed>]
+///
+/// The data directory holds recorded results, one '<method>.json' file per
+/// method, like test/data/Rpc. The other methods get synthetic results.
+
+namespace {
+
+bool ParseOptions(int argc, char** argv, Casper::MockNodeOptions& options,
+                  std::string& host, int& port, std::string& data) {
+  for (int i = 1; i + 1 < argc; i += 2) {
+    std::string arg = argv[i];
+    std::string value = argv[i + 1];
+    if (arg == "--host") {
+      host = value;
+    } else if (arg == "--port") {
+      port = std::stoi(value);
+    } else if (arg == "--data") {
+      data = value;
+    } else if (arg == "--latency-us") {
+      options.latency = std::chrono::microseconds(std::stoll(value));
+    } else if (arg == "--jitter-us") {
+      options.latency_jitter = std::chrono::microseconds(std::stoll(value));
+    } else if (arg == "--error-rate") {
+      options.error_rate = std::stod(value);
+    } else if (arg == "--http-error-rate") {
+      options.http_error_rate = std::stod(value);
+    } else if (arg == "--result-size") {
+      options.result_size = std::stoul(value);
+    } else if (arg == "--threads") {
+      options.threads = std::stoul(value);
+    } else if (arg == "--seed") {
+      options.seed = std::stoull(value);
+    } else {
+      return false;
+    }
+  }
+  return argc % 2 == 1;
+}
+
+}  // namespace
+
+int main(int argc, char** argv) {
+  Casper::MockNodeOptions options;
+  std::string host = "127.0.0.1";
+  int port = 7777;
+  std::string data;
+  if (!ParseOptions(argc, argv, options, host, port, data)) {
+    std::cerr << "usage: " << argv[0]
+              << " [--host <host>] [--port <port>] [--data <directory>]"
+                 " [--latency-us <us>] [--jitter-us <us>]"
+                 " [--error-rate <fraction>] [--http-error-rate <fraction>]"
+                 " [--result-size <count>] [--threads <count>]"
+                 " [--seed <seed>]"
+              << std::endl;
+    return 2;
+  }
+
+  // the server threads inherit the blocked signals, the main thread waits
+  // for them
+  sigset_t signals;
+  sigemptyset(&signals);
+  sigaddset(&signals, SIGINT);
+  sigaddset(&signals, SIGTERM);
+  pthread_sigmask(SIG_BLOCK, &signals, nullptr);
+
+  Casper::MockNode node(options);
+  if (!data.empty()) {
+    std::cerr << "loaded " << node.LoadResults(data) << " recorded results"
+              << std::endl;
+  }
+  node.Start(host, port);
+  std::cerr << "mock node listening on " << node.GetAddress() << "/rpc"
+            << std::endl;
+
+  int signal = 0;
+  sigwait(&signals, &signal);
+
+  node.Stop();
+  std::cerr << "answered " << node.GetCallCount() << " calls" << std::endl;
+  return 0;
+}
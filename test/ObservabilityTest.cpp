@@ -0,0 +1,191 @@
+#define TEST_NO_MAIN 1
+#include "ObservabilityTest.hpp"
+#include "acutest.h"
+
+namespace Casper {
+
+void client_metricsTest() {
+  // 1 microsecond buckets up to 16, then 16 sub-buckets per power of two
+  TEST_ASSERT(LatencyHistogram::GetBucketIndex(0) == 0);
+  TEST_ASSERT(LatencyHistogram::GetBucketIndex(15) == 15);
+  TEST_ASSERT(LatencyHistogram::GetBucketUpperBound(15) == 15);
+  size_t index = LatencyHistogram::GetBucketIndex(1000);
+  TEST_ASSERT(LatencyHistogram::GetBucketUpperBound(index) >= 1000);
+  TEST_ASSERT(LatencyHistogram::GetBucketUpperBound(index) < 1070);
+
+  LatencyHistogram histogram;
+  for (uint64_t i = 1; i <= 100; i++) histogram.Record(i * 100);
+  HistogramSnapshot latencies = histogram.GetSnapshot();
+  TEST_ASSERT(latencies.count == 100);
+  TEST_ASSERT(latencies.min == 100 && latencies.max == 10000);
+  TEST_ASSERT(latencies.GetPercentile(0.5) >= 5000);
+  TEST_ASSERT(latencies.GetPercentile(0.5) < 5400);
+
+  bool fail = false;
+  Client client(std::vector<std::string>{"loopback"}, [&](const std::string&) {
+    return std::make_unique<LoopbackConnector>([&](const std::string& request) {
+      nlohmann::json json = nlohmann::json::parse(request);
+      if (fail) {
+        return nlohmann::json{{"jsonrpc", "2.0"},
+                              {"id", json["id"]},
+                              {"error", {{"code", -32001}, {"message", "x"}}}}
+            .dump();
+      }
+      return nlohmann::json{{"jsonrpc", "2.0"},
+                            {"id", json["id"]},
+                            {"result", nodeResult(json, 100)}}
+          .dump();
+    });
+  });
+
+  client.GetStateRootHash(uint64_t(1));
+  client.GetStateRootHash("");
+  fail = true;
+  TEST_EXCEPTION(client.GetStateRootHash(uint64_t(1)),
+                 jsonrpccxx::JsonRpcException);
+
+  auto metrics = client.GetMetrics();
+  TEST_ASSERT(metrics.size() == 1);
+  const MethodMetricsSnapshot& method = metrics["chain_get_state_root_hash"];
+  TEST_ASSERT(method.call_count == 3);
+  TEST_ASSERT(method.error_count == 1);
+  TEST_ASSERT(method.error_codes.at(-32001) == 1);
+  TEST_ASSERT(method.request_bytes > 0 && method.response_bytes > 0);
+  TEST_ASSERT(method.total.count == 3);
+  TEST_ASSERT(method.from_json.count == 3);
+
+  std::string text = client.ExportMetrics();
+  const std::string calls =
+      R"(casper_rpc_calls_total{method="chain_get_state_root_hash"} 3)";
+  TEST_ASSERT(text.find(calls) != std::string::npos);
+  TEST_ASSERT(text.find(R"(code="-32001"} 1)") != std::string::npos);
+
+  // the exported bounds are the ends of the latency buckets, 250
+  // microseconds falls in the bucket from 248 to 255
+  LatencyHistogram straddling;
+  straddling.Record(uint64_t(249));
+  straddling.Record(uint64_t(255));
+  MethodMetricsSnapshot snapshot;
+  snapshot.total = straddling.GetSnapshot();
+  text = MetricsRegistry::ToPrometheusText({{"m", snapshot}});
+  TEST_ASSERT(text.find(R"(phase="total",le="0.0001"} 0)") !=
+              std::string::npos);
+  TEST_ASSERT(text.find(R"(phase="total",le="0.000256"} 2)") !=
+              std::string::npos);
+  TEST_ASSERT(text.find(R"(phase="total",le="1.015808"} 2)") !=
+              std::string::npos);
+}
+
+/// Records the spans as "+name" and "-name", failed spans as "!name".
+class RecordingTracer : public Tracer {
+ public:
+  uint64_t BeginSpan(SpanKind kind, const char* name) override {
+    std::lock_guard<std::mutex> lock(mutex);
+    spans.push_back(std::string("+") + name);
+    return spans.size();
+  }
+
+  void EndSpan(SpanKind kind, const char* name, uint64_t span,
+               bool failed) override {
+    std::lock_guard<std::mutex> lock(mutex);
+    TEST_ASSERT(spans[span - 1] == std::string("+") + name);
+    spans.push_back(std::string(failed ? "!" : "-") + name);
+  }
+
+  std::mutex mutex;
+  std::vector<std::string> spans;
+};
+
+void tracing_spansTest() {
+  bool fail = false;
+  Client client(std::vector<std::string>{"loopback"}, [&](const std::string&) {
+    return std::make_unique<LoopbackConnector>([&](const std::string& request) {
+      nlohmann::json json = nlohmann::json::parse(request);
+      if (fail) return std::string("not json");
+      return nlohmann::json{{"jsonrpc", "2.0"},
+                            {"id", json["id"]},
+                            {"result", nodeResult(json, 100)}}
+          .dump();
+    });
+  });
+
+  RecordingTracer tracer;
+  Tracing::SetTracer(&tracer);
+
+  client.GetStateRootHash(uint64_t(1));
+  fail = true;
+  TEST_EXCEPTION(client.GetStateRootHash(uint64_t(1)),
+                 jsonrpccxx::JsonRpcException);
+
+  DeployHeader header(
+      PublicKey::FromHexString("0202a6e2d25621758e2c92900f842ff367bbb5e4b6a8"
+                               "49cacb43c3eaebf371b24b85"),
+      "2021-12-13T12:00:00.000Z", "30m", 1, "", {}, "casper-test");
+  ModuleBytes payment(u512FromDec("1000000000"));
+  TransferDeployItem session(
+      u512FromDec("2845678925"),
+      AccountHashKey(
+          PublicKey::FromHexString("018afa98ca4be12d613617f7339a2d57695"
+                                   "0a2f9a92102ca4d6508ee31b54d2c02")),
+      123456789012345u, true);
+  Deploy deploy(header, payment, session);
+  KeyPair key_pair;
+  key_pair.public_key = deploy.header.account;
+  deploy.Sign(key_pair);
+  DeployByteSerializer().ToBytes(deploy);
+
+  Tracing::SetTracer(nullptr);
+  fail = false;
+  client.GetStateRootHash(uint64_t(1));
+
+  std::vector<std::string> expected{
+      "+chain_get_state_root_hash",
+      "+chain_get_state_root_hash",
+      "-chain_get_state_root_hash",
+      "-chain_get_state_root_hash",
+      "+chain_get_state_root_hash",
+      "+chain_get_state_root_hash",
+      "!chain_get_state_root_hash",
+      "!chain_get_state_root_hash",
+      "+Deploy::ComputeBodyHash",
+      "-Deploy::ComputeBodyHash",
+      "+Deploy::ComputeHeaderHash",
+      "+DeployByteSerializer::ToBytes(DeployHeader)",
+      "-DeployByteSerializer::ToBytes(DeployHeader)",
+      "-Deploy::ComputeHeaderHash",
+      "+Deploy::Sign",
+      "-Deploy::Sign",
+      "+DeployByteSerializer::ToBytes(Deploy)",
+      "+DeployByteSerializer::ToBytes(DeployHeader)",
+      "-DeployByteSerializer::ToBytes(DeployHeader)",
+      "-DeployByteSerializer::ToBytes(Deploy)"};
+  TEST_ASSERT(tracer.spans == expected);
+}
+
+void logging_sinkTest() {
+  std::ostringstream stream;
+  StreamLogSink sink(stream);
+  Logging::SetSink(&sink);
+  Logging::SetLevel(LogLevel::Trace);
+
+  TEST_ASSERT(strToTimestamp("2021-12-13T12:00:00.000Z") == 1639396800000);
+  TEST_ASSERT(stream.str().find("[trace] strToTimestamp") !=
+              std::string::npos);
+
+  // below the level nothing is formatted
+  Logging::SetLevel(LogLevel::Warning);
+  stream.str("");
+  strToTimestamp("2021-12-13T12:00:00.000Z");
+  TEST_ASSERT(stream.str().empty());
+  Signature::FromHexString("05abcd");
+  TEST_ASSERT(stream.str().find("[warning] Signature::FromHexString") == 0);
+
+  // without a sink nothing is written
+  Logging::SetSink(nullptr);
+  Logging::SetLevel(LogLevel::Info);
+  stream.str("");
+  Signature::FromHexString("05abcd");
+  TEST_ASSERT(stream.str().empty());
+}
+
+}  // namespace Casper
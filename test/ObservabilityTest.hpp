@@ -0,0 +1,15 @@
+#pragma once
+
+#include "CasperClient.h"
+#include "ByteSerializers/DeployByteSerializer.h"
+#include "TestServer.hpp"
+
+namespace Casper {
+
+void client_metricsTest(void);
+
+void tracing_spansTest(void);
+
+void logging_sinkTest(void);
+
+}  // namespace Casper
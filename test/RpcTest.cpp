@@ -311,16 +311,17 @@ void chainGetEraInfoBySwitchBlock_with_blockHashTest(void) {
   TEST_ASSERT(result.era_summary.value().block_hash != "");
   TEST_ASSERT(result.era_summary.value().merkle_proof != "");
   TEST_ASSERT(result.era_summary.value().state_root_hash != "");
-  TEST_ASSERT(result.era_summary.value().stored_value.era_info.has_value());
+  TEST_ASSERT(result.era_summary.value().stored_value.GetType() ==
+              StoredValueType::EraInfo);
   TEST_ASSERT(result.era_summary.value()
-                  .stored_value.era_info.value()
+                  .stored_value.Get<StoredValueType::EraInfo>()
                   .seigniorage_allocations.size() > 0);
 
   int validator_cnt = 0;
   int delegator_cnt = 0;
 
   for (int i = 0; i < result.era_summary.value()
-                          .stored_value.era_info.value()
+                          .stored_value.Get<StoredValueType::EraInfo>()
                           .seigniorage_allocations.size();
        i++) {
     if (delegator_cnt == 1 && validator_cnt == 1) {
@@ -328,28 +329,28 @@ void chainGetEraInfoBySwitchBlock_with_blockHashTest(void) {
     }
 
     bool is_delegator = result.era_summary.value()
-                            .stored_value.era_info.value()
+                            .stored_value.Get<StoredValueType::EraInfo>()
                             .seigniorage_allocations[i]
                             .is_delegator;
 
     if (is_delegator == true && delegator_cnt == 0) {
       delegator_cnt++;
       TEST_ASSERT(result.era_summary.value()
-                      .stored_value.era_info.value()
+                      .stored_value.Get<StoredValueType::EraInfo>()
                       .seigniorage_allocations[i]
                       .delegator_public_key.ToString() != "");
       TEST_ASSERT(result.era_summary.value()
-                      .stored_value.era_info.value()
+                      .stored_value.Get<StoredValueType::EraInfo>()
                       .seigniorage_allocations[i]
                       .amount >= 0);
     } else if (is_delegator == false && validator_cnt == 0) {
       validator_cnt++;
       TEST_ASSERT(result.era_summary.value()
-                      .stored_value.era_info.value()
+                      .stored_value.Get<StoredValueType::EraInfo>()
                       .seigniorage_allocations[i]
                       .validator_public_key.ToString() != "");
       TEST_ASSERT(result.era_summary.value()
-                      .stored_value.era_info.value()
+                      .stored_value.Get<StoredValueType::EraInfo>()
                       .seigniorage_allocations[i]
                       .amount >= 0);
     }
@@ -374,9 +375,10 @@ void stateGetItem_with_keyTest(void) {
   TEST_ASSERT(result.api_version != "");
   TEST_ASSERT(result.merkle_proof != "");
 
-  TEST_ASSERT(result.stored_value.transfer.has_value());
+  TEST_ASSERT(result.stored_value.GetType() == StoredValueType::Transfer);
 
-  auto& current_transfer = result.stored_value.transfer.value();
+  auto& current_transfer =
+      result.stored_value.Get<StoredValueType::Transfer>();
 
   TEST_ASSERT(iequals(
       current_transfer.deploy_hash,
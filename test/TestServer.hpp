@@ -0,0 +1,92 @@
+#pragma once
+
+#include <functional>
+#include <stdexcept>
+#include <string>
+#include <thread>
+
+#include "JsonRpc/Connection/httplib.h"
+#include "nlohmann/json.hpp"
+
+namespace Casper {
+
+/// <summary>
+/// Local httplib server of the network tests, on a free port. The port is
+/// bound and listening when Start() returns, so the requests can be sent
+/// right away. Stopped on destruction.
+/// </summary>
+class TestServer {
+ public:
+  httplib::Server server;
+
+  ~TestServer() { Stop(); }
+
+  /// <summary>
+  /// Binds a free local port and answers the requests in the background.
+  /// </summary>
+  void Start() {
+    mPort = server.bind_to_any_port("127.0.0.1");
+    if (mPort < 0) throw std::runtime_error("TestServer: cannot bind a port");
+    mThread = std::thread([this] { server.listen_after_bind(); });
+  }
+
+  /// <summary>
+  /// Answers "/rpc" with the JSON-RPC result of the handler, or with an HTTP
+  /// error when the result is null, and starts the server.
+  /// </summary>
+  void StartRpc(
+      std::function<nlohmann::json(const nlohmann::json& request)> handler) {
+    server.Post("/rpc", [handler](const httplib::Request& req,
+                                  httplib::Response& res) {
+      nlohmann::json request = nlohmann::json::parse(req.body);
+      nlohmann::json result = handler(request);
+      if (result.is_null()) {
+        res.status = 500;
+        return;
+      }
+
+      nlohmann::json response{
+          {"jsonrpc", "2.0"}, {"id", request["id"]}, {"result", result}};
+      res.set_content(response.dump(), "application/json");
+    });
+    Start();
+  }
+
+  /// <summary>
+  /// Stops the server and waits for the requests in progress.
+  /// </summary>
+  void Stop() {
+    if (!mThread.joinable()) return;
+    // the connections already wait in the backlog, only the accept loop may
+    // not have started yet
+    while (!server.is_running()) std::this_thread::yield();
+    server.stop();
+    mThread.join();
+  }
+
+  /// <summary>
+  /// Returns the URL of the server like 'http://127.0.0.1:7777'.
+  /// </summary>
+  std::string GetAddress() const {
+    return "http://127.0.0.1:" + std::to_string(mPort);
+  }
+
+ private:
+  std::thread mThread;
+  int mPort = -1;
+};
+
+/// <summary>
+/// Answers "info_get_status" with the given tip height and every other call
+/// with a state root hash.
+/// </summary>
+inline nlohmann::json nodeResult(const nlohmann::json& request,
+                                 uint64_t height) {
+  if (request["method"] == "info_get_status") {
+    return {{"api_version", "1.4.5"},
+            {"last_added_block_info", {{"height", height}}}};
+  }
+  return {{"api_version", "1.4.5"}, {"state_root_hash", "abcd"}};
+}
+
+}  // namespace Casper
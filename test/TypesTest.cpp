@@ -0,0 +1,199 @@
+#define TEST_NO_MAIN 1
+#include "TypesTest.hpp"
+#include "acutest.h"
+
+namespace Casper {
+
+void storedValueAndTransform_jsonTest() {
+  nlohmann::json entries = nlohmann::json::parse(R"([
+    {"key": "hash-01", "transform": "Identity"},
+    {"key": "balance-02", "transform": {"AddUInt512": "100000000"}},
+    {"key": "uref-03", "transform": {"WriteContract": "contract-04"}},
+    {"key": "uref-05", "transform": {"Failure": "out of gas"}}])");
+  std::vector<TransformEntry> transforms =
+      entries.get<std::vector<TransformEntry>>();
+
+  TEST_ASSERT(transforms[0].transform.GetType() == TransformType::Identity);
+  TEST_ASSERT(transforms[1].transform.Get<TransformType::AddUInt512>() ==
+              u512FromDec("100000000"));
+  // the string alternatives are told apart by their type
+  TEST_ASSERT(transforms[2].transform.GetType() ==
+              TransformType::WriteContract);
+  TEST_ASSERT(transforms[2].transform.GetIf<TransformType::WriteAccount>() ==
+              nullptr);
+  TEST_ASSERT(*transforms[3].transform.GetIf<TransformType::Failure>() ==
+              "out of gas");
+  TEST_ASSERT(nlohmann::json(transforms) == entries);
+
+  Transform add = Transform::Make<TransformType::AddUInt64>(uint64_t(7));
+  TEST_ASSERT(nlohmann::json(add) == nlohmann::json({{"AddUInt64", 7}}));
+  TEST_EXCEPTION(nlohmann::json({{"Rewrite", 1}}).get<Transform>(),
+                 std::runtime_error);
+
+  StoredValue stored_value =
+      nlohmann::json::parse(R"({"ContractWasm": "0061736d"})")
+          .get<StoredValue>();
+  TEST_ASSERT(stored_value.GetType() == StoredValueType::ContractWasm);
+  TEST_ASSERT(stored_value.Get<StoredValueType::ContractWasm>() == "0061736d");
+  TEST_ASSERT(stored_value.GetIf<StoredValueType::CLValue>() == nullptr);
+  TEST_ASSERT(nlohmann::json(stored_value) ==
+              nlohmann::json({{"ContractWasm", "0061736d"}}));
+  TEST_EXCEPTION(nlohmann::json({{"Unknown", 1}}).get<StoredValue>(),
+                 std::runtime_error);
+}
+
+void timestampAndDuration_parseTest() {
+  Timestamp timestamp = Timestamp::Parse("2021-12-13T12:00:00.000Z");
+  TEST_ASSERT(timestamp.milliseconds == 1639396800000);
+  TEST_ASSERT(timestamp.ToString() == "2021-12-13T12:00:00.000Z");
+  TEST_ASSERT(Timestamp::Parse("2024-02-29T23:59:59.1234Z").ToString() ==
+              "2024-02-29T23:59:59.123Z");
+  TEST_ASSERT(Timestamp::Parse("1970-01-01T00:00:00Z").milliseconds == 0);
+  TEST_EXCEPTION(Timestamp::Parse("2023-02-29T00:00:00.000Z"),
+                 std::invalid_argument);
+  TEST_EXCEPTION(Timestamp::Parse("2021-12-13 12:00"), std::invalid_argument);
+
+  TEST_ASSERT(Duration::Parse("30m").milliseconds == 1800000);
+  TEST_ASSERT(Duration::Parse("1h 30m").milliseconds == 5400000);
+  TEST_ASSERT(Duration::Parse("2days 1h").ToString() == "2days 1h");
+  TEST_ASSERT(Duration::Parse("1day 5ms").ToString() == "1day 5ms");
+  TEST_ASSERT(Duration::Parse("90s").ToString() == "1m 30s");
+  TEST_ASSERT(Duration::Parse("1500us").milliseconds == 1);
+  TEST_ASSERT(Duration().ToString() == "0s");
+
+  // a month and a year are not whole days and keep their time of the day
+  TEST_ASSERT(Duration::Parse("31days").ToString() == "1month 13h 26m 24s");
+  for (const char* text : {"31days", "1month", "1year 2months 3days 4h 5ms",
+                           "400days 1s", "12months"}) {
+    Duration duration = Duration::Parse(text);
+    TEST_ASSERT(Duration::Parse(duration.ToString()) == duration);
+  }
+  TEST_EXCEPTION(Duration::Parse("30 parsecs"), std::invalid_argument);
+  TEST_EXCEPTION(Duration::Parse(""), std::invalid_argument);
+
+  // the TTL of the header is serialized, not a fixed 30 minutes
+  PublicKey account = PublicKey::FromHexString(
+      "0202a6e2d25621758e2c92900f842ff367bbb5e4b6a849cacb43c3eaebf371b24b85");
+  DeployHeader header(account, "2021-12-13T12:00:00.000Z", "1h", 1,
+                      std::string(64, '0'), {}, "casper-test");
+  std::string bytes = hexEncode(DeployByteSerializer().ToBytes(header));
+  TEST_ASSERT(bytes.substr(68, 32) == "00f6a9b37d01000080ee360000000000");
+
+  nlohmann::json json = header;
+  TEST_ASSERT(json["timestamp"] == "2021-12-13T12:00:00.000Z");
+  TEST_ASSERT(json["ttl"] == "1h");
+  TEST_ASSERT(json.get<DeployHeader>().ttl.milliseconds == 3600000);
+}
+
+void wideInteger_conversionsTest() {
+  TEST_ASSERT(u512ToDec(uint512_t(0)) == "0");
+  TEST_ASSERT(u512ToHex(uint512_t(0)) == "00");
+  TEST_ASSERT(u512FromHex("00") == 0);
+  TEST_ASSERT(u128ToDec(~uint128_t(0)) ==
+              "340282366920938463463374607431768211455");
+  TEST_ASSERT(u128FromDec("340282366920938463463374607431768211455") ==
+              ~uint128_t(0));
+  TEST_EXCEPTION(u128FromDec("340282366920938463463374607431768211456"),
+                 std::out_of_range);
+  TEST_EXCEPTION(u512FromDec("12a"), std::invalid_argument);
+  TEST_EXCEPTION(u512FromDec(""), std::invalid_argument);
+  TEST_ASSERT(u512ToHex(u512FromDec("10000000000000000000")) ==
+              "080000e8890423c78a");
+  TEST_ASSERT(u256FromHex("03010001") == 65537);
+
+  // random values of every size, checked against the stream output of the
+  // wide integers
+  std::mt19937_64 random(7);
+  for (int i = 0; i < 200; i++) {
+    uint512_t value = 0;
+    for (int k = random() % 9; k > 0; k--) value = (value << 64) | random();
+    std::stringstream stream;
+    stream << value;
+    TEST_ASSERT(u512ToDec(value) == stream.str());
+    TEST_ASSERT(u512FromDec(stream.str()) == value);
+    TEST_ASSERT(u512FromHex(u512ToHex(value)) == value);
+    CBytes bytes = wideToBytes(value);
+    TEST_ASSERT(wideFromBytes<uint512_t>(bytes.data(), bytes.size()) ==
+                value);
+  }
+}
+
+void globalStateKey_parseTest() {
+  // the contract prefixes are hash keys
+  GlobalStateKey contract_key = GlobalStateKey::FromString(
+      "contract-wasm-"
+      "96053169b397360449b4de964200be449594ca93f252153f0a679b804e214a54");
+  TEST_ASSERT(contract_key.key_identifier == KeyIdentifier::Hash);
+  TEST_ASSERT(iequals(
+      contract_key.ToString(),
+      "hash-96053169b397360449b4de964200be449594ca93f252153f0a679b804e214a54"));
+
+  // a URef keeps its access rights as a GlobalStateKey
+  GlobalStateKey uref_key = GlobalStateKey::FromString(
+      "uref-e48935c79e96c490c01e1e8800de5ec5f4a857a57db0dcffed1e1e2b5d29b5e4-"
+      "007");
+  TEST_ASSERT(uref_key.key_identifier == KeyIdentifier::URef);
+  TEST_ASSERT(uref_key.access_rights == AccessRights::READ_ADD_WRITE);
+
+  GlobalStateKeyByteSerializer serializer;
+  CBytes uref_bytes = serializer.ToBytes(uref_key);
+  TEST_ASSERT(uref_bytes.size() == 34 && uref_bytes[33] == 7);
+  TEST_ASSERT(GlobalStateKey::FromBytes(uref_bytes) == uref_key);
+  TEST_ASSERT(GlobalStateKey::FromBytes(uref_bytes).access_rights ==
+              AccessRights::READ_ADD_WRITE);
+
+  GlobalStateKey era_key = GlobalStateKey::FromString("era-2685");
+  TEST_ASSERT(era_key.key_identifier == KeyIdentifier::EraInfo);
+  TEST_ASSERT(GlobalStateKey::FromBytes(era_key.GetBytes()).ToString() ==
+              "era-2685");
+
+  // the text of a key is checksummed whatever the case of its input
+  AccountHashKey acc_key(
+      "account-hash-"
+      "1B2D1D9069D21F916AB58BE305C816B8F5258177D9CF29EEE33728C4E934F094");
+  TEST_ASSERT(GlobalStateKey::FromString(acc_key.ToString()) == acc_key);
+  TEST_ASSERT(GlobalStateKey::FromBytes(acc_key.GetBytes()) == acc_key);
+
+  for (const char* invalid :
+       {"", "hash-", "hash-1234", "era-", "era-12x", "key-00",
+        "uref-e48935c79e96c490c01e1e8800de5ec5f4a857a57db0dcffed1e1e2b5d29b5e4",
+        "uref-e48935c79e96c490c01e1e8800de5ec5f4a857a57db0dcffed1e1e2b5d29b5e4-"
+        "009",
+        "hash-96053169b397360449b4de964200be449594ca93f252153f0a679b804e214a5g",
+        // a wrong checksum
+        "hash-"
+        "96053169B397360449b4de964200be449594ca93f252153f0a679b804e214a54"}) {
+    TEST_EXCEPTION(GlobalStateKey::FromString(invalid), std::invalid_argument);
+  }
+  TEST_EXCEPTION(HashKey(acc_key.ToString()), std::invalid_argument);
+}
+
+void dictionaryKey_fromSeedURefTest() {
+  URef seed_uref(
+      "uref-e48935c79e96c490c01e1e8800de5ec5f4a857a57db0dcffed1e1e2b5d29b5e4-"
+      "007");
+
+  DictionaryKey dictionary_key =
+      DictionaryKey::FromSeedURef(seed_uref, "abc_name");
+
+  TEST_ASSERT(dictionary_key.key_identifier == KeyIdentifier::Dictionary);
+  TEST_ASSERT(iequals(
+      dictionary_key.ToString(),
+      "dictionary-"
+      "d6f30999cbc86d9933ce08fdc25ff29dbad52d3c94f6ed38149d597a4f66468f"));
+
+  // the formatted key must round trip through the string constructor
+  TEST_ASSERT(DictionaryKey(dictionary_key.ToString()) == dictionary_key);
+
+  std::vector<DictionaryKey> dictionary_keys =
+      DictionaryKey::ListFromSeedURef(seed_uref, {"abc_name", "1"});
+
+  TEST_ASSERT(dictionary_keys.size() == 2);
+  TEST_ASSERT(dictionary_keys[0] == dictionary_key);
+  TEST_ASSERT(iequals(
+      dictionary_keys[1].ToString(),
+      "dictionary-"
+      "fc582f244d7cb6bebd047ab93d0f0d4bd8648639b4d79139ef088ba7a04f9d4f"));
+}
+
+}  // namespace Casper
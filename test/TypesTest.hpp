@@ -0,0 +1,21 @@
+#pragma once
+
+#include "CasperClient.h"
+#include "Types/CLValue.h"
+#include "Types/GlobalStateKey.h"
+#include "ByteSerializers/DeployByteSerializer.h"
+#include "ByteSerializers/GlobalStateKeyByteSerializer.h"
+
+namespace Casper {
+
+void storedValueAndTransform_jsonTest(void);
+
+void timestampAndDuration_parseTest(void);
+
+void wideInteger_conversionsTest(void);
+
+void globalStateKey_parseTest(void);
+
+void dictionaryKey_fromSeedURefTest(void);
+
+}  // namespace Casper
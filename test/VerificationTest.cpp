@@ -0,0 +1,218 @@
+#define TEST_NO_MAIN 1
+#include "VerificationTest.hpp"
+#include "acutest.h"
+
+namespace Casper {
+
+/// Proof of a 1000 motes balance under a node and an extension step.
+const std::string balance_merkle_proof =
+    "06e48935c79e96c490c01e1e8800de5ec5f4a857a57db0dcffed1e1e2b5d29b5e40003"
+    "00000002e80308020000000005010000000100aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"
+    "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa01020000000102";
+
+const std::string balance_state_root_hash =
+    "e819baa8dbd7ecac2ca2f0fd1fe4a5ba59bc11a8af910b876e03be0eb1e66170";
+
+const std::string balance_purse_uref =
+    "uref-e48935c79e96c490c01e1e8800de5ec5f4a857a57db0dcffed1e1e2b5d29b5e4-007";
+
+void merkleProof_balanceTest() {
+  TrieMerkleProof proof = TrieMerkleProof::FromHex(balance_merkle_proof);
+  TEST_ASSERT(proof.Verify(balance_state_root_hash));
+  TEST_ASSERT(proof.key_bytes.size() == 33);
+
+  GetBalanceResult result;
+  result.balance_value = 1000;
+  result.merkle_proof = balance_merkle_proof;
+
+  TEST_ASSERT(MerkleProofVerifier::VerifyBalance(
+      result, balance_state_root_hash, balance_purse_uref));
+
+  // wrong state root hash
+  TEST_ASSERT(!MerkleProofVerifier::VerifyBalance(
+      result,
+      "0000000000000000000000000000000000000000000000000000000000000000",
+      balance_purse_uref));
+
+  // wrong balance value
+  GetBalanceResult wrong_balance = result;
+  wrong_balance.balance_value = 1001;
+  TEST_ASSERT(!MerkleProofVerifier::VerifyBalance(
+      wrong_balance, balance_state_root_hash, balance_purse_uref));
+
+  // tampered and truncated proofs
+  GetBalanceResult tampered = result;
+  tampered.merkle_proof[80] = tampered.merkle_proof[80] == '0' ? '1' : '0';
+  GetBalanceResult truncated = result;
+  truncated.merkle_proof.resize(truncated.merkle_proof.size() - 2);
+
+  std::vector<bool> verified = MerkleProofVerifier::VerifyBalances(
+      {result, tampered, truncated, result}, balance_state_root_hash,
+      std::vector<std::string>(4, balance_purse_uref), 2);
+  TEST_ASSERT(verified == std::vector<bool>({true, false, false, true}));
+}
+
+void merkleProof_itemTest() {
+  GetItemResult result;
+  result.merkle_proof = "01000000" + balance_merkle_proof;
+  result.stored_value = StoredValue(
+      CLValue(hexDecode("02e803"), CLType(CLTypeEnum::U512)));
+
+  std::string balance_key =
+      "balance-e48935c79e96c490c01e1e8800de5ec5f4a857a57db0dcffed1e1e2b5d29b5e4";
+
+  TEST_ASSERT(MerkleProofVerifier::VerifyItem(result, balance_state_root_hash,
+                                              balance_key));
+
+  // proof of another key
+  TEST_ASSERT(!MerkleProofVerifier::VerifyItem(
+      result, balance_state_root_hash,
+      "balance-"
+      "96053169b397360449b4de964200be449594ca93f252153f0a679b804e214a54"));
+
+  // a second valid proof spliced in after the proof of the queried key
+  GetItemResult spliced = result;
+  spliced.merkle_proof =
+      "02000000" + balance_merkle_proof + balance_merkle_proof;
+  TEST_ASSERT(!MerkleProofVerifier::VerifyItem(spliced, balance_state_root_hash,
+                                               balance_key));
+
+  // a path through a value that has no named keys
+  TEST_ASSERT(!MerkleProofVerifier::VerifyItem(spliced, balance_state_root_hash,
+                                               balance_key, {"purse"}));
+
+  // type not matching the proof
+  result.stored_value.Get<StoredValueType::CLValue>().cl_type =
+      CLType(CLTypeEnum::U256);
+  TEST_ASSERT(!MerkleProofVerifier::VerifyItem(result, balance_state_root_hash,
+                                               balance_key));
+
+  // value not matching the proof
+  result.stored_value = StoredValue(
+      CLValue(hexDecode("02e903"), CLType(CLTypeEnum::U512)));
+  TEST_ASSERT(!MerkleProofVerifier::VerifyItem(result, balance_state_root_hash,
+                                               balance_key));
+
+  // a stored value that is not a CLValue is not verified
+  result.stored_value = StoredValue(Transfer());
+  TEST_ASSERT(!MerkleProofVerifier::VerifyItem(result, balance_state_root_hash,
+                                               balance_key));
+}
+
+void merkleProof_nestedTypeTest() {
+  // a leaf holding a CLValue whose type nests far too many Options
+  std::string proof = "02" + std::string(64, 'a') + "07" + "00" +
+                      "0300000002e803";
+  for (int i = 0; i < 100000; i++) proof += "0d";
+  proof += "08" + std::string("00000000");
+
+  GetItemResult result;
+  result.merkle_proof = "01000000" + proof;
+  result.stored_value = StoredValue(
+      CLValue(hexDecode("02e803"), CLType(CLTypeEnum::U512)));
+
+  TEST_ASSERT(!MerkleProofVerifier::VerifyItem(
+      result, balance_state_root_hash,
+      "balance-"
+      "aaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaaa"));
+}
+
+/// Two consecutive blocks signed by a single validator, the first one is a
+/// switch block with an era end.
+const std::string linked_blocks_json =
+    "[{\"hash\":\"d72b2cd471cfbc761f492090acef8740659f55bad758d6f3960be48b19e"
+    "853d8\",\"header\":{\"parent_hash\":\"d4e07b5b5551d31512d6152fdee95ff753"
+    "7ef60b939e4df0f6c63ea5e5cffbf4\",\"state_root_hash\":\"1d71e18ef91e61ddb"
+    "f4dbafd0edbd143b853ee8dde942b9c038022dee4d7512b\",\"body_hash\":\"aec891"
+    "4a764605b10fcb683538d3715ab337e289b8b8a1c28be6f5562092f4a1\",\"random_bi"
+    "t\":true,\"accumulated_seed\":\"e1dafd06961207497a0ab1756877fa2a26d967c0"
+    "1f447bfe63dbd9132ec702bb\",\"era_end\":{\"era_report\":{\"equivocators\""
+    ":[],\"rewards\":[{\"validator\":\"0103a107bff3ce10be1d70dd18e74bc09967e4"
+    "d6309ba50d5f1ddc8664125531b8\",\"amount\":1000}],\"inactive_validators\""
+    ":[]},\"next_era_validator_weights\":[{\"public_key\":\"0103a107bff3ce10b"
+    "e1d70dd18e74bc09967e4d6309ba50d5f1ddc8664125531b8\",\"weight\":\"1234567"
+    "89\"}]},\"timestamp\":\"2022-03-08T16:09:52.768Z\",\"era_id\":3,\"height"
+    "\":10,\"protocol_version\":\"1.4.5\"},\"body\":{\"proposer\":\"0103a107b"
+    "ff3ce10be1d70dd18e74bc09967e4d6309ba50d5f1ddc8664125531b8\",\"deploy_has"
+    "hes\":[\"504fafe4b85d333bab9d77ff1593161b4755c4a97585e59361bb1325e734848"
+    "d\"],\"transfer_hashes\":[\"718e7d5268733366c507f7e2264c02613243e899c95d"
+    "57730b1b4cf8820ea9b8\"]},\"proofs\":[{\"public_key\":\"0103a107bff3ce10b"
+    "e1d70dd18e74bc09967e4d6309ba50d5f1ddc8664125531b8\",\"signature\":\"01f9"
+    "a600a76edeaa6c86888b795494d0d7f0d9b21dfa649292ead6a82c778dfc83650dc711ae"
+    "c3561c890fcc0c8b433125daa7443cf716b64022501c29df198e00\"}]},{\"hash\":\""
+    "374d584f8368b7cdc13d7daab87784a32c159fcd9287f73af190adc35f80dc6b\",\"hea"
+    "der\":{\"parent_hash\":\"d72b2cd471cfbc761f492090acef8740659f55bad758d6f"
+    "3960be48b19e853d8\",\"state_root_hash\":\"29e1d6bb4565728157d6749966d096"
+    "8cf8cea24e1a8cf38f777e8f9f3a570cb9\",\"body_hash\":\"780973c8b40e46029b0"
+    "e1909346fe667fb994cf7cf5c5ae5ca35081707c12574\",\"random_bit\":true,\"ac"
+    "cumulated_seed\":\"6938d3487e74feba8f4d5d98f607a38677517fdb20d5a3934a707"
+    "5cba41058e9\",\"era_end\":null,\"timestamp\":\"2022-03-08T16:10:58.304Z\",\"era_id\":4,\"height\":11,\"protocol_version\":\"1.4.5\"},\"body\":{\"proposer\":\"0103a107bff3ce10be1d70dd18e74bc09967e4d6309ba50d5f1ddc8664"
+    "125531b8\",\"deploy_hashes\":[\"7844196cada1e6bc3be3ee6cb31669637bcdd247"
+    "625c417cef9d518d4e694ece\"],\"transfer_hashes\":[\"9e5bce4fe065f34d7c691"
+    "63e2fff5c6a06fe2e86204b02597933e5da7921179f\"]},\"proofs\":[{\"public_ke"
+    "y\":\"0103a107bff3ce10be1d70dd18e74bc09967e4d6309ba50d5f1ddc8664125531b8"
+    "\",\"signature\":\"01883fb3a1ba936b558af21eca20b099770c7a6220bd135bb33eb"
+    "219dba2c45d42477528b859bd1100b34170204dc63e64b8a659f604e22c7e441a1995f6a"
+    "22f0d\"}]}]";
+
+void blockVerifier_rangeTest() {
+  std::vector<Block> blocks =
+      nlohmann::json::parse(linked_blocks_json).get<std::vector<Block>>();
+  TEST_ASSERT(blocks.size() == 2);
+
+  // the signer is the only validator of era 3, era 4 takes the validators of
+  // the switch block
+  std::vector<ValidatorWeight> validators(1);
+  validators[0].public_key = blocks[0].proofs[0].public_key;
+  validators[0].weight = 100;
+
+  std::string message;
+  TEST_ASSERT(BlockVerifier::Verify(blocks[0], validators, message));
+  TEST_ASSERT(BlockVerifier::VerifyRange(blocks, validators, message, 2));
+  TEST_ASSERT(message.empty());
+
+  // tampered body
+  std::vector<Block> tampered = blocks;
+  tampered[1].body.deploy_hashes.clear();
+  TEST_ASSERT(!BlockVerifier::VerifyHashes(tampered[1], message));
+  TEST_ASSERT(!BlockVerifier::VerifyRange(tampered, validators, message, 2));
+
+  // signature of another era
+  tampered = blocks;
+  tampered[0].header.era_id++;
+  TEST_ASSERT(!BlockVerifier::VerifyProofs(tampered[0], message));
+
+  // a block without signatures is not final
+  tampered = blocks;
+  tampered[1].proofs.clear();
+  TEST_ASSERT(!BlockVerifier::VerifyProofs(tampered[1], message));
+  TEST_ASSERT(!BlockVerifier::VerifyRange(tampered, validators, message));
+
+  // a valid signature of a key that is not a validator of the era
+  std::vector<ValidatorWeight> other_validators = validators;
+  other_validators[0].public_key = PublicKey::FromHexString(
+      "0202a6e2d25621758e2c92900f842ff367bbb5e4b6a849cacb43c3eaebf371b24b85");
+  TEST_ASSERT(BlockVerifier::VerifyProofs(blocks[0], message));
+  TEST_ASSERT(
+      !BlockVerifier::VerifyFinality(blocks[0], other_validators, message));
+  TEST_ASSERT(!BlockVerifier::VerifyRange(blocks, other_validators, message));
+
+  // signers holding a third of the weight or less
+  other_validators.push_back(validators[0]);
+  other_validators[0].weight = 200;
+  TEST_ASSERT(
+      !BlockVerifier::VerifyFinality(blocks[0], other_validators, message));
+  other_validators[0].weight = 199;
+  TEST_ASSERT(
+      BlockVerifier::VerifyFinality(blocks[0], other_validators, message));
+
+  // broken parent hash linkage
+  tampered = {blocks[1], blocks[0]};
+  TEST_ASSERT(BlockVerifier::Verify(tampered[0],
+                                    blocks[0].header.era_end
+                                        ->next_era_validator_weights,
+                                    message));
+  TEST_ASSERT(!BlockVerifier::VerifyRange(tampered, validators, message));
+}
+
+}  // namespace Casper
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <string>
+
+#include "CasperClient.h"
+#include "Types/TrieMerkleProof.h"
+#include "Utils/MerkleProofVerifier.h"
+#include "Utils/BlockVerifier.h"
+
+namespace Casper {
+
+/// <summary>
+/// JSON of the linked blocks of the verification and event stream tests.
+/// </summary>
+extern const std::string linked_blocks_json;
+
+void merkleProof_balanceTest(void);
+
+void merkleProof_itemTest(void);
+
+void merkleProof_nestedTypeTest(void);
+
+void blockVerifier_rangeTest(void);
+
+}  // namespace Casper